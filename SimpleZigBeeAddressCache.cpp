@@ -0,0 +1,374 @@
+/**
+* Copyright (c) 2013 Eric Burger. All rights reserved.
+*/
+
+#include "SimpleZigBeeAddressCache.h"
+// Frame index of each field (frame layouts)
+#include "SimpleZigBeeFrames.h"
+
+/*//////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////
+									SimpleZigBeeAddressCache Class
+////////////////////////////////////////////////////////////////////////
+/*//////////////////////////////////////////////////////////////////////
+
+/*//////////////////////////////////////////////////////////////////////
+									INITIALIZATION METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Constructor: SimpleZigBeeAddressCache(SimpleZigBeeAddressCacheEntry* entryStorage, uint8_t entries)
+*  @ Since v0.1.2, October 2026
+*  @ Creates a cache using the provided storage. Normally called by SimpleZigBeeAddressCacheT.
+*  @ param SimpleZigBeeAddressCacheEntry* entryStorage: Array of entries
+*  @ param uint8_t entries: Number of entries in array
+*/
+SimpleZigBeeAddressCache::SimpleZigBeeAddressCache(SimpleZigBeeAddressCacheEntry* entryStorage, uint8_t entries){
+	_entries = entryStorage;
+	_entryCount = entries;
+	clear();
+}
+
+/**
+*  Method: clear()
+*  @ Since v0.1.2, October 2026
+*  @ Forgets every address and resets the counters.
+*/
+void SimpleZigBeeAddressCache::clear(){
+	for( uint8_t i = 0; i < _entryCount; i++ ){
+		_entries[i].used = false;
+		_entries[i].frameID = 0;
+	}
+	resetCounters();
+}
+
+/*//////////////////////////////////////////////////////////////////////
+									CACHE METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: learn(uint32_t adr64MSB, uint32_t adr64LSB, uint16_t adr16)
+*  @ Since v0.1.2, October 2026
+*  @ Stores the 16-bit address of a 64-bit address. Broadcast and unknown (0xFFFE) addresses are ignored.
+*  @ param uint32_t adr64MSB: Most significant bytes (1st half) of 64-bit address
+*  @ param uint32_t adr64LSB: Least significant bytes (2nd half) of 64-bit address 
+*  @ param uint16_t adr16: 16-bit network address
+*/
+void SimpleZigBeeAddressCache::learn(uint32_t adr64MSB, uint32_t adr64LSB, uint16_t adr16){
+	if( BROADCAST_ADDRESS_16 == adr16 || (BROADCAST_ADDRESS_64_MSB == adr64MSB && BROADCAST_ADDRESS_64_LSB == adr64LSB) ){
+		return;
+	}
+	int index = find( adr64MSB, adr64LSB );
+	if( index < 0 ){
+		index = add( adr64MSB, adr64LSB );
+	}
+	_entries[index].address16 = adr16;
+	_entries[index].time = millis();
+}
+
+/**
+*  Method: lookup(uint32_t adr64MSB, uint32_t adr64LSB)
+*  @ Since v0.1.2, October 2026
+*  @ Returns the 16-bit address of a 64-bit address, or BROADCAST_ADDRESS_16 (0xFFFE) if it is not known.
+*  @ param uint32_t adr64MSB: Most significant bytes (1st half) of 64-bit address
+*  @ param uint32_t adr64LSB: Least significant bytes (2nd half) of 64-bit address 
+*/
+uint16_t SimpleZigBeeAddressCache::lookup(uint32_t adr64MSB, uint32_t adr64LSB){
+	int index = find( adr64MSB, adr64LSB );
+	if( index < 0 ){
+		return BROADCAST_ADDRESS_16;
+	}
+	return _entries[index].address16;
+}
+
+/**
+*  Method: invalidate(uint32_t adr64MSB, uint32_t adr64LSB)
+*  @ Since v0.1.2, October 2026
+*  @ Forgets the 16-bit address of a 64-bit address. Returns true if it was known.
+*  @ param uint32_t adr64MSB: Most significant bytes (1st half) of 64-bit address
+*  @ param uint32_t adr64LSB: Least significant bytes (2nd half) of 64-bit address 
+*/
+bool SimpleZigBeeAddressCache::invalidate(uint32_t adr64MSB, uint32_t adr64LSB){
+	int index = find( adr64MSB, adr64LSB );
+	if( index < 0 || BROADCAST_ADDRESS_16 == _entries[index].address16 ){
+		return false;
+	}
+	_entries[index].address16 = BROADCAST_ADDRESS_16;
+	_invalidateCount++;
+	return true;
+}
+
+/**
+*  Method: fill(SimpleZigBeePacket & packet)
+*  @ Since v0.1.2, October 2026
+*  @ Called for each outgoing packet. If the packet is a request with an unknown 16-bit address (0xFFFE) 
+*    and the address is in the cache, the 16-bit address of the packet is set. The frame ID is remembered, 
+*    so that the TX status can be matched with the destination (see packetReceived()). Returns true if the
+*    16-bit address was set.
+*  @ param SimpleZigBeePacket & packet: Outgoing packet
+*/
+bool SimpleZigBeeAddressCache::fill(SimpleZigBeePacket & packet){
+	uint16_t adr16;
+	if( !prepare( packet.getFrameDataPointer(), packet.getFrameLength(), adr16 ) ){
+		return false;
+	}
+	uint8_t bytes[2];
+	SimpleZigBeeBigEndian::write16( bytes, adr16 );
+	packet.setFrameData( SimpleZigBeeTxRequestLayout::ADDRESS16_INDEX, bytes, 2 );
+	return true;
+}
+
+/**
+*  Method: fill(uint8_t* frameData, int frameLength)
+*  @ Since v0.1.2, October 2026
+*  @ Same as fill(SimpleZigBeePacket & packet), for frame data that is not stored in a packet object.
+*  @ param uint8_t* frameData: Frame data of the request (starting with the frame type)
+*  @ param int frameLength: Number of bytes of frame data (at least up to the 16-bit address)
+*/
+bool SimpleZigBeeAddressCache::fill(uint8_t* frameData, int frameLength){
+	uint16_t adr16;
+	if( !prepare( frameData, frameLength, adr16 ) ){
+		return false;
+	}
+	SimpleZigBeeBigEndian::write16( frameData + SimpleZigBeeTxRequestLayout::ADDRESS16_INDEX, adr16 );
+	return true;
+}
+
+/**
+*  Method: packetReceived(SimpleZigBeePacket & packet)
+*  @ Since v0.1.2, October 2026
+*  @ Called for each incoming packet. Learns the sender's addresses from RX packets, route records and remote 
+*    AT command responses, and checks TX status packets (see statusReceived()).
+*  @ param SimpleZigBeePacket & packet: Incoming packet
+*/
+void SimpleZigBeeAddressCache::packetReceived(SimpleZigBeePacket & packet){
+	const uint8_t* frameData = packet.getFrameDataPointer();
+	int frameLength = packet.getFrameLength();
+	if( NULL == frameData || frameLength < 1 ){
+		return;
+	}
+	switch( frameData[0] ){
+		// Explicit RX, IO sample and route record packets have the addresses at the same index as RX packets
+		case ZIGBEE_RECIEVED_PACKET:
+		case ZIGBEE_EXPLICIT_RX_INDICATOR:
+		case ZIGBEE_IO_RX_INDICATOR:
+		case ROUTE_RECORD_INDICATOR:
+			if( frameLength >= SimpleZigBeeRxLayout::ADDRESS16_INDEX + 2 ){
+				learn( SimpleZigBeeBigEndian::read32( frameData + SimpleZigBeeRxLayout::ADDRESS64_INDEX ),
+					SimpleZigBeeBigEndian::read32( frameData + SimpleZigBeeRxLayout::ADDRESS64_INDEX + 4 ),
+					SimpleZigBeeBigEndian::read16( frameData + SimpleZigBeeRxLayout::ADDRESS16_INDEX ) );
+			}
+			break;
+		case REMOTE_AT_COMMAND_RESPONSE:
+			if( frameLength >= SimpleZigBeeRemoteAtResponseLayout::ADDRESS16_INDEX + 2 ){
+				learn( SimpleZigBeeBigEndian::read32( frameData + SimpleZigBeeRemoteAtResponseLayout::ADDRESS64_INDEX ),
+					SimpleZigBeeBigEndian::read32( frameData + SimpleZigBeeRemoteAtResponseLayout::ADDRESS64_INDEX + 4 ),
+					SimpleZigBeeBigEndian::read16( frameData + SimpleZigBeeRemoteAtResponseLayout::ADDRESS16_INDEX ) );
+			}
+			break;
+		case ZIGBEE_TX_STATUS:
+			statusReceived( frameData, frameLength );
+			break;
+	}
+}
+
+/*//////////////////////////////////////////////////////////////////////
+									STATISTICS METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: getCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of 16-bit addresses that are known.
+*/
+uint8_t SimpleZigBeeAddressCache::getCount(){
+	uint8_t count = 0;
+	for( uint8_t i = 0; i < _entryCount; i++ ){
+		if( _entries[i].used && BROADCAST_ADDRESS_16 != _entries[i].address16 ){
+			count++;
+		}
+	}
+	return count;
+}
+
+/**
+*  Method: getHitCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of requests whose 16-bit address was filled in from the cache.
+*/
+unsigned long SimpleZigBeeAddressCache::getHitCount(){
+	return _hitCount;
+}
+
+/**
+*  Method: getMissCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of requests with an unknown 16-bit address that was not in the cache.
+*/
+unsigned long SimpleZigBeeAddressCache::getMissCount(){
+	return _missCount;
+}
+
+/**
+*  Method: getInvalidateCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of 16-bit addresses that were forgotten because they may be stale.
+*/
+unsigned long SimpleZigBeeAddressCache::getInvalidateCount(){
+	return _invalidateCount;
+}
+
+/**
+*  Method: resetCounters()
+*  @ Since v0.1.2, October 2026
+*  @ Resets the hit, miss and invalidate counts.
+*/
+void SimpleZigBeeAddressCache::resetCounters(){
+	_hitCount = 0;
+	_missCount = 0;
+	_invalidateCount = 0;
+}
+
+/*//////////////////////////////////////////////////////////////////////
+									PRIVATE METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: find(uint32_t adr64MSB, uint32_t adr64LSB)
+*  @ Since v0.1.2, October 2026
+*  @ Returns the index of the entry for a 64-bit address, or -1 if there is none.
+*/
+int SimpleZigBeeAddressCache::find(uint32_t adr64MSB, uint32_t adr64LSB){
+	for( uint8_t i = 0; i < _entryCount; i++ ){
+		if( _entries[i].used && adr64LSB == _entries[i].address64LSB && adr64MSB == _entries[i].address64MSB ){
+			return i;
+		}
+	}
+	return -1;
+}
+
+/**
+*  Method: add(uint32_t adr64MSB, uint32_t adr64LSB)
+*  @ Since v0.1.2, October 2026
+*  @ Adds an entry (with an unknown 16-bit address) for a 64-bit address and returns its index. If every
+*    entry is used, the entry that was used least recently is replaced.
+*/
+int SimpleZigBeeAddressCache::add(uint32_t adr64MSB, uint32_t adr64LSB){
+	int index = 0;
+	unsigned long now = millis();
+	for( uint8_t i = 0; i < _entryCount; i++ ){
+		if( !_entries[i].used ){
+			index = i;
+			break;
+		}
+		if( (now - _entries[i].time) > (now - _entries[index].time) ){
+			index = i;
+		}
+	}
+	SimpleZigBeeAddressCacheEntry & entry = _entries[index];
+	entry.address64MSB = adr64MSB;
+	entry.address64LSB = adr64LSB;
+	entry.address16 = BROADCAST_ADDRESS_16;
+	entry.frameID = 0;
+	entry.used = true;
+	entry.time = now;
+	return index;
+}
+
+/**
+*  Method: prepare(const uint8_t* frameData, int frameLength, uint16_t & adr16)
+*  @ Since v0.1.2, October 2026
+*  @ Used by fill(). Remembers the frame ID of a request and finds the 16-bit address that should be 
+*    filled in. Returns true (and sets adr16) if the 16-bit address of the request should be changed.
+*/
+bool SimpleZigBeeAddressCache::prepare(const uint8_t* frameData, int frameLength, uint16_t & adr16){
+	// TX requests, explicit TX requests and remote AT commands have the destination at the same index
+	if( NULL == frameData || frameLength < SimpleZigBeeTxRequestLayout::ADDRESS16_INDEX + 2 ){
+		return false;
+	}
+	if( ZIGBEE_TRANSMIT_REQUEST != frameData[0] && ZIGBEE_EXPLICIT_ADDRESSING_COMMAND_FRAME != frameData[0] && REMOTE_AT_COMMAND != frameData[0] ){
+		return false;
+	}
+	uint32_t adr64MSB = SimpleZigBeeBigEndian::read32( frameData + SimpleZigBeeTxRequestLayout::ADDRESS64_INDEX );
+	uint32_t adr64LSB = SimpleZigBeeBigEndian::read32( frameData + SimpleZigBeeTxRequestLayout::ADDRESS64_INDEX + 4 );
+	uint16_t current = SimpleZigBeeBigEndian::read16( frameData + SimpleZigBeeTxRequestLayout::ADDRESS16_INDEX );
+	if( BROADCAST_ADDRESS_64_MSB == adr64MSB && BROADCAST_ADDRESS_64_LSB == adr64LSB ){
+		return false;
+	}
+	// The coordinator always has the 16-bit address 0x0000
+	if( COORDINATOR_ADDRESS_64_MSB == adr64MSB && COORDINATOR_ADDRESS_64_LSB == adr64LSB ){
+		if( BROADCAST_ADDRESS_16 != current ){
+			return false;
+		}
+		adr16 = 0x0000;
+		_hitCount++;
+		return true;
+	}
+	uint8_t frameID = frameData[SimpleZigBeeTxRequestLayout::ID_INDEX];
+	int index = find( adr64MSB, adr64LSB );
+	if( index < 0 ){
+		// Without a frame ID, there will be no TX status to learn the address from
+		if( 0 == frameID ){
+			if( BROADCAST_ADDRESS_16 == current ){
+				_missCount++;
+			}
+			return false;
+		}
+		index = add( adr64MSB, adr64LSB );
+	}
+	// A frame ID is only waiting for one TX status (an older request that never got one is forgotten)
+	if( 0 != frameID ){
+		for( uint8_t i = 0; i < _entryCount; i++ ){
+			if( frameID == _entries[i].frameID ){
+				_entries[i].frameID = 0;
+			}
+		}
+	}
+	SimpleZigBeeAddressCacheEntry & entry = _entries[index];
+	entry.frameID = frameID;
+	entry.time = millis();
+	if( BROADCAST_ADDRESS_16 != current ){
+		return false;
+	}
+	if( BROADCAST_ADDRESS_16 == entry.address16 ){
+		_missCount++;
+		return false;
+	}
+	adr16 = entry.address16;
+	_hitCount++;
+	return true;
+}
+
+/**
+*  Method: statusReceived(const uint8_t* frameData, int frameLength)
+*  @ Since v0.1.2, October 2026
+*  @ Matches a TX status with the last request sent to each address. If the request was delivered, the 
+*    16-bit address it was delivered to is stored. If the address may be stale, it is forgotten.
+*/
+void SimpleZigBeeAddressCache::statusReceived(const uint8_t* frameData, int frameLength){
+	if( frameLength < SimpleZigBeeTxStatusLayout::MIN_FRAME_LENGTH ){
+		return;
+	}
+	uint8_t frameID = frameData[SimpleZigBeeTxStatusLayout::ID_INDEX];
+	if( 0 == frameID ){
+		return;
+	}
+	for( uint8_t i = 0; i < _entryCount; i++ ){
+		SimpleZigBeeAddressCacheEntry & entry = _entries[i];
+		if( !entry.used || frameID != entry.frameID ){
+			continue;
+		}
+		entry.frameID = 0;
+		switch( frameData[SimpleZigBeeTxStatusLayout::DELIVERY_STATUS_INDEX] ){
+			case TRANSMIT_STATUS_SUCCESS:
+				learn( entry.address64MSB, entry.address64LSB, SimpleZigBeeBigEndian::read16( frameData + SimpleZigBeeTxStatusLayout::ADDRESS16_INDEX ) );
+				break;
+			case TRANSMIT_STATUS_NETWORK_ACK_FAILURE:
+			case TRANSMIT_STATUS_ADDRESS_NOT_FOUND:
+			case TRANSMIT_STATUS_ROUTE_NOT_FOUND:
+				invalidate( entry.address64MSB, entry.address64LSB );
+				break;
+		}
+		return;
+	}
+}
@@ -0,0 +1,135 @@
+/**
+* Library Name: SimpleZigBeeAddressCache
+* Library URI: https://github.com/ericburger/simple-zigbee
+* Description: Remembers the 16-bit network address of each 64-bit address seen in
+* incoming packets, so that outgoing requests do not need network address discovery.
+* Version: 0.1.2
+* Author(s): Eric Burger
+* Author URI: WallflowerOpen.com
+* License: GNU General Public License v2.0 or later
+* License URI: http://www.gnu.org/licenses/gpl-2.0.html 
+*
+* Copyright (c) 2013 Eric Burger. All rights reserved.
+*
+* This file is part of SimpleZigBee, written for XBee S2 Radios.
+*
+* SimpleZigBee is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* SimpleZigBee is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with SimpleZigBee.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SimpleZigBeeAddressCache_h
+#define SimpleZigBeeAddressCache_h
+
+#include "Arduino.h"
+// Requires SimpleZigBeePacket classes
+#include "SimpleZigBeePacket.h"
+// Requires address constants (BROADCAST_ADDRESS_16, etc.)
+#include "SimpleZigBeeAddress.h"
+// Required for uint8_t type
+#include <inttypes.h>
+
+/**
+* Struct: SimpleZigBeeAddressCacheEntry
+* @ Since v0.1.2, October 2026
+* @ 16-bit network address of one 64-bit address.
+*/
+struct SimpleZigBeeAddressCacheEntry {
+	uint32_t address64MSB;
+	uint32_t address64LSB;
+	// 16-bit network address, or BROADCAST_ADDRESS_16 (0xFFFE) if it is not known
+	uint16_t address16;
+	// Frame ID of the last request sent to the address that is waiting for its TX status (0 if none)
+	uint8_t frameID;
+	// True if the entry is in use
+	bool used;
+	// millis() when the entry was last used
+	unsigned long time;
+};
+
+/**
+* Class: SimpleZigBeeAddressCache
+* @ Since v0.1.2, October 2026
+* @ Keeps the 16-bit network address of up to a fixed number of 64-bit addresses. When an outgoing request
+*   (TX request, explicit TX request or remote AT command) has the 16-bit address 0xFFFE (unknown), the XBee 
+*   radio must find it with a network address discovery (a broadcast) before the request can be sent. 
+*   If the address is in the cache, fill() writes it into the request instead, so the discovery is skipped.
+*   The cache learns the addresses from:
+*     - RX packets (including explicit RX and IO sample packets), which hold the sender's addresses
+*     - Remote AT command responses, which hold the responder's addresses
+*     - TX status packets, which hold the 16-bit address that the request was delivered to. The TX status
+*       is matched with the request by its frame ID, so the request must ask for a status (frame ID not 0).
+*   When a TX status reports that the address was not found, the network ACK failed or no route was found, 
+*   the 16-bit address may be stale (the destination may have joined again with a new address), so it is 
+*   forgotten and the next request uses discovery again. Requests to the coordinator are given its fixed 
+*   16-bit address (0x0000). Broadcasts are not changed.
+*   When all entries are used, the entry that was used least recently is replaced. Each lookup checks every
+*   entry, which takes a few microseconds for a cache of 32 entries.
+*   When set in the radio (see SimpleZigBeeRadio::setAddressCache()), every request sent with send() or 
+*   sendTXRequest() is filled in and every incoming packet is checked. The storage for the entries is 
+*   provided by SimpleZigBeeAddressCacheT (see below).
+*   Example:
+*     SimpleZigBeeAddressCacheT<32> cache;
+*     xbee.setAddressCache( cache );
+*/
+class SimpleZigBeeAddressCache {
+public:
+	// INITIALIZATION METHODS //
+	SimpleZigBeeAddressCache(SimpleZigBeeAddressCacheEntry* entryStorage, uint8_t entries);
+	void clear();
+	
+	// CACHE METHODS //
+	void learn(uint32_t adr64MSB, uint32_t adr64LSB, uint16_t adr16);
+	uint16_t lookup(uint32_t adr64MSB, uint32_t adr64LSB);
+	bool invalidate(uint32_t adr64MSB, uint32_t adr64LSB);
+	bool fill(SimpleZigBeePacket & packet);
+	bool fill(uint8_t* frameData, int frameLength);
+	void packetReceived(SimpleZigBeePacket & packet);
+	
+	// STATISTICS METHODS //
+	uint8_t getCount();
+	unsigned long getHitCount();
+	unsigned long getMissCount();
+	unsigned long getInvalidateCount();
+	void resetCounters();
+
+private:
+	int find(uint32_t adr64MSB, uint32_t adr64LSB);
+	int add(uint32_t adr64MSB, uint32_t adr64LSB);
+	bool prepare(const uint8_t* frameData, int frameLength, uint16_t & adr16);
+	void statusReceived(const uint8_t* frameData, int frameLength);
+
+	SimpleZigBeeAddressCacheEntry* _entries;
+	uint8_t _entryCount;
+	// Number of requests filled in from the cache, requests to addresses that were not known and addresses forgotten
+	unsigned long _hitCount;
+	unsigned long _missCount;
+	unsigned long _invalidateCount;
+};
+
+/**
+* Class: SimpleZigBeeAddressCacheT
+* @ Since v0.1.2, October 2026
+* @ Address cache that holds its own storage for Entries addresses.
+*/
+template<uint8_t Entries>
+class SimpleZigBeeAddressCacheT : public SimpleZigBeeAddressCache {
+public:
+	SimpleZigBeeAddressCacheT() : SimpleZigBeeAddressCache(_entry_storage, Entries) {}
+
+private:
+	static_assert( Entries >= 1, "Entries must be between 1 and 255" );
+	SimpleZigBeeAddressCacheEntry _entry_storage[Entries];
+};
+
+#endif //SimpleZigBeeAddressCache_h
@@ -0,0 +1,228 @@
+/**
+* Copyright (c) 2013 Eric Burger. All rights reserved.
+*/
+
+#include "SimpleZigBeeBufferPool.h"
+
+#if defined(SIMPLE_ZIGBEE_LOCK_FREE_POOL)
+// The free list is changed with compare-and-swap, so no thread ever waits for another.
+#define POOL_LOAD(value) __atomic_load_n( &(value), __ATOMIC_ACQUIRE )
+#define POOL_CAS(value, expected, desired) __atomic_compare_exchange_n( &(value), &(expected), (desired), false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE )
+#define POOL_ADD(value, count) __atomic_add_fetch( &(value), (count), __ATOMIC_RELAXED )
+#define POOL_BEGIN_CRITICAL
+#define POOL_END_CRITICAL
+#elif defined(__AVR__)
+// Interrupts are disabled while the free list is changed (and restored afterwards).
+#define POOL_LOAD(value) (value)
+#define POOL_BEGIN_CRITICAL uint8_t oldSREG = SREG; cli();
+#define POOL_END_CRITICAL SREG = oldSREG;
+#else
+#define POOL_LOAD(value) (value)
+#define POOL_BEGIN_CRITICAL
+#define POOL_END_CRITICAL
+#endif
+
+/*//////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////
+										SimpleZigBeeBufferPool Class
+////////////////////////////////////////////////////////////////////////
+/*//////////////////////////////////////////////////////////////////////
+
+/*//////////////////////////////////////////////////////////////////////
+									INITIALIZATION METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Constructor: SimpleZigBeeBufferPool(uint8_t* blockStorage, uint16_t* nextStorage, uint16_t blockCount, int blockSize)
+*  @ Since v0.1.2, October 2026
+*  @ Creates a pool using the provided storage. Normally called by SimpleZigBeeBufferPoolT.
+*  @ param uint8_t* blockStorage: Array of blockCount * blockSize bytes
+*  @ param uint16_t* nextStorage: Array of blockCount indexes (free list)
+*  @ param uint16_t blockCount: Number of blocks (less than 65535)
+*  @ param int blockSize: Number of bytes in each block
+*/
+SimpleZigBeeBufferPool::SimpleZigBeeBufferPool(uint8_t* blockStorage, uint16_t* nextStorage, uint16_t blockCount, int blockSize){
+	_blocks = blockStorage;
+	_next = nextStorage;
+	_blockCount = blockCount;
+	_blockSize = blockSize;
+	clear();
+}
+
+/**
+*  Method: clear()
+*  @ Since v0.1.2, October 2026
+*  @ Marks every block as free and resets the counters. Only call when no block is in use.
+*/
+void SimpleZigBeeBufferPool::clear(){
+	for( uint16_t i=0; i<_blockCount; i++ ){
+		_next[i] = i + 1;
+	}
+	_next[_blockCount - 1] = SIMPLE_ZIGBEE_POOL_EMPTY;
+	_head = 0;
+	_inUse = 0;
+	resetCounters();
+}
+
+/*//////////////////////////////////////////////////////////////////////
+										BLOCK METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: acquire()
+*  @ Since v0.1.2, October 2026
+*  @ Takes a free block from the pool. Returns a pointer to the getBlockSize() bytes of the block, or NULL
+*    (and counts a failure) if every block is in use. The block must be given back with release().
+*/
+uint8_t* SimpleZigBeeBufferPool::acquire(){
+	uint16_t index;
+#if defined(SIMPLE_ZIGBEE_LOCK_FREE_POOL)
+	uint32_t head = POOL_LOAD(_head);
+	while( true ){
+		index = head & 0xffff;
+		if( SIMPLE_ZIGBEE_POOL_EMPTY == index ){
+			break;
+		}
+		uint32_t next = (head & 0xffff0000UL) + 0x10000UL + __atomic_load_n( &_next[index], __ATOMIC_RELAXED );
+		if( POOL_CAS(_head, head, next) ){
+			break;
+		}
+	}
+	if( SIMPLE_ZIGBEE_POOL_EMPTY == index ){
+		POOL_ADD(_failCount, 1);
+		return NULL;
+	}
+	uint16_t inUse = POOL_ADD(_inUse, 1);
+	uint16_t mark = POOL_LOAD(_highWaterMark);
+	while( inUse > mark && !POOL_CAS(_highWaterMark, mark, inUse) ){}
+#else
+	POOL_BEGIN_CRITICAL
+	index = _head;
+	if( SIMPLE_ZIGBEE_POOL_EMPTY == index ){
+		_failCount++;
+	}else{
+		_head = _next[index];
+		_inUse++;
+		if( _inUse > _highWaterMark ){
+			_highWaterMark = _inUse;
+		}
+	}
+	POOL_END_CRITICAL
+	if( SIMPLE_ZIGBEE_POOL_EMPTY == index ){
+		return NULL;
+	}
+#endif
+	return _blocks + ((unsigned long)index * _blockSize);
+}
+
+/**
+*  Method: release(uint8_t* block)
+*  @ Since v0.1.2, October 2026
+*  @ Gives a block back to the pool. Returns false (and does nothing) if the pointer is not the start of a 
+*    block of this pool. Releasing the same block twice is not detected, so only release a block once.
+*  @ param uint8_t* block: Pointer returned by acquire()
+*/
+bool SimpleZigBeeBufferPool::release(uint8_t* block){
+	if( !contains(block) ){
+		return false;
+	}
+	uint16_t index = (block - _blocks) / _blockSize;
+#if defined(SIMPLE_ZIGBEE_LOCK_FREE_POOL)
+	uint32_t head = POOL_LOAD(_head);
+	while( true ){
+		__atomic_store_n( &_next[index], (uint16_t)(head & 0xffff), __ATOMIC_RELAXED );
+		uint32_t next = (head & 0xffff0000UL) + 0x10000UL + index;
+		if( POOL_CAS(_head, head, next) ){
+			break;
+		}
+	}
+	POOL_ADD(_inUse, -1);
+#else
+	POOL_BEGIN_CRITICAL
+	_next[index] = _head;
+	_head = index;
+	_inUse--;
+	POOL_END_CRITICAL
+#endif
+	return true;
+}
+
+/**
+*  Method: contains(const uint8_t* block)
+*  @ Since v0.1.2, October 2026
+*  @ Checks if the pointer is the start of a block of this pool.
+*  @ param const uint8_t* block: Pointer to check
+*/
+bool SimpleZigBeeBufferPool::contains(const uint8_t* block){
+	if( NULL == block || block < _blocks ){
+		return false;
+	}
+	unsigned long offset = block - _blocks;
+	return offset < ((unsigned long)_blockCount * _blockSize) && 0 == (offset % _blockSize);
+}
+
+/**
+*  Method: getBlockSize()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of bytes in each block.
+*/
+int SimpleZigBeeBufferPool::getBlockSize(){
+	return _blockSize;
+}
+
+/**
+*  Method: getBlockCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of blocks in the pool.
+*/
+uint16_t SimpleZigBeeBufferPool::getBlockCount(){
+	return _blockCount;
+}
+
+/**
+*  Method: available()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of free blocks.
+*/
+uint16_t SimpleZigBeeBufferPool::available(){
+#if defined(SIMPLE_ZIGBEE_LOCK_FREE_POOL)
+	return _blockCount - POOL_LOAD(_inUse);
+#else
+	POOL_BEGIN_CRITICAL
+	uint16_t inUse = _inUse;
+	POOL_END_CRITICAL
+	return _blockCount - inUse;
+#endif
+}
+
+/*//////////////////////////////////////////////////////////////////////
+									STATISTICS METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: getHighWaterMark()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the largest number of blocks that have been in use at the same time.
+*/
+uint16_t SimpleZigBeeBufferPool::getHighWaterMark(){
+	return POOL_LOAD(_highWaterMark);
+}
+
+/**
+*  Method: getFailCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of times acquire() failed because every block was in use.
+*/
+unsigned long SimpleZigBeeBufferPool::getFailCount(){
+	return POOL_LOAD(_failCount);
+}
+
+/**
+*  Method: resetCounters()
+*  @ Since v0.1.2, October 2026
+*  @ Resets the high water mark (to the number of blocks in use) and the fail count.
+*/
+void SimpleZigBeeBufferPool::resetCounters(){
+	_highWaterMark = _inUse;
+	_failCount = 0;
+}
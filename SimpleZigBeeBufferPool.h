@@ -0,0 +1,121 @@
+/**
+* Library Name: SimpleZigBeeBufferPool
+* Library URI: https://github.com/ericburger/simple-zigbee
+* Description: Pool of fixed size blocks of memory for storing the frame data of
+* packets without malloc().
+* Version: 0.1.2
+* Author(s): Eric Burger
+* Author URI: WallflowerOpen.com
+* License: GNU General Public License v2.0 or later
+* License URI: http://www.gnu.org/licenses/gpl-2.0.html 
+*
+* Copyright (c) 2013 Eric Burger. All rights reserved.
+*
+* This file is part of SimpleZigBee, written for XBee S2 Radios.
+*
+* SimpleZigBee is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* SimpleZigBee is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with SimpleZigBee.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SimpleZigBeeBufferPool_h
+#define SimpleZigBeeBufferPool_h
+
+#include "Arduino.h"
+// Requires SIMPLE_ZIGBEE_MAX_FRAME_LENGTH
+#include "SimpleZigBeePacket.h"
+// Required for uint8_t type
+#include <inttypes.h>
+
+// On computers (not 8-bit AVR boards), acquire() and release() use a lock-free free list so that several 
+// threads can share one pool. Define SIMPLE_ZIGBEE_NO_LOCK_FREE to use the simpler single thread version.
+#if !defined(__AVR__) && !defined(SIMPLE_ZIGBEE_NO_LOCK_FREE)
+#define SIMPLE_ZIGBEE_LOCK_FREE_POOL
+#endif
+
+// Index of "no block" in the free list
+#define SIMPLE_ZIGBEE_POOL_EMPTY 0xffff
+
+/**
+* Class: SimpleZigBeeBufferPool
+* @ Since v0.1.2, October 2026
+* @ Fixed number of memory blocks of the same size (for example, one frame each). acquire() takes a 
+*   free block and release() gives it back, both in a fixed number of steps, so the memory used by 
+*   frames is limited to the size of the pool and the heap is never fragmented. A packet can store its
+*   frame data in a block of the pool (see SimpleZigBeePacket(SimpleZigBeeBufferPool & pool)), and a frame
+*   queue can store each received frame in a block until it is popped (see SimpleZigBeePooledFrameQueueT).
+*   The radio's own incoming packet and its write buffer are not taken from a pool: the incoming packet 
+*   is always in use while bytes are parsed, and the write buffer only holds a few escaped bytes at a time.
+*   On 8-bit AVR boards, interrupts are disabled while the free list is changed, so blocks can be 
+*   acquired and released in an interrupt. On computers the free list is lock-free (see above).
+*   The storage for the blocks is provided by SimpleZigBeeBufferPoolT (see below). 
+*/
+class SimpleZigBeeBufferPool {
+public:
+	// INITIALIZATION METHODS //
+	SimpleZigBeeBufferPool(uint8_t* blockStorage, uint16_t* nextStorage, uint16_t blockCount, int blockSize);
+	void clear();
+	
+	// BLOCK METHODS //
+	uint8_t* acquire();
+	bool release(uint8_t* block);
+	bool contains(const uint8_t* block);
+	int getBlockSize();
+	uint16_t getBlockCount();
+	uint16_t available();
+	
+	// STATISTICS METHODS //
+	uint16_t getHighWaterMark();
+	unsigned long getFailCount();
+	void resetCounters();
+
+private:
+	// Storage for _blockCount blocks of _blockSize bytes each
+	uint8_t* _blocks;
+	// Index of the next free block after each free block (free list)
+	uint16_t* _next;
+	// Number of blocks
+	uint16_t _blockCount;
+	// Number of bytes in each block
+	int _blockSize;
+	// Index of the first free block (low 16 bits, SIMPLE_ZIGBEE_POOL_EMPTY if none). On computers, the 
+	// high 16 bits count the changes to the free list so that a block taken and given back by another
+	// thread is noticed (the "ABA" problem).
+	uint32_t _head;
+	// Number of blocks in use
+	uint16_t _inUse;
+	// Largest number of blocks in use at the same time
+	uint16_t _highWaterMark;
+	// Number of times acquire() failed because every block was in use
+	unsigned long _failCount;
+};
+
+/**
+* Class: SimpleZigBeeBufferPoolT
+* @ Since v0.1.2, October 2026
+* @ Buffer pool that holds its own storage for BlockCount blocks of BlockSize bytes. 
+*   For example, "SimpleZigBeeBufferPoolT<8> pool;" uses about 8 * 52 bytes of RAM.
+*/
+template<uint16_t BlockCount, int BlockSize = SIMPLE_ZIGBEE_MAX_FRAME_LENGTH>
+class SimpleZigBeeBufferPoolT : public SimpleZigBeeBufferPool {
+public:
+	SimpleZigBeeBufferPoolT() : SimpleZigBeeBufferPool(_block_storage, _next_storage, BlockCount, BlockSize) {}
+	
+private:
+	static_assert( BlockCount >= 1 && BlockCount < 0xffff, "BlockCount must be between 1 and 65534" );
+	static_assert( BlockSize >= 1, "BlockSize must be at least 1" );
+	uint8_t _block_storage[(unsigned long)BlockCount * BlockSize];
+	uint16_t _next_storage[BlockCount];
+};
+
+#endif //SimpleZigBeeBufferPool_h
@@ -0,0 +1,421 @@
+/**
+* Copyright (c) 2013 Eric Burger. All rights reserved.
+*/
+
+#include "SimpleZigBeeCoalescer.h"
+// Frame index of each field (frame layouts)
+#include "SimpleZigBeeFrames.h"
+// Requires SimpleZigBeeRadio class for sending the packed TX requests
+#include "SimpleZigBeeRadio.h"
+
+/*//////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////
+									SimpleZigBeeCoalescer Class
+////////////////////////////////////////////////////////////////////////
+/*//////////////////////////////////////////////////////////////////////
+
+/*//////////////////////////////////////////////////////////////////////
+									INITIALIZATION METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Constructor: SimpleZigBeeCoalescer(SimpleZigBeeBundle* bundleStorage, uint8_t* payloadStorage, uint8_t bundles, int bundleLength)
+*  @ Since v0.1.2, October 2026
+*  @ Creates a coalescer using the provided storage. Normally called by SimpleZigBeeCoalescerT.
+*  @ param SimpleZigBeeBundle* bundleStorage: Array of bundles
+*  @ param uint8_t* payloadStorage: Array of bundles*bundleLength bytes
+*  @ param uint8_t bundles: Number of bundles in array
+*  @ param int bundleLength: Largest packed payload of a bundle
+*/
+SimpleZigBeeCoalescer::SimpleZigBeeCoalescer(SimpleZigBeeBundle* bundleStorage, uint8_t* payloadStorage, uint8_t bundles, int bundleLength){
+	_bundles = bundleStorage;
+	_payloads = payloadStorage;
+	_bundleCount = bundles;
+	_bundleLength = bundleLength;
+	_callback = NULL;
+	_delay = SIMPLE_ZIGBEE_COALESCE_DELAY;
+	_maxPayload = SIMPLE_ZIGBEE_DEFAULT_MAX_PAYLOAD;
+	_sending = false;
+	clear();
+}
+
+/**
+*  Method: clear()
+*  @ Since v0.1.2, October 2026
+*  @ Drops every waiting message (they are not sent) and resets the counters.
+*/
+void SimpleZigBeeCoalescer::clear(){
+	for( uint8_t i = 0; i < _bundleCount; i++ ){
+		_bundles[i].length = 0;
+	}
+	resetCounters();
+}
+
+/**
+*  Method: setCallback(SimpleZigBeeMessageCallback callback)
+*  @ Since v0.1.2, October 2026
+*  @ Sets the function that is called with each unpacked message.
+*  @ param SimpleZigBeeMessageCallback callback: Function to call, or NULL to disable
+*/
+void SimpleZigBeeCoalescer::setCallback(SimpleZigBeeMessageCallback callback){
+	_callback = callback;
+}
+
+/**
+*  Method: setDelay(unsigned long delay)
+*  @ Since v0.1.2, October 2026
+*  @ Sets the number of milliseconds the first message of a bundle may wait for more messages. A longer
+*    delay packs more messages per TX request, but each one arrives later. With 0, bundles are sent by the 
+*    next call to service() (or poll()).
+*  @ param unsigned long delay: Milliseconds (default SIMPLE_ZIGBEE_COALESCE_DELAY)
+*/
+void SimpleZigBeeCoalescer::setDelay(unsigned long delay){
+	_delay = delay;
+}
+
+/**
+*  Method: getDelay()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of milliseconds the first message of a bundle may wait.
+*/
+unsigned long SimpleZigBeeCoalescer::getDelay(){
+	return _delay;
+}
+
+/**
+*  Method: setMaxPayload(int maxPayload)
+*  @ Since v0.1.2, October 2026
+*  @ Sets the largest RF payload of a TX request, as returned by the NP command. Bundles are also limited 
+*    by their storage, which is normally smaller.
+*  @ param int maxPayload: Number of bytes (default SIMPLE_ZIGBEE_DEFAULT_MAX_PAYLOAD)
+*/
+void SimpleZigBeeCoalescer::setMaxPayload(int maxPayload){
+	_maxPayload = maxPayload;
+}
+
+/**
+*  Method: getMaxPayload()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the largest RF payload of a TX request (see setMaxPayload()).
+*/
+int SimpleZigBeeCoalescer::getMaxPayload(){
+	return _maxPayload;
+}
+
+/*//////////////////////////////////////////////////////////////////////
+									MESSAGE METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: send(SimpleZigBeeRadio & radio, uint32_t adr64MSB, uint32_t adr64LSB, uint16_t adr16, const uint8_t* message, int length)
+*  @ Since v0.1.2, October 2026
+*  @ Adds a message to the bundle of its destination. Returns false if the message is too long to be packed
+*    (more than the bundle length less 2 bytes), or if a bundle had to be sent to make room and could not be.
+*  @ param SimpleZigBeeRadio & radio: Radio used to send the bundles
+*  @ param uint32_t adr64MSB: Most significant bytes (1st half) of 64-bit address
+*  @ param uint32_t adr64LSB: Least significant bytes (2nd half) of 64-bit address 
+*  @ param uint16_t adr16: 16-bit destination address 
+*  @ param const uint8_t* message: Pointer to array of bytes to send
+*  @ param int length: Length of message array
+*/
+bool SimpleZigBeeCoalescer::send(SimpleZigBeeRadio & radio, uint32_t adr64MSB, uint32_t adr64LSB, uint16_t adr16, const uint8_t* message, int length){
+	int maxLength = limit( radio, adr64MSB, adr64LSB );
+	// The marker byte and the length byte
+	if( length < 0 || length > 255 || length + 2 > maxLength ){
+		return false;
+	}
+	int index = find( adr64MSB, adr64LSB );
+	if( index >= 0 && _bundles[index].length + 1 + length > maxLength ){
+		if( !sendBundle( radio, index ) ){
+			return false;
+		}
+	}
+	if( index < 0 || 0 == _bundles[index].length ){
+		// Use a free bundle, or send the oldest one to free it
+		index = 0;
+		unsigned long now = millis();
+		for( uint8_t i = 0; i < _bundleCount; i++ ){
+			if( 0 == _bundles[i].length ){
+				index = i;
+				break;
+			}
+			if( (now - _bundles[i].time) > (now - _bundles[index].time) ){
+				index = i;
+			}
+		}
+		if( 0 != _bundles[index].length && !sendBundle( radio, index ) ){
+			return false;
+		}
+		SimpleZigBeeBundle & bundle = _bundles[index];
+		bundle.address64MSB = adr64MSB;
+		bundle.address64LSB = adr64LSB;
+		bundle.time = now;
+		_payloads[(long)index * _bundleLength] = SIMPLE_ZIGBEE_BUNDLE_MARKER;
+		bundle.length = 1;
+	}
+	SimpleZigBeeBundle & bundle = _bundles[index];
+	bundle.address16 = adr16;
+	uint8_t* payload = _payloads + (long)index * _bundleLength;
+	payload[bundle.length++] = length;
+	memcpy( payload + bundle.length, message, length );
+	bundle.length += length;
+	_messageCount++;
+	// Send at once if no other message can fit (otherwise, service() sends it once the radio can send)
+	if( bundle.length + 1 >= maxLength && radio.canSend() ){
+		sendBundle( radio, index );
+	}
+	return true;
+}
+
+/**
+*  Method: coalesce(SimpleZigBeeRadio & radio, SimpleZigBeePacket & packet)
+*  @ Since v0.1.2, October 2026
+*  @ Called by SimpleZigBeeRadio::send() for each outgoing packet. Packs a TX request with no broadcast 
+*    radius or options and a payload that fits, and returns COALESCE_PACKED. Otherwise, the bundle of the 
+*    destination of a TX request is sent first (to keep the order of the messages) and COALESCE_NOT_PACKED
+*    is returned, so the packet is sent as usual. If the bundle could not be sent, COALESCE_FAILED is
+*    returned and the packet must not be sent either, since it would go out ahead of the bundle.
+*  @ param SimpleZigBeeRadio & radio: Radio used to send the bundles
+*  @ param SimpleZigBeePacket & packet: Outgoing packet
+*/
+uint8_t SimpleZigBeeCoalescer::coalesce(SimpleZigBeeRadio & radio, SimpleZigBeePacket & packet){
+	const uint8_t* frameData = packet.getFrameDataPointer();
+	int frameLength = packet.getFrameLength();
+	if( NULL == frameData || frameLength < SimpleZigBeeTxRequestLayout::MIN_FRAME_LENGTH ){
+		return COALESCE_NOT_PACKED;
+	}
+	if( ZIGBEE_TRANSMIT_REQUEST != frameData[0] && ZIGBEE_EXPLICIT_ADDRESSING_COMMAND_FRAME != frameData[0] ){
+		return COALESCE_NOT_PACKED;
+	}
+	uint32_t adr64MSB = SimpleZigBeeBigEndian::read32( frameData + SimpleZigBeeTxRequestLayout::ADDRESS64_INDEX );
+	uint32_t adr64LSB = SimpleZigBeeBigEndian::read32( frameData + SimpleZigBeeTxRequestLayout::ADDRESS64_INDEX + 4 );
+	if( ZIGBEE_TRANSMIT_REQUEST == frameData[0] && 0 == frameData[SimpleZigBeeTxRequestLayout::RADIUS_INDEX] 
+		&& 0 == frameData[SimpleZigBeeTxRequestLayout::OPTIONS_INDEX] 
+		&& send( radio, adr64MSB, adr64LSB, SimpleZigBeeBigEndian::read16( frameData + SimpleZigBeeTxRequestLayout::ADDRESS16_INDEX ),
+			frameData + SimpleZigBeeTxRequestLayout::PAYLOAD_INDEX, frameLength - SimpleZigBeeTxRequestLayout::PAYLOAD_INDEX ) ){
+		return COALESCE_PACKED;
+	}
+	if( !flush( radio, adr64MSB, adr64LSB ) ){
+		return COALESCE_FAILED;
+	}
+	return COALESCE_NOT_PACKED;
+}
+
+/**
+*  Method: service(SimpleZigBeeRadio & radio)
+*  @ Since v0.1.2, October 2026
+*  @ Sends each bundle whose first message has waited for the delay. Stops while the radio cannot send 
+*    another TX request (see SimpleZigBeeRadio::canSend()), so the remaining bundles wait for the next call.
+*    Returns the number of bundles sent. Called by SimpleZigBeeRadio::poll() when the coalescer is set in the radio.
+*  @ param SimpleZigBeeRadio & radio: Radio used to send the bundles
+*/
+int SimpleZigBeeCoalescer::service(SimpleZigBeeRadio & radio){
+	int sent = 0;
+	unsigned long now = millis();
+	for( uint8_t i = 0; i < _bundleCount; i++ ){
+		if( 0 == _bundles[i].length || (now - _bundles[i].time) < _delay ){
+			continue;
+		}
+		if( !radio.canSend() ){
+			break;
+		}
+		if( sendBundle( radio, i ) ){
+			sent++;
+		}
+	}
+	return sent;
+}
+
+/**
+*  Method: flush(SimpleZigBeeRadio & radio)
+*  @ Since v0.1.2, October 2026
+*  @ Sends every bundle now. Returns the number of bundles sent.
+*  @ param SimpleZigBeeRadio & radio: Radio used to send the bundles
+*/
+int SimpleZigBeeCoalescer::flush(SimpleZigBeeRadio & radio){
+	int sent = 0;
+	for( uint8_t i = 0; i < _bundleCount; i++ ){
+		if( 0 != _bundles[i].length && sendBundle( radio, i ) ){
+			sent++;
+		}
+	}
+	return sent;
+}
+
+/**
+*  Method: flush(SimpleZigBeeRadio & radio, uint32_t adr64MSB, uint32_t adr64LSB)
+*  @ Since v0.1.2, October 2026
+*  @ Sends the bundle of one destination now. Returns false if there is a bundle and it could not be sent.
+*  @ param SimpleZigBeeRadio & radio: Radio used to send the bundle
+*  @ param uint32_t adr64MSB: Most significant bytes (1st half) of 64-bit address
+*  @ param uint32_t adr64LSB: Least significant bytes (2nd half) of 64-bit address 
+*/
+bool SimpleZigBeeCoalescer::flush(SimpleZigBeeRadio & radio, uint32_t adr64MSB, uint32_t adr64LSB){
+	int index = find( adr64MSB, adr64LSB );
+	if( index < 0 ){
+		return true;
+	}
+	return sendBundle( radio, index );
+}
+
+/**
+*  Method: isSending()
+*  @ Since v0.1.2, October 2026
+*  @ Checks if a bundle is being sent (used by the radio, which does not frame it again).
+*/
+bool SimpleZigBeeCoalescer::isSending(){
+	return _sending;
+}
+
+/**
+*  Method: packetReceived(SimpleIncomingZigBeePacket & packet)
+*  @ Since v0.1.2, October 2026
+*  @ Called for each incoming packet. Passes each message of a packed RX packet to the callback, in order.
+*    Returns true if the packet was packed, so that it is not passed on to the program.
+*  @ param SimpleIncomingZigBeePacket & packet: Incoming packet
+*/
+bool SimpleZigBeeCoalescer::packetReceived(SimpleIncomingZigBeePacket & packet){
+	const uint8_t* frameData = packet.getFrameDataPointer();
+	int frameLength = packet.getFrameLength();
+	if( NULL == frameData || frameLength <= SimpleZigBeeRxLayout::PAYLOAD_INDEX || ZIGBEE_RECIEVED_PACKET != frameData[0]
+		|| SIMPLE_ZIGBEE_BUNDLE_MARKER != frameData[SimpleZigBeeRxLayout::PAYLOAD_INDEX] ){
+		return false;
+	}
+	int index = SimpleZigBeeRxLayout::PAYLOAD_INDEX + 1;
+	while( index < frameLength ){
+		int length = frameData[index++];
+		if( index + length > frameLength ){
+			// The rest of the payload is not a whole message
+			_dropCount++;
+			break;
+		}
+		_receivedCount++;
+		if( NULL != _callback ){
+			_callback( packet, frameData + index, length );
+		}
+		index += length;
+	}
+	return true;
+}
+
+/*//////////////////////////////////////////////////////////////////////
+									STATISTICS METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: getWaitingCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of bundles waiting to be sent.
+*/
+uint8_t SimpleZigBeeCoalescer::getWaitingCount(){
+	uint8_t count = 0;
+	for( uint8_t i = 0; i < _bundleCount; i++ ){
+		if( 0 != _bundles[i].length ){
+			count++;
+		}
+	}
+	return count;
+}
+
+/**
+*  Method: getMessageCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of messages packed. Divided by getBundleCount(), gives the average number of 
+*    messages per TX request.
+*/
+unsigned long SimpleZigBeeCoalescer::getMessageCount(){
+	return _messageCount;
+}
+
+/**
+*  Method: getBundleCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of packed TX requests sent.
+*/
+unsigned long SimpleZigBeeCoalescer::getBundleCount(){
+	return _sentCount;
+}
+
+/**
+*  Method: getReceivedCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of messages unpacked from incoming packets.
+*/
+unsigned long SimpleZigBeeCoalescer::getReceivedCount(){
+	return _receivedCount;
+}
+
+/**
+*  Method: getDropCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of packed incoming packets whose last message was cut short.
+*/
+unsigned long SimpleZigBeeCoalescer::getDropCount(){
+	return _dropCount;
+}
+
+/**
+*  Method: resetCounters()
+*  @ Since v0.1.2, October 2026
+*  @ Resets the message, bundle, received and drop counts.
+*/
+void SimpleZigBeeCoalescer::resetCounters(){
+	_messageCount = 0;
+	_sentCount = 0;
+	_receivedCount = 0;
+	_dropCount = 0;
+}
+
+/*//////////////////////////////////////////////////////////////////////
+									PRIVATE METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: find(uint32_t adr64MSB, uint32_t adr64LSB)
+*  @ Since v0.1.2, October 2026
+*  @ Returns the index of the bundle of a destination, or -1 if there is none.
+*/
+int SimpleZigBeeCoalescer::find(uint32_t adr64MSB, uint32_t adr64LSB){
+	for( uint8_t i = 0; i < _bundleCount; i++ ){
+		if( 0 != _bundles[i].length && adr64LSB == _bundles[i].address64LSB && adr64MSB == _bundles[i].address64MSB ){
+			return i;
+		}
+	}
+	return -1;
+}
+
+/**
+*  Method: limit(SimpleZigBeeRadio & radio, uint32_t adr64MSB, uint32_t adr64LSB)
+*  @ Since v0.1.2, October 2026
+*  @ Returns the largest packed payload for a destination: the bundle length or the RF payload limit, 
+*    less 2 bytes per hop if the route cache of the radio has a source route to the destination.
+*/
+int SimpleZigBeeCoalescer::limit(SimpleZigBeeRadio & radio, uint32_t adr64MSB, uint32_t adr64LSB){
+	int maxPayload = _maxPayload;
+	if( NULL != radio.getRouteCache() ){
+		int hops = radio.getRouteCache()->getRoute( adr64MSB, adr64LSB, NULL, 0 );
+		if( hops > 0 ){
+			maxPayload -= 2*hops;
+		}
+	}
+	return (maxPayload < _bundleLength) ? maxPayload : _bundleLength;
+}
+
+/**
+*  Method: sendBundle(SimpleZigBeeRadio & radio, int index)
+*  @ Since v0.1.2, October 2026
+*  @ Sends a bundle as one TX request and frees it. Returns false (and keeps the bundle) if it could not be sent.
+*/
+bool SimpleZigBeeCoalescer::sendBundle(SimpleZigBeeRadio & radio, int index){
+	SimpleZigBeeBundle & bundle = _bundles[index];
+	SimpleZigBeeSegment segment = { _payloads + (long)index * _bundleLength, bundle.length };
+	_sending = true;
+	bool sent = radio.sendTXRequest( bundle.address64MSB, bundle.address64LSB, bundle.address16, &segment, 1 );
+	_sending = false;
+	if( !sent ){
+		return false;
+	}
+	bundle.length = 0;
+	_sentCount++;
+	return true;
+}
@@ -0,0 +1,176 @@
+/**
+* Library Name: SimpleZigBeeCoalescer
+* Library URI: https://github.com/ericburger/simple-zigbee
+* Description: Packs small messages to the same destination into one TX request
+* and unpacks them on the receiving radio.
+* Version: 0.1.2
+* Author(s): Eric Burger
+* Author URI: WallflowerOpen.com
+* License: GNU General Public License v2.0 or later
+* License URI: http://www.gnu.org/licenses/gpl-2.0.html 
+*
+* Copyright (c) 2013 Eric Burger. All rights reserved.
+*
+* This file is part of SimpleZigBee, written for XBee S2 Radios.
+*
+* SimpleZigBee is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* SimpleZigBee is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with SimpleZigBee.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SimpleZigBeeCoalescer_h
+#define SimpleZigBeeCoalescer_h
+
+#include "Arduino.h"
+// Requires SimpleZigBeePacket classes
+#include "SimpleZigBeePacket.h"
+// Requires SimpleZigBeeMessageCallback type and SIMPLE_ZIGBEE_DEFAULT_MAX_PAYLOAD
+#include "SimpleZigBeeFragmenter.h"
+// Required for uint8_t type
+#include <inttypes.h>
+
+// First payload byte of every packed TX request. RX payloads that start with any other byte are not unpacked.
+#ifndef SIMPLE_ZIGBEE_BUNDLE_MARKER
+#define SIMPLE_ZIGBEE_BUNDLE_MARKER 0xF6
+#endif
+
+// Milliseconds a message may wait for more messages to the same destination (see SimpleZigBeeCoalescer::setDelay())
+#ifndef SIMPLE_ZIGBEE_COALESCE_DELAY
+#define SIMPLE_ZIGBEE_COALESCE_DELAY 50
+#endif
+
+// Default RF payload of a packed TX request: the largest that fits in SIMPLE_ZIGBEE_MAX_FRAME_LENGTH
+// with the 14 byte TX request header, so the receiving radio can store it
+#ifndef SIMPLE_ZIGBEE_BUNDLE_LENGTH
+#define SIMPLE_ZIGBEE_BUNDLE_LENGTH (SIMPLE_ZIGBEE_MAX_FRAME_LENGTH - 14)
+#endif
+
+// Results of SimpleZigBeeCoalescer::coalesce()
+#define COALESCE_NOT_PACKED 0
+#define COALESCE_PACKED 1
+#define COALESCE_FAILED 2
+
+/**
+* Struct: SimpleZigBeeBundle
+* @ Since v0.1.2, October 2026
+* @ Messages waiting to be sent to one destination. The packed payload is kept by the coalescer next to the bundle.
+*/
+struct SimpleZigBeeBundle {
+	uint32_t address64MSB;
+	uint32_t address64LSB;
+	uint16_t address16;
+	// Number of bytes of packed payload (0 if the bundle is not used)
+	int length;
+	// millis() when the first message was added
+	unsigned long time;
+};
+
+// Radio used to send the packed TX requests (see SimpleZigBeeRadio.h)
+class SimpleZigBeeRadio;
+
+/**
+* Class: SimpleZigBeeCoalescer
+* @ Since v0.1.2, October 2026
+* @ Packs small messages to the same destination into one TX request, so they share the 14 byte TX request
+*   header, the RF frame and the TX status. Each message waits in the bundle of its destination until:
+*     - the next message does not fit (the bundle is sent first)
+*     - the first message in the bundle has waited for the delay (see setDelay() and service())
+*     - a bundle is needed for another destination and every bundle is used (the oldest one is sent)
+*     - flush() is called
+*   The packed payload is a marker byte (SIMPLE_ZIGBEE_BUNDLE_MARKER), then each message as a length byte
+*   followed by the message. The receiving radio unpacks it and passes each message to the callback, in order.
+*   When set in the radio (see SimpleZigBeeRadio::setCoalescer()), each TX request sent with send() that has
+*   no broadcast radius or options and whose payload fits is packed instead of sent, so the program 
+*   can keep using prepareTXRequest() and send(). The packed TX request gets its own frame ID, so a request
+*   that was packed gets no TX status of its own. A TX request that is not packed is sent after the bundle
+*   of its destination, so the order of the messages is kept. poll() sends the bundles that are due and 
+*   packed RX packets are unpacked instead of being passed to the frame callback, frame queue and dispatcher.
+*   Any RX payload that starts with SIMPLE_ZIGBEE_BUNDLE_MARKER is unpacked. So that a TX request that is not
+*   packed is not mistaken for a packed one, the radio sends one whose payload starts with the marker as a 
+*   packed TX request of one message, which the receiving coalescer passes to its callback.
+*   The storage for the bundles is provided by SimpleZigBeeCoalescerT (see below).
+*   Example:
+*     SimpleZigBeeCoalescerT<2> coalescer;
+*     coalescer.setCallback( messageReceived );
+*     xbee.setCoalescer( coalescer );
+*/
+class SimpleZigBeeCoalescer {
+public:
+	// INITIALIZATION METHODS //
+	SimpleZigBeeCoalescer(SimpleZigBeeBundle* bundleStorage, uint8_t* payloadStorage, uint8_t bundles, int bundleLength);
+	void clear();
+	void setCallback(SimpleZigBeeMessageCallback callback);
+	void setDelay(unsigned long delay);
+	unsigned long getDelay();
+	void setMaxPayload(int maxPayload);
+	int getMaxPayload();
+	
+	// MESSAGE METHODS //
+	bool send(SimpleZigBeeRadio & radio, uint32_t adr64MSB, uint32_t adr64LSB, uint16_t adr16, const uint8_t* message, int length);
+	uint8_t coalesce(SimpleZigBeeRadio & radio, SimpleZigBeePacket & packet);
+	int service(SimpleZigBeeRadio & radio);
+	int flush(SimpleZigBeeRadio & radio);
+	bool flush(SimpleZigBeeRadio & radio, uint32_t adr64MSB, uint32_t adr64LSB);
+	bool isSending();
+	bool packetReceived(SimpleIncomingZigBeePacket & packet);
+	
+	// STATISTICS METHODS //
+	uint8_t getWaitingCount();
+	unsigned long getMessageCount();
+	unsigned long getBundleCount();
+	unsigned long getReceivedCount();
+	unsigned long getDropCount();
+	void resetCounters();
+
+private:
+	int find(uint32_t adr64MSB, uint32_t adr64LSB);
+	int limit(SimpleZigBeeRadio & radio, uint32_t adr64MSB, uint32_t adr64LSB);
+	bool sendBundle(SimpleZigBeeRadio & radio, int index);
+
+	SimpleZigBeeBundle* _bundles;
+	uint8_t* _payloads;
+	uint8_t _bundleCount;
+	int _bundleLength;
+	// Function called with each unpacked message (NULL if not set)
+	SimpleZigBeeMessageCallback _callback;
+	unsigned long _delay;
+	// RF payload limit of the XBee radio (NP)
+	int _maxPayload;
+	// Set while a bundle is sent, so that the radio does not frame it again
+	bool _sending;
+	// Number of messages packed and TX requests sent, messages unpacked and packed RX packets that were cut short
+	unsigned long _messageCount;
+	unsigned long _sentCount;
+	unsigned long _receivedCount;
+	unsigned long _dropCount;
+};
+
+/**
+* Class: SimpleZigBeeCoalescerT
+* @ Since v0.1.2, October 2026
+* @ Coalescer that holds its own storage for Bundles destinations with up to BundleLength bytes of packed
+*   payload each.
+*/
+template<uint8_t Bundles, int BundleLength = SIMPLE_ZIGBEE_BUNDLE_LENGTH>
+class SimpleZigBeeCoalescerT : public SimpleZigBeeCoalescer {
+public:
+	SimpleZigBeeCoalescerT() : SimpleZigBeeCoalescer(_bundle_storage, _payload_storage, Bundles, BundleLength) {}
+
+private:
+	static_assert( Bundles >= 1, "Bundles must be between 1 and 255" );
+	static_assert( BundleLength >= 3, "BundleLength must be at least 3" );
+	SimpleZigBeeBundle _bundle_storage[Bundles];
+	uint8_t _payload_storage[Bundles * BundleLength];
+};
+
+#endif //SimpleZigBeeCoalescer_h
@@ -0,0 +1,231 @@
+/**
+* Copyright (c) 2013 Eric Burger. All rights reserved.
+*/
+
+#include "SimpleZigBeeCodec.h"
+// Defines START and ESCAPE
+#include "SimpleZigBeePacket.h"
+
+#if defined(SIMPLE_ZIGBEE_AVX2)
+#include <immintrin.h>
+#elif defined(SIMPLE_ZIGBEE_SSE2)
+#include <emmintrin.h>
+#endif
+#if (defined(SIMPLE_ZIGBEE_AVX2) || defined(SIMPLE_ZIGBEE_SSE2)) && defined(_MSC_VER)
+// Defines _BitScanForward()
+#include <intrin.h>
+#endif
+
+#if defined(SIMPLE_ZIGBEE_AVX2) || defined(SIMPLE_ZIGBEE_SSE2)
+/**
+*  Function: firstSetBit(uint32_t mask)
+*  @ Since v0.1.2, October 2026
+*  @ Returns the index of the lowest set bit of a non-zero mask. MSVC does not provide 
+*    __builtin_ctz(), so _BitScanForward() is used instead.
+*  @ param uint32_t mask: Mask returned by _mm_movemask_epi8() or _mm256_movemask_epi8()
+*/
+static inline size_t firstSetBit(uint32_t mask){
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward( &index, mask );
+	return index;
+#else
+	return __builtin_ctz(mask);
+#endif
+}
+#endif
+
+/*//////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////
+										SimpleZigBeeCodec Class
+////////////////////////////////////////////////////////////////////////
+/*//////////////////////////////////////////////////////////////////////
+
+/*//////////////////////////////////////////////////////////////////////
+										RECEIVE METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: findSpecial(const uint8_t* data, size_t length)
+*  @ Since v0.1.2, October 2026
+*  @ Returns the index of the first START (0x7E) or ESCAPE (0x7D) byte in the array, or length if
+*    neither is found. In Escaped API Mode (ATAP=2), all of the bytes before this index can be 
+*    stored without being un-escaped. Since escaped bytes are rare in most payloads, the SSE2/AVX2 
+*    versions compare 16/32 bytes at once and return after a single check for most blocks.
+*  @ param const uint8_t* data: Pointer to array of received bytes
+*  @ param size_t length: Number of bytes in array
+*/
+size_t SimpleZigBeeCodec::findSpecial(const uint8_t* data, size_t length){
+	size_t i = 0;
+#if defined(SIMPLE_ZIGBEE_AVX2)
+	const __m256i start32 = _mm256_set1_epi8( (char)START );
+	const __m256i escape32 = _mm256_set1_epi8( (char)ESCAPE );
+	for( ; i+32<=length; i+=32 ){
+		__m256i block = _mm256_loadu_si256( (const __m256i*)(data+i) );
+		// Each bit of the mask is set if the matching byte is START or ESCAPE
+		uint32_t mask = (uint32_t)_mm256_movemask_epi8( _mm256_or_si256( _mm256_cmpeq_epi8(block,start32), _mm256_cmpeq_epi8(block,escape32) ) );
+		if( 0 != mask ){
+			return i + firstSetBit(mask);
+		}
+	}
+#endif
+#if defined(SIMPLE_ZIGBEE_SSE2)
+	const __m128i start16 = _mm_set1_epi8( (char)START );
+	const __m128i escape16 = _mm_set1_epi8( (char)ESCAPE );
+	for( ; i+16<=length; i+=16 ){
+		__m128i block = _mm_loadu_si128( (const __m128i*)(data+i) );
+		uint32_t mask = (uint32_t)_mm_movemask_epi8( _mm_or_si128( _mm_cmpeq_epi8(block,start16), _mm_cmpeq_epi8(block,escape16) ) );
+		if( 0 != mask ){
+			return i + firstSetBit(mask);
+		}
+	}
+#endif
+	// Byte-by-byte version (used for Arduino boards and for the last few bytes of the array)
+	for( ; i<length; i++ ){
+		if( START == data[i] || ESCAPE == data[i] ){
+			return i;
+		}
+	}
+	return length;
+}
+
+/*//////////////////////////////////////////////////////////////////////
+										TRANSMIT METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: findEscapable(const uint8_t* data, size_t length)
+*  @ Since v0.1.2, October 2026
+*  @ Returns the index of the first byte in the array that must be escaped before it is sent in
+*    Escaped API Mode (ATAP=2), or length if there is none. These are START (0x7E), ESCAPE (0x7D), 
+*    XON (0x11) and XOFF (0x13).
+*  @ param const uint8_t* data: Pointer to array of bytes to send
+*  @ param size_t length: Number of bytes in array
+*/
+size_t SimpleZigBeeCodec::findEscapable(const uint8_t* data, size_t length){
+	size_t i = 0;
+#if defined(SIMPLE_ZIGBEE_AVX2)
+	const __m256i start32 = _mm256_set1_epi8( (char)START );
+	const __m256i escape32 = _mm256_set1_epi8( (char)ESCAPE );
+	const __m256i xon32 = _mm256_set1_epi8( (char)XON );
+	const __m256i xoff32 = _mm256_set1_epi8( (char)XOFF );
+	for( ; i+32<=length; i+=32 ){
+		__m256i block = _mm256_loadu_si256( (const __m256i*)(data+i) );
+		__m256i found = _mm256_or_si256( _mm256_or_si256( _mm256_cmpeq_epi8(block,start32), _mm256_cmpeq_epi8(block,escape32) ),
+		                                 _mm256_or_si256( _mm256_cmpeq_epi8(block,xon32), _mm256_cmpeq_epi8(block,xoff32) ) );
+		uint32_t mask = (uint32_t)_mm256_movemask_epi8( found );
+		if( 0 != mask ){
+			return i + firstSetBit(mask);
+		}
+	}
+#endif
+#if defined(SIMPLE_ZIGBEE_SSE2)
+	const __m128i start16 = _mm_set1_epi8( (char)START );
+	const __m128i escape16 = _mm_set1_epi8( (char)ESCAPE );
+	const __m128i xon16 = _mm_set1_epi8( (char)XON );
+	const __m128i xoff16 = _mm_set1_epi8( (char)XOFF );
+	for( ; i+16<=length; i+=16 ){
+		__m128i block = _mm_loadu_si128( (const __m128i*)(data+i) );
+		__m128i found = _mm_or_si128( _mm_or_si128( _mm_cmpeq_epi8(block,start16), _mm_cmpeq_epi8(block,escape16) ),
+		                              _mm_or_si128( _mm_cmpeq_epi8(block,xon16), _mm_cmpeq_epi8(block,xoff16) ) );
+		uint32_t mask = (uint32_t)_mm_movemask_epi8( found );
+		if( 0 != mask ){
+			return i + firstSetBit(mask);
+		}
+	}
+#endif
+	for( ; i<length; i++ ){
+		if( START == data[i] || ESCAPE == data[i] || XON == data[i] || XOFF == data[i] ){
+			return i;
+		}
+	}
+	return length;
+}
+
+/**
+*  Method: escape(const uint8_t* data, size_t length, uint8_t* output, size_t outputLength, size_t* consumed)
+*  @ Since v0.1.2, October 2026
+*  @ Copies the array to the output array, escaping bytes as required by Escaped API Mode (ATAP=2).
+*    Runs of bytes that do not need to be escaped are copied with memcpy(). Copying stops when all 
+*    of the bytes have been copied or when the output array is full (an escaped byte is never split). 
+*    Returns the number of bytes placed in the output array. The number of input bytes that were 
+*    copied is stored in consumed. An output array twice the input length is always large enough.
+*  @ param const uint8_t* data: Pointer to array of bytes to send
+*  @ param size_t length: Number of bytes in array
+*  @ param uint8_t* output: Pointer to array for storing escaped bytes
+*  @ param size_t outputLength: Size of output array
+*  @ param size_t* consumed: Number of input bytes copied
+*/
+size_t SimpleZigBeeCodec::escape(const uint8_t* data, size_t length, uint8_t* output, size_t outputLength, size_t* consumed){
+	size_t in = 0;
+	size_t out = 0;
+	while( in < length && out < outputLength ){
+		// Copy the run of bytes that do not need to be escaped
+		size_t run = length - in;
+		if( run > outputLength - out ){
+			run = outputLength - out;
+		}
+		run = findEscapable( data+in, run );
+		memcpy( output+out, data+in, run );
+		in += run;
+		out += run;
+		// Then escape the next byte, if there is room for both bytes
+		if( in < length && out < outputLength ){
+			if( START == data[in] || ESCAPE == data[in] || XON == data[in] || XOFF == data[in] ){
+				if( out + 2 > outputLength ){
+					break;
+				}
+				output[out++] = ESCAPE;
+				output[out++] = data[in++] ^ 0x20;
+			}
+		}
+	}
+	*consumed = in;
+	return out;
+}
+
+/*//////////////////////////////////////////////////////////////////////
+										CHECKSUM METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: sum(const uint8_t* data, size_t length)
+*  @ Since v0.1.2, October 2026
+*  @ Returns the sum of the bytes in the array, keeping only the lowest 8 bits (as the packet checksum does).
+*    The SSE2/AVX2 versions use the "sum of absolute differences" instruction against zero, which adds 
+*    8 bytes at a time.
+*  @ param const uint8_t* data: Pointer to array of bytes
+*  @ param size_t length: Number of bytes in array
+*/
+uint8_t SimpleZigBeeCodec::sum(const uint8_t* data, size_t length){
+	size_t i = 0;
+	uint8_t total = 0;
+#if defined(SIMPLE_ZIGBEE_AVX2)
+	if( length >= 32 ){
+		__m256i sums = _mm256_setzero_si256();
+		for( ; i+32<=length; i+=32 ){
+			__m256i block = _mm256_loadu_si256( (const __m256i*)(data+i) );
+			sums = _mm256_add_epi64( sums, _mm256_sad_epu8( block, _mm256_setzero_si256() ) );
+		}
+		uint64_t lanes[4];
+		_mm256_storeu_si256( (__m256i*)lanes, sums );
+		total += (uint8_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+	}
+#endif
+#if defined(SIMPLE_ZIGBEE_SSE2)
+	if( length - i >= 16 ){
+		__m128i sums = _mm_setzero_si128();
+		for( ; i+16<=length; i+=16 ){
+			__m128i block = _mm_loadu_si128( (const __m128i*)(data+i) );
+			sums = _mm_add_epi64( sums, _mm_sad_epu8( block, _mm_setzero_si128() ) );
+		}
+		uint64_t lanes[2];
+		_mm_storeu_si128( (__m128i*)lanes, sums );
+		total += (uint8_t)(lanes[0] + lanes[1]);
+	}
+#endif
+	for( ; i<length; i++ ){
+		total += data[i];
+	}
+	return total;
+}
@@ -0,0 +1,78 @@
+/**
+* Library Name: SimpleZigBeeCodec
+* Library URI: https://github.com/ericburger/simple-zigbee
+* Description: Helper functions for scanning and summing blocks of bytes that are
+* sent to or received from the connected radio. 
+* Version: 0.1.2
+* Author(s): Eric Burger
+* Author URI: WallflowerOpen.com
+* License: GNU General Public License v2.0 or later
+* License URI: http://www.gnu.org/licenses/gpl-2.0.html 
+*
+* Copyright (c) 2013 Eric Burger. All rights reserved.
+*
+* This file is part of SimpleZigBee, written for XBee S2 Radios.
+*
+* SimpleZigBee is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* SimpleZigBee is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with SimpleZigBee.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SimpleZigBeeCodec_h
+#define SimpleZigBeeCodec_h
+
+#include "Arduino.h"
+// Required for uint8_t type
+#include <inttypes.h>
+
+// When the library is compiled for a computer (instead of an Arduino board), the SSE2 and AVX2
+// instructions can be used to check 16 or 32 bytes at a time. Define SIMPLE_ZIGBEE_NO_SIMD
+// to always use the byte-by-byte versions.
+#if !defined(SIMPLE_ZIGBEE_NO_SIMD) && defined(__AVX2__)
+#define SIMPLE_ZIGBEE_AVX2
+#endif
+#if !defined(SIMPLE_ZIGBEE_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#define SIMPLE_ZIGBEE_SSE2
+#endif
+
+/**
+* Struct: SimpleZigBeeSegment
+* @ Since v0.1.2, October 2026
+* @ One part of the frame data of an outgoing packet, kept in memory owned by the caller. A packet can be 
+*   sent from several segments without copying them together first (see SimpleZigBeeRadio::sendFrame()).
+*/
+struct SimpleZigBeeSegment {
+	const uint8_t* data;
+	int length;
+};
+
+/**
+* Class: SimpleZigBeeCodec
+* @ Since v0.1.2, October 2026
+* @ Collection of static methods that work on blocks of packet bytes. Used by SimpleZigBeeRadio 
+*   to copy runs of bytes that do not need to be escaped or un-escaped, instead of handling 
+*   each byte separately.
+*/
+class SimpleZigBeeCodec {
+public:
+	// RECEIVE METHODS //
+	static size_t findSpecial(const uint8_t* data, size_t length);
+	
+	// TRANSMIT METHODS //
+	static size_t findEscapable(const uint8_t* data, size_t length);
+	static size_t escape(const uint8_t* data, size_t length, uint8_t* output, size_t outputLength, size_t* consumed);
+	
+	// CHECKSUM METHODS //
+	static uint8_t sum(const uint8_t* data, size_t length);
+};
+
+#endif //SimpleZigBeeCodec_h
@@ -0,0 +1,104 @@
+/**
+* Copyright (c) 2013 Eric Burger. All rights reserved.
+*/
+
+#include "SimpleZigBeeDispatcher.h"
+
+/*//////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////
+										SimpleZigBeeDispatcher Class
+////////////////////////////////////////////////////////////////////////
+/*//////////////////////////////////////////////////////////////////////
+
+/*//////////////////////////////////////////////////////////////////////
+									INITIALIZATION METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Constructor: SimpleZigBeeDispatcher()
+*  @ Since v0.1.2, October 2026
+*  @ Creates a table without any handlers.
+*/
+SimpleZigBeeDispatcher::SimpleZigBeeDispatcher(){
+	clear();
+}
+
+/**
+*  Method: clear()
+*  @ Since v0.1.2, October 2026
+*  @ Removes all of the handlers, including the default handler.
+*/
+void SimpleZigBeeDispatcher::clear(){
+	_default_handler = NULL;
+	for( int i=0; i<256; i++ ){
+		_handlers[i] = NULL;
+	}
+	memset( _is_set, 0, sizeof(_is_set) );
+}
+
+/*//////////////////////////////////////////////////////////////////////
+									HANDLER METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: setHandler(uint8_t frameType, SimpleZigBeeFrameCallback handler)
+*  @ Since v0.1.2, October 2026
+*  @ Sets the function that is called for packets of the given frame type. 
+*  @ param uint8_t frameType: Frame type (for example, ZIGBEE_RECIEVED_PACKET)
+*  @ param SimpleZigBeeFrameCallback handler: Function to call, or NULL to use the default handler
+*/
+void SimpleZigBeeDispatcher::setHandler(uint8_t frameType, SimpleZigBeeFrameCallback handler){
+	if( NULL == handler ){
+		_is_set[frameType >> 3] &= ~(1 << (frameType & 7));
+		_handlers[frameType] = _default_handler;
+	}else{
+		_is_set[frameType >> 3] |= (1 << (frameType & 7));
+		_handlers[frameType] = handler;
+	}
+}
+
+/**
+*  Method: setDefaultHandler(SimpleZigBeeFrameCallback handler)
+*  @ Since v0.1.2, October 2026
+*  @ Sets the function that is called for packets whose frame type does not have its own handler. The 
+*    function is copied into every unused entry of the table so that dispatch() never has to check for it.
+*  @ param SimpleZigBeeFrameCallback handler: Function to call, or NULL to ignore other frame types
+*/
+void SimpleZigBeeDispatcher::setDefaultHandler(SimpleZigBeeFrameCallback handler){
+	_default_handler = handler;
+	for( int i=0; i<256; i++ ){
+		if( 0 == (_is_set[i >> 3] & (1 << (i & 7))) ){
+			_handlers[i] = handler;
+		}
+	}
+}
+
+/**
+*  Method: getHandler(uint8_t frameType)
+*  @ Since v0.1.2, October 2026
+*  @ Returns the function that will be called for packets of the given frame type (NULL if none).
+*  @ param uint8_t frameType: Frame type
+*/
+SimpleZigBeeFrameCallback SimpleZigBeeDispatcher::getHandler(uint8_t frameType){
+	return _handlers[frameType];
+}
+
+/**
+*  Method: dispatch(SimpleIncomingZigBeePacket & packet)
+*  @ Since v0.1.2, October 2026
+*  @ Calls the handler for the frame type of the packet. Returns false if there is no handler
+*    (or the packet is empty).
+*  @ param SimpleIncomingZigBeePacket & packet: Complete incoming packet
+*/
+bool SimpleZigBeeDispatcher::dispatch(SimpleIncomingZigBeePacket & packet){
+	const uint8_t* frameData = packet.getFrameDataPointer();
+	if( NULL == frameData || packet.getFrameLength() <= 0 ){
+		return false;
+	}
+	SimpleZigBeeFrameCallback handler = _handlers[frameData[0]];
+	if( NULL == handler ){
+		return false;
+	}
+	handler( packet );
+	return true;
+}
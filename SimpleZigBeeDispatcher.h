@@ -0,0 +1,78 @@
+/**
+* Library Name: SimpleZigBeeDispatcher
+* Library URI: https://github.com/ericburger/simple-zigbee
+* Description: Table of functions for handling each frame type received
+* by the connected radio.
+* Version: 0.1.2
+* Author(s): Eric Burger
+* Author URI: WallflowerOpen.com
+* License: GNU General Public License v2.0 or later
+* License URI: http://www.gnu.org/licenses/gpl-2.0.html 
+*
+* Copyright (c) 2013 Eric Burger. All rights reserved.
+*
+* This file is part of SimpleZigBee, written for XBee S2 Radios.
+*
+* SimpleZigBee is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* SimpleZigBee is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with SimpleZigBee.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SimpleZigBeeDispatcher_h
+#define SimpleZigBeeDispatcher_h
+
+#include "Arduino.h"
+// Requires SimpleZigBeePacket classes
+#include "SimpleZigBeePacket.h"
+// Required for uint8_t type
+#include <inttypes.h>
+
+// Function called for a complete incoming packet (see SimpleZigBeeRadio::setFrameCallback() and SimpleZigBeeDispatcher)
+typedef void (*SimpleZigBeeFrameCallback)(SimpleIncomingZigBeePacket & packet);
+
+/**
+* Class: SimpleZigBeeDispatcher
+* @ Since v0.1.2, October 2026
+* @ Table with one handler function for each of the 256 possible frame types. When a packet is
+*   dispatched, the frame type is used as the index into the table, so the handler is found in
+*   one step no matter how many frame types are handled (no chain of isRX(), isTXStatus(), ... checks).
+*   Frame types without a handler go to the default handler, if one is set. 
+*   The table uses 256 function pointers (512 bytes on 8-bit Arduino boards).
+*   Example:
+*     SimpleZigBeeDispatcher dispatcher;
+*     dispatcher.setHandler( ZIGBEE_RECIEVED_PACKET, handleRX );
+*     xbee.setDispatcher( dispatcher );
+*     ... then call xbee.poll() in loop()
+*/
+class SimpleZigBeeDispatcher {
+public:
+	// INITIALIZATION METHODS //
+	SimpleZigBeeDispatcher();
+	void clear();
+	
+	// HANDLER METHODS //
+	void setHandler(uint8_t frameType, SimpleZigBeeFrameCallback handler);
+	void setDefaultHandler(SimpleZigBeeFrameCallback handler);
+	SimpleZigBeeFrameCallback getHandler(uint8_t frameType);
+	bool dispatch(SimpleIncomingZigBeePacket & packet);
+	
+private:
+	// Handler for each frame type. Frame types without their own handler point to _default_handler.
+	SimpleZigBeeFrameCallback _handlers[256];
+	// Function called for frame types without their own handler (NULL if not set)
+	SimpleZigBeeFrameCallback _default_handler;
+	// True if the frame type has its own handler (one bit per frame type)
+	uint8_t _is_set[32];
+};
+
+#endif //SimpleZigBeeDispatcher_h
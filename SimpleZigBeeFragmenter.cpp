@@ -0,0 +1,482 @@
+/**
+* Copyright (c) 2013 Eric Burger. All rights reserved.
+*/
+
+#include "SimpleZigBeeFragmenter.h"
+// Frame index of each field (frame layouts)
+#include "SimpleZigBeeFrames.h"
+// Requires SimpleZigBeeRadio class for sending the fragments
+#include "SimpleZigBeeRadio.h"
+
+/*//////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////
+									SimpleZigBeeFragmenter Class
+////////////////////////////////////////////////////////////////////////
+/*//////////////////////////////////////////////////////////////////////
+
+/*//////////////////////////////////////////////////////////////////////
+									INITIALIZATION METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Constructor: SimpleZigBeeFragmenter(SimpleZigBeeReassembly* slotStorage, uint8_t* messageStorage, uint8_t slots, int maxMessageLength)
+*  @ Since v0.1.2, October 2026
+*  @ Creates a fragmenter using the provided storage. Normally called by SimpleZigBeeFragmenterT.
+*  @ param SimpleZigBeeReassembly* slotStorage: Array of slots
+*  @ param uint8_t* messageStorage: Array of slots*maxMessageLength bytes
+*  @ param uint8_t slots: Number of slots in array
+*  @ param int maxMessageLength: Largest message that can be received
+*/
+SimpleZigBeeFragmenter::SimpleZigBeeFragmenter(SimpleZigBeeReassembly* slotStorage, uint8_t* messageStorage, uint8_t slots, int maxMessageLength){
+	_slots = slotStorage;
+	_messages = messageStorage;
+	_slotCount = slots;
+	_maxMessageLength = maxMessageLength;
+	_callback = NULL;
+	_timeout = SIMPLE_ZIGBEE_REASSEMBLY_TIMEOUT;
+	_maxPayload = SIMPLE_ZIGBEE_DEFAULT_MAX_PAYLOAD;
+	_queried = false;
+	_messageID = 0;
+	_sending = false;
+	clear();
+}
+
+/**
+*  Method: clear()
+*  @ Since v0.1.2, October 2026
+*  @ Drops every message that is being reassembled and resets the counters.
+*/
+void SimpleZigBeeFragmenter::clear(){
+	for( uint8_t i = 0; i < _slotCount; i++ ){
+		_slots[i].state = REASSEMBLY_FREE;
+	}
+	resetCounters();
+}
+
+/**
+*  Method: setCallback(SimpleZigBeeMessageCallback callback)
+*  @ Since v0.1.2, October 2026
+*  @ Sets the function that is called with each complete message.
+*  @ param SimpleZigBeeMessageCallback callback: Function to call, or NULL to disable
+*/
+void SimpleZigBeeFragmenter::setCallback(SimpleZigBeeMessageCallback callback){
+	_callback = callback;
+}
+
+/**
+*  Method: setTimeout(unsigned long timeout)
+*  @ Since v0.1.2, October 2026
+*  @ Sets the number of milliseconds to wait for the next fragment of a message before it is dropped.
+*    A delivered message is remembered for the same time.
+*  @ param unsigned long timeout: Milliseconds (default SIMPLE_ZIGBEE_REASSEMBLY_TIMEOUT)
+*/
+void SimpleZigBeeFragmenter::setTimeout(unsigned long timeout){
+	_timeout = timeout;
+}
+
+/**
+*  Method: getTimeout()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of milliseconds to wait for the next fragment of a message.
+*/
+unsigned long SimpleZigBeeFragmenter::getTimeout(){
+	return _timeout;
+}
+
+/**
+*  Method: setMaxPayload(int maxPayload)
+*  @ Since v0.1.2, October 2026
+*  @ Sets the largest RF payload of a TX request, as returned by the NP command. Normally set when the 
+*    response to queryMaxPayload() arrives, but can be set by the program instead (the query is then not sent).
+*  @ param int maxPayload: Number of bytes (default SIMPLE_ZIGBEE_DEFAULT_MAX_PAYLOAD)
+*/
+void SimpleZigBeeFragmenter::setMaxPayload(int maxPayload){
+	_maxPayload = maxPayload;
+	_queried = true;
+}
+
+/**
+*  Method: getMaxPayload()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the largest RF payload of a TX request (see setMaxPayload()).
+*/
+int SimpleZigBeeFragmenter::getMaxPayload(){
+	return _maxPayload;
+}
+
+/**
+*  Method: queryMaxPayload(SimpleZigBeeRadio & radio)
+*  @ Since v0.1.2, October 2026
+*  @ Sends the NP command to the XBee radio. The response is read by packetReceived(). Called by the first
+*    send(), so it is only needed to ask before then. Returns false if the command could not be sent.
+*  @ param SimpleZigBeeRadio & radio: Radio connected to the XBee radio
+*/
+bool SimpleZigBeeFragmenter::queryMaxPayload(SimpleZigBeeRadio & radio){
+	uint8_t frameData[SimpleZigBeeAtCommandLayout::PAYLOAD_INDEX];
+	// A frame ID is needed for the XBee radio to respond
+	uint8_t id = radio.getNextFrameID();
+	frameData[0] = SimpleZigBeeAtCommandLayout::FRAME_TYPE;
+	frameData[SimpleZigBeeAtCommandLayout::ID_INDEX] = id;
+	frameData[SimpleZigBeeAtCommandLayout::COMMAND_INDEX] = 'N';
+	frameData[SimpleZigBeeAtCommandLayout::COMMAND_INDEX + 1] = 'P';
+	if( !radio.sendFrame( frameData, sizeof(frameData), NULL, 0 ) ){
+		return false;
+	}
+	radio.saveLastFrameID( id );
+	_queried = true;
+	return true;
+}
+
+/*//////////////////////////////////////////////////////////////////////
+									MESSAGE METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: send(SimpleZigBeeRadio & radio, uint32_t adr64MSB, uint32_t adr64LSB, uint16_t adr16, const uint8_t* message, int length)
+*  @ Since v0.1.2, October 2026
+*  @ Splits the message into fragments of equal length and sends each one as a TX request. Returns false
+*    if the message needs more than SIMPLE_ZIGBEE_MAX_FRAGMENTS fragments, or if the radio cannot take all
+*    of them now: the transmit buffer (if set) has no room for them, or there are fewer free frame IDs, 
+*    transmit window slots or scheduler slots than fragments (see SimpleZigBeeRadio::getSendCapacity()). 
+*    Nothing is sent then, so the message can be sent again after poll(). Also returns false if a fragment 
+*    could not be sent for another reason (the receiver then drops the message after the timeout).
+*  @ param SimpleZigBeeRadio & radio: Radio used to send the fragments
+*  @ param uint32_t adr64MSB: Most significant bytes (1st half) of 64-bit address
+*  @ param uint32_t adr64LSB: Least significant bytes (2nd half) of 64-bit address 
+*  @ param uint16_t adr16: 16-bit destination address 
+*  @ param const uint8_t* message: Pointer to array of bytes to send
+*  @ param int length: Length of message array (up to 65535 bytes)
+*/
+bool SimpleZigBeeFragmenter::send(SimpleZigBeeRadio & radio, uint32_t adr64MSB, uint32_t adr64LSB, uint16_t adr16, const uint8_t* message, int length){
+	if( length < 0 || length > 0xffff ){
+		return false;
+	}
+	if( !_queried ){
+		queryMaxPayload( radio );
+	}
+	// Each fragment must fit in the XBee radio and in the incoming packet of the receiving radio
+	int payload = _maxPayload;
+	if( payload > SIMPLE_ZIGBEE_MAX_FRAME_LENGTH - SimpleZigBeeTxRequestLayout::MIN_FRAME_LENGTH ){
+		payload = SIMPLE_ZIGBEE_MAX_FRAME_LENGTH - SimpleZigBeeTxRequestLayout::MIN_FRAME_LENGTH;
+	}
+	// A source route takes 2 bytes of RF payload per hop
+	if( NULL != radio.getRouteCache() ){
+		int hops = radio.getRouteCache()->getRoute( adr64MSB, adr64LSB, NULL, 0 );
+		if( hops > 0 ){
+			payload -= 2*hops;
+		}
+	}
+	int fragmentLength = payload - SimpleZigBeeFragmentLayout::HEADER_LENGTH;
+	if( fragmentLength < 1 ){
+		return false;
+	}
+	int count = (length + fragmentLength - 1) / fragmentLength;
+	if( count > SIMPLE_ZIGBEE_MAX_FRAGMENTS ){
+		return false;
+	}
+	if( 0 == count ){
+		count = 1;
+	}
+	// Spread the bytes evenly, so the receiver can find each fragment from the length and count
+	fragmentLength = (length + count - 1) / count;
+	// Every fragment (and a Create Source Route frame) with its START, length and checksum bytes
+	long total = length + (long)count * (SimpleZigBeeTxRequestLayout::MIN_FRAME_LENGTH + SimpleZigBeeFragmentLayout::HEADER_LENGTH + 4) + SIMPLE_ZIGBEE_MAX_SOURCE_ROUTE_FRAME_LENGTH + 4;
+	if( (total > 0x7fff && NULL != radio.getTransmitBuffer()) || !radio.canWrite( total > 0x7fff ? 0x7fff : (int)total ) ){
+		return false;
+	}
+	// A partial message is of no use to the receiver, so only start if every fragment can be sent
+	if( count > radio.getSendCapacity() ){
+		return false;
+	}
+	uint8_t header[SimpleZigBeeFragmentLayout::HEADER_LENGTH];
+	header[SimpleZigBeeFragmentLayout::MARKER_INDEX] = SIMPLE_ZIGBEE_FRAGMENT_MARKER;
+	header[SimpleZigBeeFragmentLayout::MESSAGE_ID_INDEX] = _messageID++;
+	header[SimpleZigBeeFragmentLayout::COUNT_INDEX] = count;
+	SimpleZigBeeBigEndian::write16( header + SimpleZigBeeFragmentLayout::LENGTH_INDEX, length );
+	_sending = true;
+	for( int i = 0; i < count; i++ ){
+		int offset = i * fragmentLength;
+		header[SimpleZigBeeFragmentLayout::FRAGMENT_INDEX] = i;
+		SimpleZigBeeSegment segments[2] = { { header, SimpleZigBeeFragmentLayout::HEADER_LENGTH }, 
+			{ message + offset, (length - offset < fragmentLength) ? length - offset : fragmentLength } };
+		if( !radio.sendTXRequest( adr64MSB, adr64LSB, adr16, segments, 2 ) ){
+			_sending = false;
+			return false;
+		}
+	}
+	_sending = false;
+	_sentCount++;
+	return true;
+}
+
+/**
+*  Method: prepareSingleFragment(uint8_t* header, int length)
+*  @ Since v0.1.2, October 2026
+*  @ Writes the fragment header (SimpleZigBeeFragmentLayout::HEADER_LENGTH bytes) of a message sent as a 
+*    single fragment. Used by the radio for TX request payloads that start with SIMPLE_ZIGBEE_FRAGMENT_MARKER,
+*    so that the receiving fragmenter does not mistake them for fragments.
+*  @ param uint8_t* header: Array of SimpleZigBeeFragmentLayout::HEADER_LENGTH bytes
+*  @ param int length: Length of the message (up to 65535 bytes)
+*/
+void SimpleZigBeeFragmenter::prepareSingleFragment(uint8_t* header, int length){
+	header[SimpleZigBeeFragmentLayout::MARKER_INDEX] = SIMPLE_ZIGBEE_FRAGMENT_MARKER;
+	header[SimpleZigBeeFragmentLayout::MESSAGE_ID_INDEX] = _messageID++;
+	header[SimpleZigBeeFragmentLayout::FRAGMENT_INDEX] = 0;
+	header[SimpleZigBeeFragmentLayout::COUNT_INDEX] = 1;
+	SimpleZigBeeBigEndian::write16( header + SimpleZigBeeFragmentLayout::LENGTH_INDEX, length );
+}
+
+/**
+*  Method: isSending()
+*  @ Since v0.1.2, October 2026
+*  @ Checks if send() is sending the fragments of a message (used by the radio, which does not frame them again).
+*/
+bool SimpleZigBeeFragmenter::isSending(){
+	return _sending;
+}
+
+/**
+*  Method: packetReceived(SimpleIncomingZigBeePacket & packet)
+*  @ Since v0.1.2, October 2026
+*  @ Called for each incoming packet. Adds the fragment of an RX packet to its message (and calls the 
+*    callback if the message is complete), and reads the response to the NP command. Returns true if the 
+*    packet was a fragment, so that it is not passed on to the program.
+*  @ param SimpleIncomingZigBeePacket & packet: Incoming packet
+*/
+bool SimpleZigBeeFragmenter::packetReceived(SimpleIncomingZigBeePacket & packet){
+	const uint8_t* frameData = packet.getFrameDataPointer();
+	int frameLength = packet.getFrameLength();
+	if( NULL == frameData || frameLength < 1 ){
+		return false;
+	}
+	switch( frameData[0] ){
+		case ZIGBEE_RECIEVED_PACKET:
+			if( frameLength < SimpleZigBeeRxLayout::PAYLOAD_INDEX + SimpleZigBeeFragmentLayout::HEADER_LENGTH 
+				|| SIMPLE_ZIGBEE_FRAGMENT_MARKER != frameData[SimpleZigBeeRxLayout::PAYLOAD_INDEX] ){
+				return false;
+			}
+			fragmentReceived( packet, frameData + SimpleZigBeeRxLayout::PAYLOAD_INDEX, frameLength - SimpleZigBeeRxLayout::PAYLOAD_INDEX );
+			return true;
+		case AT_COMMAND_RESPONSE:
+			// NP returns up to 2 bytes (leading zeros are not sent)
+			if( frameLength > SimpleZigBeeAtResponseLayout::PAYLOAD_INDEX && frameLength <= SimpleZigBeeAtResponseLayout::PAYLOAD_INDEX + 2 
+				&& 'N' == frameData[SimpleZigBeeAtResponseLayout::COMMAND_INDEX] && 'P' == frameData[SimpleZigBeeAtResponseLayout::COMMAND_INDEX + 1]
+				&& 0 == frameData[SimpleZigBeeAtResponseLayout::STATUS_INDEX] ){
+				int maxPayload = 0;
+				for( int i = SimpleZigBeeAtResponseLayout::PAYLOAD_INDEX; i < frameLength; i++ ){
+					maxPayload = (maxPayload << 8) | frameData[i];
+				}
+				_maxPayload = maxPayload;
+			}
+			break;
+	}
+	return false;
+}
+
+/**
+*  Method: checkTimeouts()
+*  @ Since v0.1.2, October 2026
+*  @ Drops each message that has not received a fragment for longer than getTimeout() and forgets each 
+*    delivered message after the same time. Returns the number of messages dropped. Called by 
+*    SimpleZigBeeRadio::poll() when the fragmenter is set in the radio.
+*/
+uint8_t SimpleZigBeeFragmenter::checkTimeouts(){
+	uint8_t count = 0;
+	unsigned long now = millis();
+	for( uint8_t i = 0; i < _slotCount; i++ ){
+		SimpleZigBeeReassembly & slot = _slots[i];
+		if( REASSEMBLY_FREE == slot.state || (now - slot.time) < _timeout ){
+			continue;
+		}
+		if( REASSEMBLY_RECEIVING == slot.state ){
+			_timeoutCount++;
+			count++;
+		}
+		slot.state = REASSEMBLY_FREE;
+	}
+	return count;
+}
+
+/*//////////////////////////////////////////////////////////////////////
+									STATISTICS METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: getSentCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of messages sent.
+*/
+unsigned long SimpleZigBeeFragmenter::getSentCount(){
+	return _sentCount;
+}
+
+/**
+*  Method: getMessageCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of messages received and passed to the callback.
+*/
+unsigned long SimpleZigBeeFragmenter::getMessageCount(){
+	return _messageCount;
+}
+
+/**
+*  Method: getFragmentCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of fragments received (including copies).
+*/
+unsigned long SimpleZigBeeFragmenter::getFragmentCount(){
+	return _fragmentCount;
+}
+
+/**
+*  Method: getDuplicateCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of copies of fragments that were ignored.
+*/
+unsigned long SimpleZigBeeFragmenter::getDuplicateCount(){
+	return _duplicateCount;
+}
+
+/**
+*  Method: getTimeoutCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of messages dropped because a fragment did not arrive in time.
+*/
+unsigned long SimpleZigBeeFragmenter::getTimeoutCount(){
+	return _timeoutCount;
+}
+
+/**
+*  Method: getDropCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of fragments dropped because no slot was free, the message was too long or the
+*    fragment header was wrong.
+*/
+unsigned long SimpleZigBeeFragmenter::getDropCount(){
+	return _dropCount;
+}
+
+/**
+*  Method: resetCounters()
+*  @ Since v0.1.2, October 2026
+*  @ Resets the sent, message, fragment, duplicate, timeout and drop counts.
+*/
+void SimpleZigBeeFragmenter::resetCounters(){
+	_sentCount = 0;
+	_messageCount = 0;
+	_fragmentCount = 0;
+	_duplicateCount = 0;
+	_timeoutCount = 0;
+	_dropCount = 0;
+}
+
+/*//////////////////////////////////////////////////////////////////////
+									PRIVATE METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: find(uint32_t adr64MSB, uint32_t adr64LSB, uint8_t messageID)
+*  @ Since v0.1.2, October 2026
+*  @ Returns the index of the slot of a message, or -1 if there is none.
+*/
+int SimpleZigBeeFragmenter::find(uint32_t adr64MSB, uint32_t adr64LSB, uint8_t messageID){
+	for( uint8_t i = 0; i < _slotCount; i++ ){
+		SimpleZigBeeReassembly & slot = _slots[i];
+		if( REASSEMBLY_FREE != slot.state && messageID == slot.messageID && adr64LSB == slot.address64LSB && adr64MSB == slot.address64MSB ){
+			return i;
+		}
+	}
+	return -1;
+}
+
+/**
+*  Method: add()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the index of a free slot, or of the slot of the message delivered longest ago. Returns -1 if 
+*    every slot is receiving a message.
+*/
+int SimpleZigBeeFragmenter::add(){
+	int index = -1;
+	unsigned long now = millis();
+	for( uint8_t i = 0; i < _slotCount; i++ ){
+		if( REASSEMBLY_FREE == _slots[i].state ){
+			return i;
+		}
+		if( REASSEMBLY_DELIVERED == _slots[i].state && (index < 0 || (now - _slots[i].time) > (now - _slots[index].time)) ){
+			index = i;
+		}
+	}
+	return index;
+}
+
+/**
+*  Method: fragmentReceived(SimpleIncomingZigBeePacket & packet, const uint8_t* payload, int payloadLength)
+*  @ Since v0.1.2, October 2026
+*  @ Copies a fragment into the slot of its message (starting a new message if needed) and delivers the
+*    message when no fragment is missing.
+*/
+void SimpleZigBeeFragmenter::fragmentReceived(SimpleIncomingZigBeePacket & packet, const uint8_t* payload, int payloadLength){
+	_fragmentCount++;
+	const uint8_t* frameData = packet.getFrameDataPointer();
+	uint32_t adr64MSB = SimpleZigBeeBigEndian::read32( frameData + SimpleZigBeeRxLayout::ADDRESS64_INDEX );
+	uint32_t adr64LSB = SimpleZigBeeBigEndian::read32( frameData + SimpleZigBeeRxLayout::ADDRESS64_INDEX + 4 );
+	uint8_t messageID = payload[SimpleZigBeeFragmentLayout::MESSAGE_ID_INDEX];
+	uint8_t fragment = payload[SimpleZigBeeFragmentLayout::FRAGMENT_INDEX];
+	uint8_t count = payload[SimpleZigBeeFragmentLayout::COUNT_INDEX];
+	uint16_t length = SimpleZigBeeBigEndian::read16( payload + SimpleZigBeeFragmentLayout::LENGTH_INDEX );
+	// The sender spreads the bytes evenly over the fragments (the last one may be shorter)
+	int fragmentLength = (0 == count) ? 0 : (length + count - 1) / count;
+	long offset = (long)fragment * fragmentLength;
+	if( fragment >= count || offset > length || payloadLength - SimpleZigBeeFragmentLayout::HEADER_LENGTH != ((length - offset < fragmentLength) ? length - offset : fragmentLength) ){
+		_dropCount++;
+		return;
+	}
+	int index = find( adr64MSB, adr64LSB, messageID );
+	if( index >= 0 && REASSEMBLY_DELIVERED == _slots[index].state ){
+		// A late copy of a fragment of a message that was already delivered
+		_duplicateCount++;
+		return;
+	}
+	if( index >= 0 && (count != _slots[index].fragmentCount || length != _slots[index].length) ){
+		// The sender has reused the message ID for a new message
+		_slots[index].state = REASSEMBLY_FREE;
+		index = -1;
+	}
+	if( index < 0 ){
+		index = add();
+		if( index < 0 || length > _maxMessageLength ){
+			_dropCount++;
+			return;
+		}
+		SimpleZigBeeReassembly & slot = _slots[index];
+		slot.address64MSB = adr64MSB;
+		slot.address64LSB = adr64LSB;
+		slot.messageID = messageID;
+		slot.state = REASSEMBLY_RECEIVING;
+		slot.fragmentCount = count;
+		slot.receivedCount = 0;
+		slot.length = length;
+		memset( slot.missing, 0, sizeof(slot.missing) );
+		for( uint8_t i = 0; i < count; i++ ){
+			slot.missing[i >> 3] |= (1 << (i & 7));
+		}
+	}
+	SimpleZigBeeReassembly & slot = _slots[index];
+	slot.time = millis();
+	if( 0 == (slot.missing[fragment >> 3] & (1 << (fragment & 7))) ){
+		_duplicateCount++;
+		return;
+	}
+	uint8_t* message = _messages + (long)index * _maxMessageLength;
+	memcpy( message + offset, payload + SimpleZigBeeFragmentLayout::DATA_INDEX, payloadLength - SimpleZigBeeFragmentLayout::HEADER_LENGTH );
+	slot.missing[fragment >> 3] &= ~(1 << (fragment & 7));
+	slot.receivedCount++;
+	if( slot.receivedCount < slot.fragmentCount ){
+		return;
+	}
+	slot.state = REASSEMBLY_DELIVERED;
+	_messageCount++;
+	if( NULL != _callback ){
+		_callback( packet, message, slot.length );
+	}
+}
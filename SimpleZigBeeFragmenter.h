@@ -0,0 +1,215 @@
+/**
+* Library Name: SimpleZigBeeFragmenter
+* Library URI: https://github.com/ericburger/simple-zigbee
+* Description: Splits messages that are larger than one RF payload into numbered
+* fragments and puts them back together on the receiving radio.
+* Version: 0.1.2
+* Author(s): Eric Burger
+* Author URI: WallflowerOpen.com
+* License: GNU General Public License v2.0 or later
+* License URI: http://www.gnu.org/licenses/gpl-2.0.html 
+*
+* Copyright (c) 2013 Eric Burger. All rights reserved.
+*
+* This file is part of SimpleZigBee, written for XBee S2 Radios.
+*
+* SimpleZigBee is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* SimpleZigBee is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with SimpleZigBee.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SimpleZigBeeFragmenter_h
+#define SimpleZigBeeFragmenter_h
+
+#include "Arduino.h"
+// Requires SimpleZigBeePacket classes
+#include "SimpleZigBeePacket.h"
+// Required for uint8_t type
+#include <inttypes.h>
+
+// First payload byte of every fragment. RX payloads that start with any other byte are not fragments.
+#ifndef SIMPLE_ZIGBEE_FRAGMENT_MARKER
+#define SIMPLE_ZIGBEE_FRAGMENT_MARKER 0xF5
+#endif
+
+// Largest RF payload used before the XBee radio has answered the NP command (see SimpleZigBeeFragmenter::queryMaxPayload())
+#ifndef SIMPLE_ZIGBEE_DEFAULT_MAX_PAYLOAD
+#define SIMPLE_ZIGBEE_DEFAULT_MAX_PAYLOAD 84
+#endif
+
+// Milliseconds without a new fragment before a message that is being reassembled is dropped
+#ifndef SIMPLE_ZIGBEE_REASSEMBLY_TIMEOUT
+#define SIMPLE_ZIGBEE_REASSEMBLY_TIMEOUT 5000
+#endif
+
+// Largest number of fragments in a message (the fragment index and count are single bytes)
+#define SIMPLE_ZIGBEE_MAX_FRAGMENTS 255
+
+// Reassembly States
+#define REASSEMBLY_FREE 0
+#define REASSEMBLY_RECEIVING 1
+#define REASSEMBLY_DELIVERED 2
+
+/**
+* Struct: SimpleZigBeeFragmentLayout
+* @ Since v0.1.2, October 2026
+* @ Index of each field of the fragment header, at the start of the RF payload of each fragment. The 
+*   message is split into fragments of equal length (the last one may be shorter), so the receiver finds
+*   the place of each fragment from the message length, fragment count and fragment index.
+*/
+struct SimpleZigBeeFragmentLayout {
+	static constexpr int MARKER_INDEX = 0;
+	static constexpr int MESSAGE_ID_INDEX = 1;
+	static constexpr int FRAGMENT_INDEX = 2;
+	static constexpr int COUNT_INDEX = 3;
+	// Message length (2 bytes)
+	static constexpr int LENGTH_INDEX = 4;
+	static constexpr int DATA_INDEX = 6;
+	static constexpr int HEADER_LENGTH = DATA_INDEX;
+};
+
+/**
+* Struct: SimpleZigBeeReassembly
+* @ Since v0.1.2, October 2026
+* @ State of one message being reassembled. The message bytes are kept by the fragmenter next to the state.
+*/
+struct SimpleZigBeeReassembly {
+	// 64-bit address of the sender
+	uint32_t address64MSB;
+	uint32_t address64LSB;
+	uint8_t messageID;
+	// REASSEMBLY_FREE, REASSEMBLY_RECEIVING or REASSEMBLY_DELIVERED (kept until the timeout, so that late copies of its fragments are ignored)
+	uint8_t state;
+	uint8_t fragmentCount;
+	uint8_t receivedCount;
+	uint16_t length;
+	// One bit per fragment, set while the fragment is missing
+	uint8_t missing[(SIMPLE_ZIGBEE_MAX_FRAGMENTS + 7) / 8];
+	// millis() when the last fragment was received
+	unsigned long time;
+};
+
+// Radio used to send the fragments (see SimpleZigBeeRadio.h)
+class SimpleZigBeeRadio;
+
+// Function called with each complete message (see SimpleZigBeeFragmenter::setCallback()). The packet is
+// the fragment that completed the message, so getRXAddress() gives the sender.
+typedef void (*SimpleZigBeeMessageCallback)(SimpleIncomingZigBeePacket & packet, const uint8_t* message, int length);
+
+/**
+* Class: SimpleZigBeeFragmenter
+* @ Since v0.1.2, October 2026
+* @ Sends messages of any length (up to 255 fragments) and receives them whole. The XBee radio rejects 
+*   a TX request with more RF payload than the NP command allows (TRANSMIT_STATUS_PAYLOAD_TOO_LARGE), so
+*   send() splits the message into fragments that each fit, adds a small header to each one (see 
+*   SimpleZigBeeFragmentLayout) and sends them with SimpleZigBeeRadio::sendTXRequest(), so they use the 
+*   address cache, route cache, request table and retransmitter like any other TX request.
+*   The fragment size is the smallest of:
+*     - the NP value of the XBee radio, which is asked once (see queryMaxPayload()), less 2 bytes per hop
+*       if the route cache of the radio has a source route to the destination
+*     - the largest payload that fits in SIMPLE_ZIGBEE_MAX_FRAME_LENGTH, so that the receiving radio (using
+*       the same library) can store each fragment
+*   The receiver keeps each message in one of a fixed number of slots, with a bitmap of missing fragments. 
+*   Copies of a fragment are ignored, and when no fragment is missing, the message is passed to the callback.
+*   The slot then remembers the message until the timeout, so a late copy of one of its fragments does not
+*   start it again: each message is delivered exactly once. A message that is still missing fragments after
+*   the timeout, or that does not fit in a slot, is dropped.
+*   When set in the radio (see SimpleZigBeeRadio::setFragmenter()), fragments are taken out of the incoming
+*   packets (they are not passed to the frame callback, frame queue or dispatcher) and poll() checks the 
+*   timeouts. Both radios need a fragmenter. The storage for the messages is provided by 
+*   SimpleZigBeeFragmenterT (see below).
+*   Any RX payload that starts with SIMPLE_ZIGBEE_FRAGMENT_MARKER is taken for a fragment. So that an ordinary
+*   TX request with such a payload is not mistaken for one, the radio sends it as a message of one fragment
+*   (see prepareSingleFragment()), which the receiving fragmenter passes to its callback.
+*   Example:
+*     SimpleZigBeeFragmenterT<512> fragmenter;
+*     fragmenter.setCallback( messageReceived );
+*     xbee.setFragmenter( fragmenter );
+*     xbee.sendMessage( address, log, logLength );
+*/
+class SimpleZigBeeFragmenter {
+public:
+	// INITIALIZATION METHODS //
+	SimpleZigBeeFragmenter(SimpleZigBeeReassembly* slotStorage, uint8_t* messageStorage, uint8_t slots, int maxMessageLength);
+	void clear();
+	void setCallback(SimpleZigBeeMessageCallback callback);
+	void setTimeout(unsigned long timeout);
+	unsigned long getTimeout();
+	void setMaxPayload(int maxPayload);
+	int getMaxPayload();
+	bool queryMaxPayload(SimpleZigBeeRadio & radio);
+	
+	// MESSAGE METHODS //
+	bool send(SimpleZigBeeRadio & radio, uint32_t adr64MSB, uint32_t adr64LSB, uint16_t adr16, const uint8_t* message, int length);
+	void prepareSingleFragment(uint8_t* header, int length);
+	bool isSending();
+	bool packetReceived(SimpleIncomingZigBeePacket & packet);
+	uint8_t checkTimeouts();
+	
+	// STATISTICS METHODS //
+	unsigned long getSentCount();
+	unsigned long getMessageCount();
+	unsigned long getFragmentCount();
+	unsigned long getDuplicateCount();
+	unsigned long getTimeoutCount();
+	unsigned long getDropCount();
+	void resetCounters();
+
+private:
+	int find(uint32_t adr64MSB, uint32_t adr64LSB, uint8_t messageID);
+	int add();
+	void fragmentReceived(SimpleIncomingZigBeePacket & packet, const uint8_t* payload, int payloadLength);
+
+	SimpleZigBeeReassembly* _slots;
+	uint8_t* _messages;
+	uint8_t _slotCount;
+	int _maxMessageLength;
+	// Function called with each complete message (NULL if not set)
+	SimpleZigBeeMessageCallback _callback;
+	unsigned long _timeout;
+	// RF payload limit of the XBee radio (NP), and whether it has been asked
+	int _maxPayload;
+	bool _queried;
+	// ID of the next message sent
+	uint8_t _messageID;
+	// Set while send() sends the fragments, so that the radio does not frame them again
+	bool _sending;
+	// Number of messages sent and delivered, fragments received, copies of fragments ignored, messages
+	// dropped after the timeout and fragments dropped (no free slot, message too long or bad header)
+	unsigned long _sentCount;
+	unsigned long _messageCount;
+	unsigned long _fragmentCount;
+	unsigned long _duplicateCount;
+	unsigned long _timeoutCount;
+	unsigned long _dropCount;
+};
+
+/**
+* Class: SimpleZigBeeFragmenterT
+* @ Since v0.1.2, October 2026
+* @ Fragmenter that holds its own storage for Slots messages of up to MaxMessageLength bytes each, so it
+*   can receive from Slots radios at the same time.
+*/
+template<int MaxMessageLength, uint8_t Slots = 1>
+class SimpleZigBeeFragmenterT : public SimpleZigBeeFragmenter {
+public:
+	SimpleZigBeeFragmenterT() : SimpleZigBeeFragmenter(_slot_storage, _message_storage, Slots, MaxMessageLength) {}
+
+private:
+	static_assert( Slots >= 1, "Slots must be between 1 and 255" );
+	static_assert( MaxMessageLength >= 1 && MaxMessageLength <= 0xffff, "MaxMessageLength must be between 1 and 65535" );
+	SimpleZigBeeReassembly _slot_storage[Slots];
+	uint8_t _message_storage[Slots * MaxMessageLength];
+};
+
+#endif //SimpleZigBeeFragmenter_h
@@ -0,0 +1,271 @@
+/**
+* Copyright (c) 2013 Eric Burger. All rights reserved.
+*/
+
+#include "SimpleZigBeeFrameQueue.h"
+
+// _head and _tail are shared between the producer and the consumer. The "acquire" and "release"
+// versions make sure that a frame is completely stored before the producer publishes the new _head,
+// and that the consumer has finished with a frame before the slot is handed back. On 8-bit AVR boards 
+// these compile to plain loads and stores.
+#define QUEUE_LOAD(index) __atomic_load_n( &(index), __ATOMIC_ACQUIRE )
+#define QUEUE_STORE(index, value) __atomic_store_n( &(index), (value), __ATOMIC_RELEASE )
+
+/*//////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////
+										SimpleZigBeeFrameQueue Class
+////////////////////////////////////////////////////////////////////////
+/*//////////////////////////////////////////////////////////////////////
+
+/*//////////////////////////////////////////////////////////////////////
+									INITIALIZATION METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Constructor: SimpleZigBeeFrameQueue(uint8_t* frameStorage, uint16_t* lengthStorage, uint8_t depth, int maxFrameLength)
+*  @ Since v0.1.2, October 2026
+*  @ Creates a queue using the provided storage. Normally called by SimpleZigBeeFrameQueueT.
+*  @ param uint8_t* frameStorage: Array of depth * maxFrameLength bytes
+*  @ param uint16_t* lengthStorage: Array of depth frame lengths
+*  @ param uint8_t depth: Number of frames that can be stored (power of 2)
+*  @ param int maxFrameLength: Maximum number of bytes stored for each frame
+*/
+SimpleZigBeeFrameQueue::SimpleZigBeeFrameQueue(uint8_t* frameStorage, uint16_t* lengthStorage, uint8_t depth, int maxFrameLength){
+	_frames = frameStorage;
+	_pool = NULL;
+	_blocks = NULL;
+	_lengths = lengthStorage;
+	_depth = depth;
+	_maxFrameLength = maxFrameLength;
+	_head = 0;
+	_tail = 0;
+	clear();
+}
+
+/**
+*  Constructor: SimpleZigBeeFrameQueue(SimpleZigBeeBufferPool & pool, uint8_t** blockStorage, uint16_t* lengthStorage, uint8_t depth)
+*  @ Since v0.1.2, October 2026
+*  @ Creates a queue that stores each frame in a block of the pool. Normally called by SimpleZigBeePooledFrameQueueT.
+*  @ param SimpleZigBeeBufferPool & pool: Pool that the frames are stored in (frames up to its block size)
+*  @ param uint8_t** blockStorage: Array of depth block pointers
+*  @ param uint16_t* lengthStorage: Array of depth frame lengths
+*  @ param uint8_t depth: Number of frames that can be stored (power of 2)
+*/
+SimpleZigBeeFrameQueue::SimpleZigBeeFrameQueue(SimpleZigBeeBufferPool & pool, uint8_t** blockStorage, uint16_t* lengthStorage, uint8_t depth){
+	_frames = NULL;
+	_pool = &pool;
+	_blocks = blockStorage;
+	_lengths = lengthStorage;
+	_depth = depth;
+	_maxFrameLength = pool.getBlockSize();
+	_head = 0;
+	_tail = 0;
+	clear();
+}
+
+/**
+*  Method: clear()
+*  @ Since v0.1.2, October 2026
+*  @ Removes all frames (giving their blocks back to the pool, if used) and resets the counters. Only call 
+*    when neither the producer nor the consumer is running.
+*/
+void SimpleZigBeeFrameQueue::clear(){
+	while( pop() );
+	_head = 0;
+	_tail = 0;
+	resetCounters();
+}
+
+/*//////////////////////////////////////////////////////////////////////
+									PRODUCER METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: push(const uint8_t* frameData, int frameLength)
+*  @ Since v0.1.2, October 2026
+*  @ Copies a complete frame into the next free slot. Returns false (and counts a drop) if the 
+*    queue is full, the frame is longer than the slots or (if a pool is used) no block is free.
+*  @ param const uint8_t* frameData: Pointer to frame data (starting with the frame type)
+*  @ param int frameLength: Number of frame data bytes
+*/
+bool SimpleZigBeeFrameQueue::push(const uint8_t* frameData, int frameLength){
+	uint8_t head = _head;
+	uint8_t count = head - QUEUE_LOAD(_tail);
+	if( count >= _depth || frameLength > _maxFrameLength || frameLength < 0 ){
+		_dropCount++;
+		return false;
+	}
+	uint8_t slot = head & (_depth - 1);
+	if( NULL != _pool ){
+		_blocks[slot] = _pool->acquire();
+		if( NULL == _blocks[slot] ){
+			_dropCount++;
+			return false;
+		}
+	}
+	memcpy( slotData(slot), frameData, frameLength );
+	_lengths[slot] = frameLength;
+	// Publish the frame to the consumer
+	QUEUE_STORE( _head, (uint8_t)(head + 1) );
+	count++;
+	if( count > _highWaterMark ){
+		_highWaterMark = count;
+	}
+	return true;
+}
+
+/*//////////////////////////////////////////////////////////////////////
+									CONSUMER METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: isEmpty()
+*  @ Since v0.1.2, October 2026
+*  @ Returns true if there are no frames waiting
+*/
+bool SimpleZigBeeFrameQueue::isEmpty(){
+	return 0 == available();
+}
+
+/**
+*  Method: available()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of frames waiting
+*/
+uint8_t SimpleZigBeeFrameQueue::available(){
+	return (uint8_t)(QUEUE_LOAD(_head) - _tail);
+}
+
+/**
+*  Method: peekFrameData()
+*  @ Since v0.1.2, October 2026
+*  @ Returns a pointer to the frame data of the oldest frame (without copying it), or NULL if the queue is empty.
+*    The pointer is valid until pop() is called.
+*/
+const uint8_t* SimpleZigBeeFrameQueue::peekFrameData(){
+	if( isEmpty() ){
+		return NULL;
+	}
+	return slotData( _tail & (_depth - 1) );
+}
+
+/**
+*  Method: peekFrameLength()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the frame length of the oldest frame, or 0 if the queue is empty.
+*/
+int SimpleZigBeeFrameQueue::peekFrameLength(){
+	if( isEmpty() ){
+		return 0;
+	}
+	return _lengths[_tail & (_depth - 1)];
+}
+
+/**
+*  Method: peek(SimpleIncomingZigBeePacket & packet)
+*  @ Since v0.1.2, October 2026
+*  @ Copies the oldest frame into the packet object without removing it from the queue. 
+*    Returns false if the queue is empty.
+*  @ param SimpleIncomingZigBeePacket & packet: Packet object for storing the frame
+*/
+bool SimpleZigBeeFrameQueue::peek(SimpleIncomingZigBeePacket & packet){
+	const uint8_t* frameData = peekFrameData();
+	if( NULL == frameData ){
+		return false;
+	}
+	int frameLength = peekFrameLength();
+	packet.reset();
+	packet.setFrameData( 0, frameData, frameLength );
+	packet.setChecksum( packet.calculateChecksum() );
+	return true;
+}
+
+/**
+*  Method: pop(SimpleIncomingZigBeePacket & packet)
+*  @ Since v0.1.2, October 2026
+*  @ Copies the oldest frame into the packet object and removes it from the queue. 
+*    Returns false if the queue is empty.
+*  @ param SimpleIncomingZigBeePacket & packet: Packet object for storing the frame
+*/
+bool SimpleZigBeeFrameQueue::pop(SimpleIncomingZigBeePacket & packet){
+	if( !peek(packet) ){
+		return false;
+	}
+	return pop();
+}
+
+/**
+*  Method: pop()
+*  @ Since v0.1.2, October 2026
+*  @ Removes the oldest frame from the queue (for example, after reading it with peekFrameData()).
+*    If a pool is used, the block of the frame is given back. Returns false if the queue is empty.
+*/
+bool SimpleZigBeeFrameQueue::pop(){
+	if( isEmpty() ){
+		return false;
+	}
+	if( NULL != _pool ){
+		_pool->release( _blocks[_tail & (_depth - 1)] );
+	}
+	// Hand the slot back to the producer
+	QUEUE_STORE( _tail, (uint8_t)(_tail + 1) );
+	return true;
+}
+
+/*//////////////////////////////////////////////////////////////////////
+									STATISTICS METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: getDepth()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of frames that can be stored
+*/
+uint8_t SimpleZigBeeFrameQueue::getDepth(){
+	return _depth;
+}
+
+/**
+*  Method: getHighWaterMark()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the largest number of frames that have been waiting in the queue at once
+*/
+uint8_t SimpleZigBeeFrameQueue::getHighWaterMark(){
+	return _highWaterMark;
+}
+
+/**
+*  Method: getDropCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of complete frames that were lost because the queue (or the pool) was full
+*/
+unsigned long SimpleZigBeeFrameQueue::getDropCount(){
+	return _dropCount;
+}
+
+/**
+*  Method: resetCounters()
+*  @ Since v0.1.2, October 2026
+*  @ Resets the high water mark and the drop count
+*/
+void SimpleZigBeeFrameQueue::resetCounters(){
+	_highWaterMark = 0;
+	_dropCount = 0;
+}
+
+/*//////////////////////////////////////////////////////////////////////
+									PRIVATE METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: slotData(uint8_t slot)
+*  @ Since v0.1.2, October 2026
+*  @ Returns a pointer to the storage of a slot (its block of the pool, if used).
+*  @ param uint8_t slot: Index of the slot
+*/
+uint8_t* SimpleZigBeeFrameQueue::slotData(uint8_t slot){
+	if( NULL != _pool ){
+		return _blocks[slot];
+	}
+	return _frames + (slot * _maxFrameLength);
+}
@@ -0,0 +1,141 @@
+/**
+* Library Name: SimpleZigBeeFrameQueue
+* Library URI: https://github.com/ericburger/simple-zigbee
+* Description: Queue for storing complete packets received by the connected radio
+* until the Arduino program is ready to process them.
+* Version: 0.1.2
+* Author(s): Eric Burger
+* Author URI: WallflowerOpen.com
+* License: GNU General Public License v2.0 or later
+* License URI: http://www.gnu.org/licenses/gpl-2.0.html 
+*
+* Copyright (c) 2013 Eric Burger. All rights reserved.
+*
+* This file is part of SimpleZigBee, written for XBee S2 Radios.
+*
+* SimpleZigBee is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* SimpleZigBee is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with SimpleZigBee.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SimpleZigBeeFrameQueue_h
+#define SimpleZigBeeFrameQueue_h
+
+#include "Arduino.h"
+// Requires SimpleZigBeePacket classes
+#include "SimpleZigBeePacket.h"
+// Requires SimpleZigBeeBufferPool class
+#include "SimpleZigBeeBufferPool.h"
+// Required for uint8_t type
+#include <inttypes.h>
+
+/**
+* Class: SimpleZigBeeFrameQueue
+* @ Since v0.1.2, October 2026
+* @ Fixed size ring of complete incoming frames. One side of the program (the "producer", normally
+*   the SimpleZigBeeRadio parser, which may run in an interrupt or a reader thread) adds frames with 
+*   push() and the other side (the "consumer", normally loop()) removes them with peek() and pop(). 
+*   As long as there is only one producer and one consumer, no locks or disabled interrupts are needed: 
+*   the producer only changes _head and the consumer only changes _tail.
+*   The storage for the frames is provided by SimpleZigBeeFrameQueueT (see below), so the queue
+*   does not use malloc(). The depth must be a power of 2 (2, 4, 8, ... 128).
+*   Alternatively, each frame can be stored in a block taken from a buffer pool when it is pushed and
+*   given back when it is popped (see SimpleZigBeePooledFrameQueueT), so several queues can share the
+*   memory of one pool. A frame that arrives while every block is in use is dropped.
+*/
+class SimpleZigBeeFrameQueue {
+public:
+	// INITIALIZATION METHODS //
+	SimpleZigBeeFrameQueue(uint8_t* frameStorage, uint16_t* lengthStorage, uint8_t depth, int maxFrameLength);
+	SimpleZigBeeFrameQueue(SimpleZigBeeBufferPool & pool, uint8_t** blockStorage, uint16_t* lengthStorage, uint8_t depth);
+	void clear();
+	
+	// PRODUCER METHODS //
+	bool push(const uint8_t* frameData, int frameLength);
+	
+	// CONSUMER METHODS //
+	bool isEmpty();
+	uint8_t available();
+	const uint8_t* peekFrameData();
+	int peekFrameLength();
+	bool peek(SimpleIncomingZigBeePacket & packet);
+	bool pop(SimpleIncomingZigBeePacket & packet);
+	bool pop();
+	
+	// STATISTICS METHODS //
+	uint8_t getDepth();
+	uint8_t getHighWaterMark();
+	unsigned long getDropCount();
+	void resetCounters();
+
+private:
+	uint8_t* slotData(uint8_t slot);
+
+	// Storage for depth frames of up to _maxFrameLength bytes each (NULL if a pool is used)
+	uint8_t* _frames;
+	// Pool that the frames are stored in, and the block of each slot (NULL if not used)
+	SimpleZigBeeBufferPool* _pool;
+	uint8_t** _blocks;
+	// Length of each stored frame
+	uint16_t* _lengths;
+	// Number of frames that can be stored (power of 2)
+	uint8_t _depth;
+	// Maximum number of bytes stored for each frame
+	int _maxFrameLength;
+	// Number of frames pushed (only changed by producer). The slot index is _head & (_depth-1).
+	uint8_t _head;
+	// Number of frames popped (only changed by consumer)
+	uint8_t _tail;
+	// Largest number of frames waiting in the queue
+	uint8_t _highWaterMark;
+	// Number of frames that could not be stored because the queue was full (or the frame was too long)
+	unsigned long _dropCount;
+};
+
+/**
+* Class: SimpleZigBeeFrameQueueT
+* @ Since v0.1.2, October 2026
+* @ Frame queue that holds its own storage for Depth frames of up to MaxFrameLength bytes. 
+*   For example, "SimpleZigBeeFrameQueueT<4> queue;" uses about 4 * 52 bytes of RAM.
+*/
+template<uint8_t Depth, int MaxFrameLength = SIMPLE_ZIGBEE_MAX_FRAME_LENGTH>
+class SimpleZigBeeFrameQueueT : public SimpleZigBeeFrameQueue {
+public:
+	SimpleZigBeeFrameQueueT() : SimpleZigBeeFrameQueue(_frame_storage, _length_storage, Depth, MaxFrameLength) {}
+	
+private:
+	static_assert( Depth >= 2 && Depth <= 128 && (Depth & (Depth-1)) == 0, "Depth must be a power of 2 between 2 and 128" );
+	uint8_t _frame_storage[Depth * MaxFrameLength];
+	uint16_t _length_storage[Depth];
+};
+
+/**
+* Class: SimpleZigBeePooledFrameQueueT
+* @ Since v0.1.2, October 2026
+* @ Frame queue for Depth frames that stores each frame in a block of the pool (up to the block size 
+*   of the pool). Only the block pointers and lengths are held by the queue.
+*   Example:
+*     SimpleZigBeeBufferPoolT<16> pool;
+*     SimpleZigBeePooledFrameQueueT<8> queue( pool );
+*/
+template<uint8_t Depth>
+class SimpleZigBeePooledFrameQueueT : public SimpleZigBeeFrameQueue {
+public:
+	SimpleZigBeePooledFrameQueueT(SimpleZigBeeBufferPool & pool) : SimpleZigBeeFrameQueue(pool, _block_storage, _length_storage, Depth) {}
+	
+private:
+	static_assert( Depth >= 2 && Depth <= 128 && (Depth & (Depth-1)) == 0, "Depth must be a power of 2 between 2 and 128" );
+	uint8_t* _block_storage[Depth];
+	uint16_t _length_storage[Depth];
+};
+
+#endif //SimpleZigBeeFrameQueue_h
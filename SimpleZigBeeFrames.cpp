@@ -0,0 +1,121 @@
+/**
+* Copyright (c) 2013 Eric Burger. All rights reserved.
+*/
+
+#include "SimpleZigBeeFrames.h"
+
+// Definitions of the layout constants, needed if one is passed by reference (before C++17)
+constexpr uint8_t SimpleZigBeeRxLayout::FRAME_TYPE;
+constexpr uint8_t SimpleZigBeeTxStatusLayout::FRAME_TYPE;
+constexpr uint8_t SimpleZigBeeAtResponseLayout::FRAME_TYPE;
+constexpr uint8_t SimpleZigBeeRemoteAtResponseLayout::FRAME_TYPE;
+constexpr uint8_t SimpleZigBeeModemStatusLayout::FRAME_TYPE;
+constexpr uint8_t SimpleZigBeeTxRequestLayout::FRAME_TYPE;
+constexpr uint8_t SimpleZigBeeAtCommandLayout::FRAME_TYPE;
+constexpr uint8_t SimpleZigBeeRemoteAtCommandLayout::FRAME_TYPE;
+
+/*//////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////
+										Decoded Frames
+////////////////////////////////////////////////////////////////////////
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: decode(SimpleIncomingZigBeePacket & packet)
+*  @ Since v0.1.2, October 2026
+*  @ Reads all of the fields of a ZigBee RX packet. Returns false if the packet is not a ZigBee RX packet.
+*  @ param SimpleIncomingZigBeePacket & packet: Received packet
+*/
+bool SimpleZigBeeRxFrame::decode(SimpleIncomingZigBeePacket & packet){
+	return decodeZigBeeFrame( packet.frameView(), *this );
+}
+
+/**
+*  Method: decode(SimpleZigBeeView frame)
+*  @ Since v0.1.2, October 2026
+*  @ Reads all of the fields of a ZigBee RX frame (for example, from SimpleZigBeeFrameQueue::peekFrameData()).
+*  @ param SimpleZigBeeView frame: Frame data, starting with the frame type
+*/
+bool SimpleZigBeeRxFrame::decode(SimpleZigBeeView frame){
+	return decodeZigBeeFrame( frame, *this );
+}
+
+/**
+*  Method: decode(SimpleIncomingZigBeePacket & packet)
+*  @ Since v0.1.2, October 2026
+*  @ Reads all of the fields of a ZigBee TX Status packet. Returns false if the packet is not a TX Status.
+*  @ param SimpleIncomingZigBeePacket & packet: Received packet
+*/
+bool SimpleZigBeeTxStatusFrame::decode(SimpleIncomingZigBeePacket & packet){
+	return decodeZigBeeFrame( packet.frameView(), *this );
+}
+
+/**
+*  Method: decode(SimpleZigBeeView frame)
+*  @ Since v0.1.2, October 2026
+*  @ Reads all of the fields of a ZigBee TX Status frame.
+*  @ param SimpleZigBeeView frame: Frame data, starting with the frame type
+*/
+bool SimpleZigBeeTxStatusFrame::decode(SimpleZigBeeView frame){
+	return decodeZigBeeFrame( frame, *this );
+}
+
+/**
+*  Method: decode(SimpleIncomingZigBeePacket & packet)
+*  @ Since v0.1.2, October 2026
+*  @ Reads all of the fields of an AT Command Response packet. Returns false if the packet is not an AT Command Response.
+*  @ param SimpleIncomingZigBeePacket & packet: Received packet
+*/
+bool SimpleZigBeeAtResponseFrame::decode(SimpleIncomingZigBeePacket & packet){
+	return decodeZigBeeFrame( packet.frameView(), *this );
+}
+
+/**
+*  Method: decode(SimpleZigBeeView frame)
+*  @ Since v0.1.2, October 2026
+*  @ Reads all of the fields of an AT Command Response frame.
+*  @ param SimpleZigBeeView frame: Frame data, starting with the frame type
+*/
+bool SimpleZigBeeAtResponseFrame::decode(SimpleZigBeeView frame){
+	return decodeZigBeeFrame( frame, *this );
+}
+
+/**
+*  Method: decode(SimpleIncomingZigBeePacket & packet)
+*  @ Since v0.1.2, October 2026
+*  @ Reads all of the fields of a Remote AT Command Response packet. Returns false if the packet is not a Remote AT Command Response.
+*  @ param SimpleIncomingZigBeePacket & packet: Received packet
+*/
+bool SimpleZigBeeRemoteAtResponseFrame::decode(SimpleIncomingZigBeePacket & packet){
+	return decodeZigBeeFrame( packet.frameView(), *this );
+}
+
+/**
+*  Method: decode(SimpleZigBeeView frame)
+*  @ Since v0.1.2, October 2026
+*  @ Reads all of the fields of a Remote AT Command Response frame.
+*  @ param SimpleZigBeeView frame: Frame data, starting with the frame type
+*/
+bool SimpleZigBeeRemoteAtResponseFrame::decode(SimpleZigBeeView frame){
+	return decodeZigBeeFrame( frame, *this );
+}
+
+/**
+*  Method: decode(SimpleIncomingZigBeePacket & packet)
+*  @ Since v0.1.2, October 2026
+*  @ Reads the status of a Modem Status packet. Returns false if the packet is not a Modem Status.
+*  @ param SimpleIncomingZigBeePacket & packet: Received packet
+*/
+bool SimpleZigBeeModemStatusFrame::decode(SimpleIncomingZigBeePacket & packet){
+	return decodeZigBeeFrame( packet.frameView(), *this );
+}
+
+/**
+*  Method: decode(SimpleZigBeeView frame)
+*  @ Since v0.1.2, October 2026
+*  @ Reads the status of a Modem Status frame.
+*  @ param SimpleZigBeeView frame: Frame data, starting with the frame type
+*/
+bool SimpleZigBeeModemStatusFrame::decode(SimpleZigBeeView frame){
+	return decodeZigBeeFrame( frame, *this );
+}
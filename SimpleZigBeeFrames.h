@@ -0,0 +1,318 @@
+/**
+* Library Name: SimpleZigBeeFrames
+* Library URI: https://github.com/ericburger/simple-zigbee
+* Description: Frame layouts and decoders for the API frames sent and received
+* by the connected radio.
+* Version: 0.1.2
+* Author(s): Eric Burger
+* Author URI: WallflowerOpen.com
+* License: GNU General Public License v2.0 or later
+* License URI: http://www.gnu.org/licenses/gpl-2.0.html 
+*
+* Copyright (c) 2013 Eric Burger. All rights reserved.
+*
+* This file is part of SimpleZigBee, written for XBee S2 Radios.
+*
+* SimpleZigBee is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* SimpleZigBee is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with SimpleZigBee.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SimpleZigBeeFrames_h
+#define SimpleZigBeeFrames_h
+
+#include "Arduino.h"
+// Requires SimpleZigBeePacket classes and the list of API frame types
+#include "SimpleZigBeePacket.h"
+// Required for uint8_t type
+#include <inttypes.h>
+
+/**
+* Frame Layouts
+* @ Since v0.1.2, October 2026
+* @ Frame index of each field of the API frames used by the library. Frame index 0 is the frame type.
+*   MIN_FRAME_LENGTH is the length of the frame without its payload (or AT command data). These values
+*   are known at compile time, so using them costs the same as writing the numbers directly.
+*   ID_INDEX is the frame index of the Frame ID (FRAME_ID_INDEX is the packet index, which includes the START and length bytes).
+*/
+struct SimpleZigBeeRxLayout {
+	static constexpr uint8_t FRAME_TYPE = ZIGBEE_RECIEVED_PACKET;
+	static constexpr int ADDRESS64_INDEX = 1;
+	static constexpr int ADDRESS16_INDEX = 9;
+	static constexpr int OPTIONS_INDEX = 11;
+	static constexpr int PAYLOAD_INDEX = 12;
+	static constexpr int MIN_FRAME_LENGTH = PAYLOAD_INDEX;
+};
+
+struct SimpleZigBeeTxStatusLayout {
+	static constexpr uint8_t FRAME_TYPE = ZIGBEE_TX_STATUS;
+	static constexpr int ID_INDEX = 1;
+	static constexpr int ADDRESS16_INDEX = 2;
+	static constexpr int RETRY_COUNT_INDEX = 4;
+	static constexpr int DELIVERY_STATUS_INDEX = 5;
+	static constexpr int DISCOVERY_STATUS_INDEX = 6;
+	static constexpr int MIN_FRAME_LENGTH = 7;
+};
+
+struct SimpleZigBeeAtResponseLayout {
+	static constexpr uint8_t FRAME_TYPE = AT_COMMAND_RESPONSE;
+	static constexpr int ID_INDEX = 1;
+	static constexpr int COMMAND_INDEX = 2;
+	static constexpr int STATUS_INDEX = 4;
+	static constexpr int PAYLOAD_INDEX = 5;
+	static constexpr int MIN_FRAME_LENGTH = PAYLOAD_INDEX;
+};
+
+struct SimpleZigBeeRemoteAtResponseLayout {
+	static constexpr uint8_t FRAME_TYPE = REMOTE_AT_COMMAND_RESPONSE;
+	static constexpr int ID_INDEX = 1;
+	static constexpr int ADDRESS64_INDEX = 2;
+	static constexpr int ADDRESS16_INDEX = 10;
+	static constexpr int COMMAND_INDEX = 12;
+	static constexpr int STATUS_INDEX = 14;
+	static constexpr int PAYLOAD_INDEX = 15;
+	static constexpr int MIN_FRAME_LENGTH = PAYLOAD_INDEX;
+};
+
+struct SimpleZigBeeModemStatusLayout {
+	static constexpr uint8_t FRAME_TYPE = MODEM_STATUS;
+	static constexpr int STATUS_INDEX = 1;
+	static constexpr int MIN_FRAME_LENGTH = 2;
+};
+
+struct SimpleZigBeeTxRequestLayout {
+	static constexpr uint8_t FRAME_TYPE = ZIGBEE_TRANSMIT_REQUEST;
+	static constexpr int ID_INDEX = 1;
+	static constexpr int ADDRESS64_INDEX = 2;
+	static constexpr int ADDRESS16_INDEX = 10;
+	static constexpr int RADIUS_INDEX = 12;
+	static constexpr int OPTIONS_INDEX = 13;
+	static constexpr int PAYLOAD_INDEX = 14;
+	static constexpr int MIN_FRAME_LENGTH = PAYLOAD_INDEX;
+};
+
+struct SimpleZigBeeAtCommandLayout {
+	static constexpr uint8_t FRAME_TYPE = AT_COMMAND;
+	static constexpr int ID_INDEX = 1;
+	static constexpr int COMMAND_INDEX = 2;
+	static constexpr int PAYLOAD_INDEX = 4;
+	static constexpr int MIN_FRAME_LENGTH = PAYLOAD_INDEX;
+};
+
+struct SimpleZigBeeRemoteAtCommandLayout {
+	static constexpr uint8_t FRAME_TYPE = REMOTE_AT_COMMAND;
+	static constexpr int ID_INDEX = 1;
+	static constexpr int ADDRESS64_INDEX = 2;
+	static constexpr int ADDRESS16_INDEX = 10;
+	static constexpr int OPTIONS_INDEX = 12;
+	static constexpr int COMMAND_INDEX = 13;
+	static constexpr int PAYLOAD_INDEX = 15;
+	static constexpr int MIN_FRAME_LENGTH = PAYLOAD_INDEX;
+};
+
+// The 16-bit addresses of the hops (ADDRESSES_INDEX, 2 bytes each) start with the neighbor of the 
+// destination (Create Source Route) or of the device that sent the route record (Route Record Indicator)
+struct SimpleZigBeeCreateSourceRouteLayout {
+	static constexpr uint8_t FRAME_TYPE = CREATE_SOURCE_ROUTE;
+	static constexpr int ID_INDEX = 1;
+	static constexpr int ADDRESS64_INDEX = 2;
+	static constexpr int ADDRESS16_INDEX = 10;
+	static constexpr int OPTIONS_INDEX = 12;
+	static constexpr int COUNT_INDEX = 13;
+	static constexpr int ADDRESSES_INDEX = 14;
+	static constexpr int MIN_FRAME_LENGTH = ADDRESSES_INDEX;
+};
+
+struct SimpleZigBeeRouteRecordLayout {
+	static constexpr uint8_t FRAME_TYPE = ROUTE_RECORD_INDICATOR;
+	static constexpr int ADDRESS64_INDEX = 1;
+	static constexpr int ADDRESS16_INDEX = 9;
+	static constexpr int OPTIONS_INDEX = 11;
+	static constexpr int COUNT_INDEX = 12;
+	static constexpr int ADDRESSES_INDEX = 13;
+	static constexpr int MIN_FRAME_LENGTH = ADDRESSES_INDEX;
+};
+
+/**
+* Class: SimpleZigBeeBigEndian
+* @ Since v0.1.2, October 2026
+* @ Reads the multi-byte fields of a frame, which are sent most significant byte first. On computers 
+*   with little-endian processors, each field is loaded as a whole word and the bytes are swapped with 
+*   a single instruction. On Arduino boards, the bytes are combined with shifts.
+*   write16() and write32() store a field most significant byte first.
+*/
+class SimpleZigBeeBigEndian {
+public:
+	static inline uint16_t read16(const uint8_t* data){
+#if !defined(__AVR__) && defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+		uint16_t value;
+		memcpy( &value, data, 2 );
+		return __builtin_bswap16( value );
+#else
+		return ( uint16_t(data[0]) << 8 ) | data[1];
+#endif
+	}
+	static inline uint32_t read32(const uint8_t* data){
+#if !defined(__AVR__) && defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+		uint32_t value;
+		memcpy( &value, data, 4 );
+		return __builtin_bswap32( value );
+#else
+		return ( uint32_t(data[0]) << 24 ) | ( uint32_t(data[1]) << 16 ) | ( uint16_t(data[2]) << 8 ) | data[3];
+#endif
+	}
+	static inline void write16(uint8_t* data, uint16_t value){
+		data[0] = (uint8_t)(value >> 8);
+		data[1] = (uint8_t)value;
+	}
+	static inline void write32(uint8_t* data, uint32_t value){
+		data[0] = (uint8_t)(value >> 24);
+		data[1] = (uint8_t)(value >> 16);
+		data[2] = (uint8_t)(value >> 8);
+		data[3] = (uint8_t)value;
+	}
+};
+
+/**
+* Decoded Frames
+* @ Since v0.1.2, October 2026
+* @ Plain structures holding every field of a received frame. decode() checks the frame type and
+*   length once, then reads each field directly from the frame data. It returns false (and leaves the
+*   structure unchanged) if the packet is not of the expected frame type or is too short. Payloads 
+*   are views into the packet (see SimpleZigBeeView), so they are only valid until the packet changes.
+*   load() reads the fields without checking the frame type, and leaves the structure unchanged if the
+*   frame is shorter than Layout::MIN_FRAME_LENGTH.
+*   Example:
+*     SimpleZigBeeRxFrame rx;
+*     if( rx.decode( packet ) ){ ... rx.address16 ... rx.payload[0] ... }
+*/
+struct SimpleZigBeeRxFrame {
+	typedef SimpleZigBeeRxLayout Layout;
+	uint32_t address64MSB;
+	uint32_t address64LSB;
+	uint16_t address16;
+	uint8_t options;
+	SimpleZigBeeView payload;
+	
+	bool decode(SimpleIncomingZigBeePacket & packet);
+	bool decode(SimpleZigBeeView frame);
+	void load(const uint8_t* frameData, int frameLength){
+		if( frameLength < Layout::MIN_FRAME_LENGTH ){
+			return;
+		}
+		address64MSB = SimpleZigBeeBigEndian::read32( frameData + Layout::ADDRESS64_INDEX );
+		address64LSB = SimpleZigBeeBigEndian::read32( frameData + Layout::ADDRESS64_INDEX + 4 );
+		address16 = SimpleZigBeeBigEndian::read16( frameData + Layout::ADDRESS16_INDEX );
+		options = frameData[Layout::OPTIONS_INDEX];
+		payload = SimpleZigBeeView( frameData + Layout::PAYLOAD_INDEX, frameLength - Layout::PAYLOAD_INDEX );
+	}
+};
+
+struct SimpleZigBeeTxStatusFrame {
+	typedef SimpleZigBeeTxStatusLayout Layout;
+	uint8_t frameID;
+	uint16_t address16;
+	uint8_t retryCount;
+	uint8_t deliveryStatus;
+	uint8_t discoveryStatus;
+	
+	bool decode(SimpleIncomingZigBeePacket & packet);
+	bool decode(SimpleZigBeeView frame);
+	void load(const uint8_t* frameData, int frameLength){
+		if( frameLength < Layout::MIN_FRAME_LENGTH ){
+			return;
+		}
+		frameID = frameData[Layout::ID_INDEX];
+		address16 = SimpleZigBeeBigEndian::read16( frameData + Layout::ADDRESS16_INDEX );
+		retryCount = frameData[Layout::RETRY_COUNT_INDEX];
+		deliveryStatus = frameData[Layout::DELIVERY_STATUS_INDEX];
+		discoveryStatus = frameData[Layout::DISCOVERY_STATUS_INDEX];
+	}
+};
+
+struct SimpleZigBeeAtResponseFrame {
+	typedef SimpleZigBeeAtResponseLayout Layout;
+	uint8_t frameID;
+	uint16_t command;
+	uint8_t status;
+	SimpleZigBeeView payload;
+	
+	bool decode(SimpleIncomingZigBeePacket & packet);
+	bool decode(SimpleZigBeeView frame);
+	void load(const uint8_t* frameData, int frameLength){
+		if( frameLength < Layout::MIN_FRAME_LENGTH ){
+			return;
+		}
+		frameID = frameData[Layout::ID_INDEX];
+		command = SimpleZigBeeBigEndian::read16( frameData + Layout::COMMAND_INDEX );
+		status = frameData[Layout::STATUS_INDEX];
+		payload = SimpleZigBeeView( frameData + Layout::PAYLOAD_INDEX, frameLength - Layout::PAYLOAD_INDEX );
+	}
+};
+
+struct SimpleZigBeeRemoteAtResponseFrame {
+	typedef SimpleZigBeeRemoteAtResponseLayout Layout;
+	uint8_t frameID;
+	uint32_t address64MSB;
+	uint32_t address64LSB;
+	uint16_t address16;
+	uint16_t command;
+	uint8_t status;
+	SimpleZigBeeView payload;
+	
+	bool decode(SimpleIncomingZigBeePacket & packet);
+	bool decode(SimpleZigBeeView frame);
+	void load(const uint8_t* frameData, int frameLength){
+		if( frameLength < Layout::MIN_FRAME_LENGTH ){
+			return;
+		}
+		frameID = frameData[Layout::ID_INDEX];
+		address64MSB = SimpleZigBeeBigEndian::read32( frameData + Layout::ADDRESS64_INDEX );
+		address64LSB = SimpleZigBeeBigEndian::read32( frameData + Layout::ADDRESS64_INDEX + 4 );
+		address16 = SimpleZigBeeBigEndian::read16( frameData + Layout::ADDRESS16_INDEX );
+		command = SimpleZigBeeBigEndian::read16( frameData + Layout::COMMAND_INDEX );
+		status = frameData[Layout::STATUS_INDEX];
+		payload = SimpleZigBeeView( frameData + Layout::PAYLOAD_INDEX, frameLength - Layout::PAYLOAD_INDEX );
+	}
+};
+
+struct SimpleZigBeeModemStatusFrame {
+	typedef SimpleZigBeeModemStatusLayout Layout;
+	uint8_t status;
+	
+	bool decode(SimpleIncomingZigBeePacket & packet);
+	bool decode(SimpleZigBeeView frame);
+	void load(const uint8_t* frameData, int frameLength){
+		if( frameLength < Layout::MIN_FRAME_LENGTH ){
+			return;
+		}
+		status = frameData[Layout::STATUS_INDEX];
+	}
+};
+
+/**
+* Function: decodeZigBeeFrame(SimpleZigBeeView frame, Frame & decoded)
+* @ Since v0.1.2, October 2026
+* @ Shared by the decode() methods above. Checks the frame type and frame length against Frame::Layout,
+*   then fills in the structure with Frame::load(). Returns false if the frame does not match.
+*/
+template<class Frame>
+inline bool decodeZigBeeFrame(SimpleZigBeeView frame, Frame & decoded){
+	if( frame.getLength() < Frame::Layout::MIN_FRAME_LENGTH || Frame::Layout::FRAME_TYPE != frame[0] ){
+		return false;
+	}
+	decoded.load( frame.getData(), frame.getLength() );
+	return true;
+}
+
+#endif //SimpleZigBeeFrames_h
@@ -3,6 +3,10 @@
 */
 
 #include "SimpleZigBeePacket.h"
+// Frame index of each field (frame layouts)
+#include "SimpleZigBeeFrames.h"
+// Memory arrays taken from a pool of blocks
+#include "SimpleZigBeeBufferPool.h"
 // For memory allocation of array pointer (malloc and realloc)
 //#include < ctype.h >
 
@@ -29,7 +33,9 @@
 SimpleZigBeePacket::SimpleZigBeePacket() {
 	_memoryArrayLength = 20;
 	_ptrMemoryArray = (uint8_t*) malloc(sizeof(uint8_t) * _memoryArrayLength);
-	_maxFrameLength = 50;
+	_ownsMemoryArray = true;
+	_pool = NULL;
+	_maxFrameLength = SIMPLE_ZIGBEE_MAX_FRAME_LENGTH;
 	init();
 }
 
@@ -44,10 +50,155 @@ SimpleZigBeePacket::SimpleZigBeePacket() {
 SimpleZigBeePacket::SimpleZigBeePacket(int maxFrameLength) {
 	_memoryArrayLength = 20;
 	_ptrMemoryArray = (uint8_t*) malloc(sizeof(uint8_t) * _memoryArrayLength);
+	_ownsMemoryArray = true;
+	_pool = NULL;
 	_maxFrameLength = maxFrameLength;
 	init();
 }
 
+/**
+*  Constructor: SimpleZigBeePacket(uint8_t* memoryArray, int maxFrameLength)
+*  @ Since v0.1.2, October 2026
+*  @ Protected constructor for packets that provide their own memory array (see SimpleZigBeePacketT).
+*      The memory array must hold maxFrameLength bytes and is never expanded (or freed), so no memory is allocated.
+*  @ param uint8_t* memoryArray: Array used to store the frame data
+*  @ param int maxFrameLength: Length of the array and limit to the length (# of bytes) of the packet frame
+*/
+SimpleZigBeePacket::SimpleZigBeePacket(uint8_t* memoryArray, int maxFrameLength) {
+	_memoryArrayLength = maxFrameLength;
+	_ptrMemoryArray = memoryArray;
+	_ownsMemoryArray = false;
+	_pool = NULL;
+	_maxFrameLength = maxFrameLength;
+	init();
+}
+
+/**
+*  Constructor: SimpleZigBeePacket(SimpleZigBeeBufferPool & pool)
+*  @ Since v0.1.2, October 2026
+*  @ Constructor that takes a block from the pool as the memory array. The maximum frame length is the
+*      block size, no memory is allocated, and the block is given back to the pool when the packet is destroyed.
+*      If the pool has no free block, the maximum frame length is 0 (see pool.getFailCount()).
+*  @ param SimpleZigBeeBufferPool & pool: Pool of blocks (for example, SimpleZigBeeBufferPoolT<16>)
+*/
+SimpleZigBeePacket::SimpleZigBeePacket(SimpleZigBeeBufferPool & pool) {
+	_ptrMemoryArray = pool.acquire();
+	_ownsMemoryArray = true;
+	if( NULL != _ptrMemoryArray ){
+		_pool = &pool;
+		_memoryArrayLength = pool.getBlockSize();
+	}else{
+		_pool = NULL;
+		_memoryArrayLength = 0;
+	}
+	_maxFrameLength = _memoryArrayLength;
+	init();
+}
+
+/**
+*  Constructor: SimpleZigBeePacket(SimpleZigBeePacket && packet)
+*  @ Since v0.1.2, October 2026
+*  @ Move constructor. Takes the memory array of the other packet, so nothing is allocated or copied, and
+*      leaves the other packet empty (it allocates a new memory array if it is used again). Blocks from a pool are
+*      handed over in the same way. If the other packet stores its frame data in a fixed array (see SimpleZigBeePacketT),
+*      the frame data is copied instead.
+*  @ param SimpleZigBeePacket && packet: Packet to move
+*/
+SimpleZigBeePacket::SimpleZigBeePacket(SimpleZigBeePacket && packet) {
+	_maxFrameLength = packet._maxFrameLength;
+	_ownsMemoryArray = true;
+	_pool = NULL;
+	if( packet._ownsMemoryArray ){
+		_memoryArrayLength = packet._memoryArrayLength;
+		_ptrMemoryArray = packet._ptrMemoryArray;
+		_pool = packet._pool;
+		_checksum = packet._checksum;
+		_frameLength = packet._frameLength;
+		_errorCode = packet._errorCode;
+		packet._memoryArrayLength = 0;
+		packet._ptrMemoryArray = NULL;
+		packet._pool = NULL;
+		packet.init();
+	}else{
+		_memoryArrayLength = 0;
+		_ptrMemoryArray = NULL;
+		copyFrom( packet );
+	}
+}
+
+/**
+*  Method: operator=(SimpleZigBeePacket && packet)
+*  @ Since v0.1.2, October 2026
+*  @ Move assignment. If both packets allocated their memory arrays (or took them from a pool), the arrays 
+*      are swapped and the other packet is reset. Otherwise, the frame data is copied with copyFrom().
+*  @ param SimpleZigBeePacket && packet: Packet to move
+*/
+SimpleZigBeePacket & SimpleZigBeePacket::operator=(SimpleZigBeePacket && packet){
+	if( this == &packet ){
+		return *this;
+	}
+	if( _ownsMemoryArray && packet._ownsMemoryArray ){
+		uint8_t* memoryArray = _ptrMemoryArray;
+		int memoryArrayLength = _memoryArrayLength;
+		int maxFrameLength = _maxFrameLength;
+		SimpleZigBeeBufferPool* pool = _pool;
+		_ptrMemoryArray = packet._ptrMemoryArray;
+		_memoryArrayLength = packet._memoryArrayLength;
+		_maxFrameLength = packet._maxFrameLength;
+		_pool = packet._pool;
+		_checksum = packet._checksum;
+		_frameLength = packet._frameLength;
+		_errorCode = packet._errorCode;
+		packet._ptrMemoryArray = memoryArray;
+		packet._memoryArrayLength = memoryArrayLength;
+		packet._maxFrameLength = maxFrameLength;
+		packet._pool = pool;
+		packet.init();
+	}else{
+		copyFrom( packet );
+	}
+	return *this;
+}
+
+/**
+*  Destructor: ~SimpleZigBeePacket()
+*  @ Since v0.1.2, October 2026
+*  @ Frees the memory array or gives it back to its pool (unless it is a fixed array, see SimpleZigBeePacketT).
+*/
+SimpleZigBeePacket::~SimpleZigBeePacket() {
+	if( NULL != _pool ){
+		_pool->release( _ptrMemoryArray );
+	}else if( _ownsMemoryArray ){
+		free( _ptrMemoryArray );
+	}
+}
+
+/**
+*  Method: copyFrom(const SimpleZigBeePacket & packet)
+*  @ Since v0.1.2, October 2026
+*  @ Copies the frame data, checksum and error code of another packet into this packet's own memory array.
+*      This is the only way to copy a packet, so that copies (and the memory they may allocate) are easy to see.
+*      If the frame data does not fit in this packet, no frame data is copied and the error code is MAX_FRAME_LENGTH_EXCEEDED.
+*  @ param const SimpleZigBeePacket & packet: Packet to copy
+*/
+void SimpleZigBeePacket::copyFrom(const SimpleZigBeePacket & packet){
+	if( this == &packet ){
+		return;
+	}
+	init();
+	int length = packet._frameLength;
+	if( length > packet._memoryArrayLength ){
+		length = packet._memoryArrayLength;
+	}
+	if( length > 0 ){
+		setFrameData( 0, packet._ptrMemoryArray, length );
+	}
+	if( !isError() ){
+		_errorCode = packet._errorCode;
+	}
+	_checksum = packet._checksum;
+}
+
 /**
 *  Method: init()
 *  @ Since v0.1.0 by Eric Burger, August 2013
@@ -80,9 +231,21 @@ void SimpleZigBeePacket::reset() {
 *      a function for reducing the memory array size. The reasoning being that if a certain size of packet has 
 *      been sent or received in the past, it is likely to occur again. 
 *  @ param int size: Desired size (# of bytes) of memory allocated to store the packet frame data
+*  @ Last Modified v0.1.2 by Eric Burger, October 2026
+*  @ Changlog for v0.1.2:
+*       - Sizes larger than the maximum frame length are reduced to the maximum frame length instead of being ignored.
+*         Previously, setMemoryData() could write past the end of the memory array near the maximum frame length.
+*       - Fixed arrays (see SimpleZigBeePacketT) and blocks from a pool are never expanded.
 */
 void SimpleZigBeePacket::expandMemoryArray(int size){
-	if( size > _memoryArrayLength && size <= getMaxFrameLength() ){
+	if( !_ownsMemoryArray || NULL != _pool ){
+		// Fixed arrays and blocks from a pool already hold the maximum frame length
+		return;
+	}
+	if( size > getMaxFrameLength() ){
+		size = getMaxFrameLength();
+	}
+	if( size > _memoryArrayLength ){
 		uint8_t* new_array = NULL;
 		// Re-allocate memory to accommodate the increased size of the memory array.
 		// For reference: http://www.cplusplus.com/reference/cstdlib/realloc/
@@ -283,15 +446,18 @@ void SimpleZigBeePacket::setFrameData(int index, uint8_t byte){
 }
 
 /**
-*  Method: setFrameData(int startIndex, uint8_t* frameData, int frameDataLength)
+*  Method: setFrameData(int startIndex, const uint8_t* frameData, int frameDataLength)
 *  @ Since v0.1.0 by Eric Burger, August 2013
 *  @ Sets an array of bytes in the memory array of the packet, starting
 *      from specified start index,and updates _frameLength, if necessary.
 *  @ param int startIndex: Index at which to start storing bytes
-*  @ param uint8_t* frameData: Pointer to array of bytes to store
+*  @ param const uint8_t* frameData: Pointer to array of bytes to store
 *  @ param int frameDataLength: Length of array to input
+*  @ Last Modified v0.1.2 by Eric Burger, October 2026
+*  @ Changlog for v0.1.2:
+*       - Array is now const so that received bytes can be stored without copying them first
 */ 
-void SimpleZigBeePacket::setFrameData(int startIndex, uint8_t* frameData, int frameDataLength){
+void SimpleZigBeePacket::setFrameData(int startIndex, const uint8_t* frameData, int frameDataLength){
 	int lastIndex = startIndex + (frameDataLength - 1);
 	if( lastIndex < getMaxFrameLength() ){
 		// Expand memory array, if necessary
@@ -342,6 +508,53 @@ void SimpleZigBeePacket::getFrameData(int startIndex, uint8_t* arrayPtr, int fra
 	}
 }
 
+/**
+*  Method: getFrameDataPointer()
+*  @ Since v0.1.2, October 2026
+*  @ Returns a pointer to the first byte of frame data (the frame type) so that the frame can be read
+*      as an array of getFrameLength() bytes without copying it. Returns NULL if part of the frame is not
+*      stored in the memory array (which can happen if setFrameLength() was used to increase the length).
+*      The pointer is only valid until the packet is changed, since storing more data may move the memory array.
+*/
+const uint8_t* SimpleZigBeePacket::getFrameDataPointer(){
+	if( getFrameLength() > _memoryArrayLength ){
+		return NULL;
+	}
+	return _ptrMemoryArray;
+}
+
+/**
+*  Method: getFrameDataPointer(int startIndex, int frameDataLength)
+*  @ Since v0.1.2, October 2026
+*  @ Returns a pointer to the frame data byte at startIndex, so that frameDataLength bytes can be read 
+*      without copying them. Unlike getFrameDataPointer(), only the requested bytes must be stored in the 
+*      memory array (used by SimpleZigBeeRadio for packets that are longer than the array, see 
+*      SimpleZigBeeRadio::setPayloadSink()). Returns NULL if they are not.
+*      The pointer is only valid until the packet is changed.
+*  @ param int startIndex: Frame data index of the first byte
+*  @ param int frameDataLength: Number of bytes to read
+*/
+const uint8_t* SimpleZigBeePacket::getFrameDataPointer(int startIndex, int frameDataLength){
+	if( startIndex < 0 || frameDataLength < 0 || (startIndex + frameDataLength) > _memoryArrayLength ){
+		return NULL;
+	}
+	return _ptrMemoryArray + startIndex;
+}
+
+/**
+*  Method: frameView()
+*  @ Since v0.1.2, October 2026
+*  @ Returns a view of the complete frame data (starting with the frame type), or an empty view if the
+*      frame data is not stored in the memory array (see getFrameDataPointer()).
+*/
+SimpleZigBeeView SimpleZigBeePacket::frameView(){
+	const uint8_t* frameData = getFrameDataPointer();
+	if( NULL == frameData || getFrameLength() <= 0 ){
+		return SimpleZigBeeView();
+	}
+	return SimpleZigBeeView( frameData, getFrameLength() );
+}
+
 /*//////////////////////////////////////////////////////////////////////
 									ERROR CODE METHODS
 /*//////////////////////////////////////////////////////////////////////
@@ -404,6 +617,25 @@ SimpleIncomingZigBeePacket::SimpleIncomingZigBeePacket(int maxFrameLength) : Sim
 	SimpleZigBeePacket::init();
 }
 
+/**
+*  Constructor: SimpleIncomingZigBeePacket(SimpleZigBeeBufferPool & pool)
+*  @ Since v0.1.2, October 2026
+*  @ Constructor that takes a block from the pool as the memory array (see SimpleZigBeePacket(SimpleZigBeeBufferPool & pool)).
+*  @ param SimpleZigBeeBufferPool & pool: Pool of blocks
+*/
+SimpleIncomingZigBeePacket::SimpleIncomingZigBeePacket(SimpleZigBeeBufferPool & pool) : SimpleZigBeePacket(pool) {
+}
+
+/**
+*  Constructor: SimpleIncomingZigBeePacket(uint8_t* memoryArray, int maxFrameLength)
+*  @ Since v0.1.2, October 2026
+*  @ Protected constructor for packets that provide their own memory array (see SimpleZigBeePacketT).
+*  @ param uint8_t* memoryArray: Array of maxFrameLength bytes used to store the frame data
+*  @ param int maxFrameLength: Limit to the length (# of bytes) of the packet frame
+*/
+SimpleIncomingZigBeePacket::SimpleIncomingZigBeePacket(uint8_t* memoryArray, int maxFrameLength) : SimpleZigBeePacket(memoryArray, maxFrameLength) {
+}
+
 /*//////////////////////////////////////////////////////////////////////
 							ZIGBEE RECIEVED (RX) PACKET METHODS
 /*//////////////////////////////////////////////////////////////////////
@@ -425,8 +657,9 @@ SimpleZigBeeAddress SimpleIncomingZigBeePacket::getRXAddress(){
 *  @ Cast bytes as 32-bit or 16-bit before bitshift left
 */
 SimpleZigBeeAddress64 SimpleIncomingZigBeePacket::getRXAddress64(){
-	uint32_t msb = (uint32_t(getFrameData(1)) << 24) + (uint32_t(getFrameData(2)) << 16) + (uint16_t(getFrameData(3)) << 8) + getFrameData(4);
-	uint32_t lsb = (uint32_t(getFrameData(5)) << 24) + (uint32_t(getFrameData(6)) << 16) + (uint16_t(getFrameData(7)) << 8) + getFrameData(8);
+	int i = SimpleZigBeeRxLayout::ADDRESS64_INDEX;
+	uint32_t msb = (uint32_t(getFrameData(i)) << 24) + (uint32_t(getFrameData(i+1)) << 16) + (uint16_t(getFrameData(i+2)) << 8) + getFrameData(i+3);
+	uint32_t lsb = (uint32_t(getFrameData(i+4)) << 24) + (uint32_t(getFrameData(i+5)) << 16) + (uint16_t(getFrameData(i+6)) << 8) + getFrameData(i+7);
 	return SimpleZigBeeAddress64( msb, lsb );
 }
 
@@ -437,7 +670,8 @@ SimpleZigBeeAddress64 SimpleIncomingZigBeePacket::getRXAddress64(){
 *  @ Cast bytes as 16-bit before bitshift left 
 */
 SimpleZigBeeAddress16 SimpleIncomingZigBeePacket::getRXAddress16(){
-	uint16_t addr = (uint16_t(getFrameData(9)) << 8) + getFrameData(10);
+	int i = SimpleZigBeeRxLayout::ADDRESS16_INDEX;
+	uint16_t addr = (uint16_t(getFrameData(i)) << 8) + getFrameData(i+1);
 	return SimpleZigBeeAddress16( addr );
 }
 
@@ -447,7 +681,7 @@ SimpleZigBeeAddress16 SimpleIncomingZigBeePacket::getRXAddress16(){
 *  @ Returns value of packet receive option (Packet Index 14, Frame Index 11)
 */
 uint8_t SimpleIncomingZigBeePacket::getRXOptions(){
-	return getFrameData(11);
+	return getFrameData( SimpleZigBeeRxLayout::OPTIONS_INDEX );
 }
 /**
 *  Method: getRXPayloadLength(int index)
@@ -455,7 +689,7 @@ uint8_t SimpleIncomingZigBeePacket::getRXOptions(){
 *  @ Returns the payload length of the incoming packet. 
 */
 uint8_t SimpleIncomingZigBeePacket::getRXPayloadLength(){
-	return getFrameLength()-12;
+	return getFrameLength() - SimpleZigBeeRxLayout::PAYLOAD_INDEX;
 }
 /**
 *  Method: getRXPayload(int index)
@@ -465,7 +699,17 @@ uint8_t SimpleIncomingZigBeePacket::getRXPayloadLength(){
 *  @ param int index: Index of payload data
 */
 uint8_t SimpleIncomingZigBeePacket::getRXPayload(int index){
-	return getFrameData(index+12);
+	return getFrameData( index + SimpleZigBeeRxLayout::PAYLOAD_INDEX );
+}
+
+/**
+*  Method: rxPayloadView()
+*  @ Since v0.1.2, October 2026
+*  @ Returns a view of the payload of a ZigBee RX packet (Starting at Frame Index 12), or an empty view 
+*    if the packet is not a ZigBee RX packet or has no payload.
+*/
+SimpleZigBeeView SimpleIncomingZigBeePacket::rxPayloadView(){
+	return payloadView( SimpleZigBeeRxLayout::FRAME_TYPE, SimpleZigBeeRxLayout::PAYLOAD_INDEX );
 }
 
 /*//////////////////////////////////////////////////////////////////////
@@ -477,9 +721,13 @@ uint8_t SimpleIncomingZigBeePacket::getRXPayload(int index){
 *  @ Since v0.1.0 by Eric Burger, January 2014
 *  @ Returns the 16-bit source address of packet (destination of TX request)
 *  @ Cast bytes as 16-bit before bitshift left 
+*  @ Last Modified v0.1.2 by Eric Burger, October 2026
+*  @ Changlog for v0.1.2:
+*       - Fixed address, which was read from the wrong bytes (Frame Index 2 and 3)
 */
 SimpleZigBeeAddress16 SimpleIncomingZigBeePacket::getTXStatusAddress16(){
-	uint16_t addr = (uint16_t(getFrameData(9)) << 2) + getFrameData(3);
+	int i = SimpleZigBeeTxStatusLayout::ADDRESS16_INDEX;
+	uint16_t addr = (uint16_t(getFrameData(i)) << 8) + getFrameData(i+1);
 	return SimpleZigBeeAddress16( addr );
 }
 
@@ -489,7 +737,7 @@ SimpleZigBeeAddress16 SimpleIncomingZigBeePacket::getTXStatusAddress16(){
 *  @ Returns value of retry count (Packet Index 7, Frame Index 4)
 */
 uint8_t SimpleIncomingZigBeePacket::getTXStatusRetryCount(){
-	return getFrameData(4);
+	return getFrameData( SimpleZigBeeTxStatusLayout::RETRY_COUNT_INDEX );
 }
 
 /**
@@ -498,7 +746,7 @@ uint8_t SimpleIncomingZigBeePacket::getTXStatusRetryCount(){
 *  @ Returns value of packet delivery status (Packet Index 8, Frame Index 5)
 */
 uint8_t SimpleIncomingZigBeePacket::getTXStatusDeliveryStatus(){
-	return getFrameData(5);
+	return getFrameData( SimpleZigBeeTxStatusLayout::DELIVERY_STATUS_INDEX );
 }
 
 /**
@@ -507,7 +755,7 @@ uint8_t SimpleIncomingZigBeePacket::getTXStatusDeliveryStatus(){
 *  @ Returns value of packet discovery status (Packet Index 9, Frame Index 6)
 */
 uint8_t SimpleIncomingZigBeePacket::getTXStatusDiscoveryStatus(){
-	return getFrameData(6);
+	return getFrameData( SimpleZigBeeTxStatusLayout::DISCOVERY_STATUS_INDEX );
 }
 
 /*//////////////////////////////////////////////////////////////////////
@@ -520,7 +768,8 @@ uint8_t SimpleIncomingZigBeePacket::getTXStatusDiscoveryStatus(){
 *  @ Returns AT Command of packet (Packet index 5 and 6, Frame Index 2 and 3)
 */
 uint16_t SimpleIncomingZigBeePacket::getATResponseCommand(){
-	return uint16_t( getFrameData(2) << 8 )  + getFrameData(3) ;
+	int i = SimpleZigBeeAtResponseLayout::COMMAND_INDEX;
+	return uint16_t( getFrameData(i) << 8 )  + getFrameData(i+1) ;
 }
 
 /**
@@ -529,7 +778,7 @@ uint16_t SimpleIncomingZigBeePacket::getATResponseCommand(){
 *  @ Returns AT Command Status (Packet index 7, Frame Index 4)
 */
 uint8_t SimpleIncomingZigBeePacket::getATResponseStatus(){
-	return getFrameData(4) ;
+	return getFrameData( SimpleZigBeeAtResponseLayout::STATUS_INDEX ) ;
 }
 
 /**
@@ -538,7 +787,7 @@ uint8_t SimpleIncomingZigBeePacket::getATResponseStatus(){
 *  @ Returns AT Command Data Length
 */
 uint8_t SimpleIncomingZigBeePacket::getATResponsePayloadLength(){
-	return getFrameLength()-5;
+	return getFrameLength() - SimpleZigBeeAtResponseLayout::PAYLOAD_INDEX;
 }
 
 /**
@@ -547,7 +796,7 @@ uint8_t SimpleIncomingZigBeePacket::getATResponsePayloadLength(){
 *  @ Returns AT Command Data (Packet index 8, Frame Index 5)
 */
 uint8_t SimpleIncomingZigBeePacket::getATResponsePayload(){
-	return getFrameData(5);
+	return getFrameData( SimpleZigBeeAtResponseLayout::PAYLOAD_INDEX );
 }
 
 /**
@@ -557,7 +806,17 @@ uint8_t SimpleIncomingZigBeePacket::getATResponsePayload(){
 *  @ param int index: Index of command data
 */
 uint8_t SimpleIncomingZigBeePacket::getATResponsePayload(int index){
-	return getFrameData(index+5);
+	return getFrameData( index + SimpleZigBeeAtResponseLayout::PAYLOAD_INDEX );
+}
+
+/**
+*  Method: atResponsePayloadView()
+*  @ Since v0.1.2, October 2026
+*  @ Returns a view of the AT Command Data (Starting at Frame Index 5), or an empty view 
+*    if the packet is not an AT Command Response or has no command data.
+*/
+SimpleZigBeeView SimpleIncomingZigBeePacket::atResponsePayloadView(){
+	return payloadView( SimpleZigBeeAtResponseLayout::FRAME_TYPE, SimpleZigBeeAtResponseLayout::PAYLOAD_INDEX );
 }
 
 /*//////////////////////////////////////////////////////////////////////
@@ -579,8 +838,9 @@ SimpleZigBeeAddress SimpleIncomingZigBeePacket::getRemoteATResponseAddress(){
 *  @ Returns the 64-bit source (remote) address of packet
 */
 SimpleZigBeeAddress64 SimpleIncomingZigBeePacket::getRemoteATResponseAddress64(){
-	uint32_t msb = (uint32_t(getFrameData(2)) << 24) + (uint32_t(getFrameData(3)) << 16) + (uint16_t(getFrameData(4)) << 8) + getFrameData(5);
-	uint32_t lsb = (uint32_t(getFrameData(6)) << 24) + (uint32_t(getFrameData(7)) << 16) + (uint16_t(getFrameData(8)) << 8) + getFrameData(9);
+	int i = SimpleZigBeeRemoteAtResponseLayout::ADDRESS64_INDEX;
+	uint32_t msb = (uint32_t(getFrameData(i)) << 24) + (uint32_t(getFrameData(i+1)) << 16) + (uint16_t(getFrameData(i+2)) << 8) + getFrameData(i+3);
+	uint32_t lsb = (uint32_t(getFrameData(i+4)) << 24) + (uint32_t(getFrameData(i+5)) << 16) + (uint16_t(getFrameData(i+6)) << 8) + getFrameData(i+7);
 	return SimpleZigBeeAddress64( msb, lsb );
 }
 
@@ -590,7 +850,8 @@ SimpleZigBeeAddress64 SimpleIncomingZigBeePacket::getRemoteATResponseAddress64()
 *  @ Returns the 16-bit source (remote) address of packet
 */
 SimpleZigBeeAddress16 SimpleIncomingZigBeePacket::getRemoteATResponseAddress16(){
-	uint16_t addr = (uint16_t(getFrameData(10)) << 8) + getFrameData(11);
+	int i = SimpleZigBeeRemoteAtResponseLayout::ADDRESS16_INDEX;
+	uint16_t addr = (uint16_t(getFrameData(i)) << 8) + getFrameData(i+1);
 	return SimpleZigBeeAddress16( addr );
 }
 
@@ -600,7 +861,8 @@ SimpleZigBeeAddress16 SimpleIncomingZigBeePacket::getRemoteATResponseAddress16()
 *  @ Returns Remote AT Command of packet (Packet index 15 and 16, Frame Index 12 and 13)
 */
 uint16_t SimpleIncomingZigBeePacket::getRemoteATResponseCommand(){
-	return uint16_t( getFrameData(12) << 8 )  + getFrameData(13) ;
+	int i = SimpleZigBeeRemoteAtResponseLayout::COMMAND_INDEX;
+	return uint16_t( getFrameData(i) << 8 )  + getFrameData(i+1) ;
 }
 
 /**
@@ -609,7 +871,7 @@ uint16_t SimpleIncomingZigBeePacket::getRemoteATResponseCommand(){
 *  @ Returns Remote AT Command Status (Packet index 17, Frame Index 14)
 */
 uint8_t SimpleIncomingZigBeePacket::getRemoteATResponseStatus(){
-	return getFrameData(14) ;
+	return getFrameData( SimpleZigBeeRemoteAtResponseLayout::STATUS_INDEX ) ;
 }
 
 /**
@@ -618,7 +880,7 @@ uint8_t SimpleIncomingZigBeePacket::getRemoteATResponseStatus(){
 *  @ Returns Remote AT Command Data Length
 */
 uint8_t SimpleIncomingZigBeePacket::getRemoteATResponsePayloadLength(){
-	return getFrameLength()-15;
+	return getFrameLength() - SimpleZigBeeRemoteAtResponseLayout::PAYLOAD_INDEX;
 }
 
 /**
@@ -627,7 +889,7 @@ uint8_t SimpleIncomingZigBeePacket::getRemoteATResponsePayloadLength(){
 *  @ Returns Remote AT Command Data (Packet index 18, Frame Index 15)
 */
 uint8_t SimpleIncomingZigBeePacket::getRemoteATResponsePayload(){
-	return getFrameData(15);
+	return getFrameData( SimpleZigBeeRemoteAtResponseLayout::PAYLOAD_INDEX );
 }
 
 /**
@@ -637,7 +899,17 @@ uint8_t SimpleIncomingZigBeePacket::getRemoteATResponsePayload(){
 *  @ param int index: Index of command data
 */
 uint8_t SimpleIncomingZigBeePacket::getRemoteATResponsePayload(int index){
-	return getFrameData(index+15);
+	return getFrameData( index + SimpleZigBeeRemoteAtResponseLayout::PAYLOAD_INDEX );
+}
+
+/**
+*  Method: remoteATResponsePayloadView()
+*  @ Since v0.1.2, October 2026
+*  @ Returns a view of the Remote AT Command Data (Starting at Frame Index 15), or an empty view 
+*    if the packet is not a Remote AT Command Response or has no command data.
+*/
+SimpleZigBeeView SimpleIncomingZigBeePacket::remoteATResponsePayloadView(){
+	return payloadView( SimpleZigBeeRemoteAtResponseLayout::FRAME_TYPE, SimpleZigBeeRemoteAtResponseLayout::PAYLOAD_INDEX );
 }
 
 /*//////////////////////////////////////////////////////////////////////
@@ -650,7 +922,28 @@ uint8_t SimpleIncomingZigBeePacket::getRemoteATResponsePayload(int index){
 *  @ Returns value of packet modem status (Packet Index 4, Frame Index 1)
 */
 uint8_t SimpleIncomingZigBeePacket::getModemStatus(){
-	return getFrameData(1);
+	return getFrameData( SimpleZigBeeModemStatusLayout::STATUS_INDEX );
+}
+
+/*//////////////////////////////////////////////////////////////////////
+											VIEW METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: payloadView(uint8_t frameType, int payloadIndex)
+*  @ Since v0.1.2, October 2026
+*  @ Checks the frame type and frame length once and returns a view of the frame data from payloadIndex
+*    to the end of the frame. Returns an empty view if the packet has a different frame type or if there 
+*    is no data after payloadIndex.
+*  @ param uint8_t frameType: Expected frame type
+*  @ param int payloadIndex: Frame index of the first byte of the payload
+*/
+SimpleZigBeeView SimpleIncomingZigBeePacket::payloadView(uint8_t frameType, int payloadIndex){
+	SimpleZigBeeView frame = frameView();
+	if( frame.getLength() <= payloadIndex || frameType != frame[0] ){
+		return SimpleZigBeeView();
+	}
+	return SimpleZigBeeView( frame.getData() + payloadIndex, frame.getLength() - payloadIndex );
 }
 
 /*//////////////////////////////////////////////////////////////////////
@@ -682,6 +975,25 @@ SimpleOutgoingZigBeePacket::SimpleOutgoingZigBeePacket(int maxFrameLength) : Sim
 	SimpleZigBeePacket::init();
 }
 
+/**
+*  Constructor: SimpleOutgoingZigBeePacket(SimpleZigBeeBufferPool & pool)
+*  @ Since v0.1.2, October 2026
+*  @ Constructor that takes a block from the pool as the memory array (see SimpleZigBeePacket(SimpleZigBeeBufferPool & pool)).
+*  @ param SimpleZigBeeBufferPool & pool: Pool of blocks
+*/
+SimpleOutgoingZigBeePacket::SimpleOutgoingZigBeePacket(SimpleZigBeeBufferPool & pool) : SimpleZigBeePacket(pool) {
+}
+
+/**
+*  Constructor: SimpleOutgoingZigBeePacket(uint8_t* memoryArray, int maxFrameLength)
+*  @ Since v0.1.2, October 2026
+*  @ Protected constructor for packets that provide their own memory array (see SimpleZigBeePacketT).
+*  @ param uint8_t* memoryArray: Array of maxFrameLength bytes used to store the frame data
+*  @ param int maxFrameLength: Limit to the length (# of bytes) of the packet frame
+*/
+SimpleOutgoingZigBeePacket::SimpleOutgoingZigBeePacket(uint8_t* memoryArray, int maxFrameLength) : SimpleZigBeePacket(memoryArray, maxFrameLength) {
+}
+
 /*//////////////////////////////////////////////////////////////////////
 										GENERAL PACKET METHODS
 /*//////////////////////////////////////////////////////////////////////
@@ -704,7 +1016,7 @@ void SimpleOutgoingZigBeePacket::setFrameType(uint8_t frameType){
 *  @ param uint8_t id: Frame ID value to store 
 */
 void SimpleOutgoingZigBeePacket::setFrameID(uint8_t id){
-	setFrameData(1, id);
+	setFrameData(FRAME_ID_INDEX - FRAME_TYPE_INDEX, id);
 }
 
 /**
@@ -741,7 +1053,7 @@ void SimpleOutgoingZigBeePacket::setAddress(uint32_t adr64MSB, uint32_t adr64LSB
 *  @ param uint32_t adr64LSB: Least significant bytes (2nd half) of 64-bit address 
 */
 void SimpleOutgoingZigBeePacket::setAddress64(uint32_t adr64MSB, uint32_t adr64LSB){
-	uint8_t startIndex = 2; // Frame data index marking start of 64-bit address.
+	uint8_t startIndex = SimpleZigBeeTxRequestLayout::ADDRESS64_INDEX; // Frame data index marking start of 64-bit address.
 	for(uint8_t i=0;i<4;i++){
 		uint8_t by = (8*(3-i));
 		uint8_t byte1 = (adr64MSB >> by) & 0xff;
@@ -758,8 +1070,8 @@ void SimpleOutgoingZigBeePacket::setAddress64(uint32_t adr64MSB, uint32_t adr64L
 *  @ param uint16_t adr16:  16-bit destination address  
 */
 void SimpleOutgoingZigBeePacket::setAddress16(uint16_t adr16){
-	setFrameData( 10, ((adr16 >> 8) & 0xff) );
-	setFrameData( 11, (adr16 & 0xff) );
+	setFrameData( SimpleZigBeeTxRequestLayout::ADDRESS16_INDEX, ((adr16 >> 8) & 0xff) );
+	setFrameData( SimpleZigBeeTxRequestLayout::ADDRESS16_INDEX + 1, (adr16 & 0xff) );
 }
 
 /*//////////////////////////////////////////////////////////////////////
@@ -773,7 +1085,7 @@ void SimpleOutgoingZigBeePacket::setAddress16(uint16_t adr16){
 *  @ param uint8_t rad: Maximum radius (# of hops) of packets, 0 for no limit
 */
 void SimpleOutgoingZigBeePacket::setTXRequestBroadcastRadius(uint8_t rad){
-	setFrameData( 12, rad );
+	setFrameData( SimpleZigBeeTxRequestLayout::RADIUS_INDEX, rad );
 }
 
 /**
@@ -783,7 +1095,7 @@ void SimpleOutgoingZigBeePacket::setTXRequestBroadcastRadius(uint8_t rad){
 *  @ param uint8_t opt: Option value to set 
 */
 void SimpleOutgoingZigBeePacket::setTXRequestOption(uint8_t opt){
-	setFrameData( 13, opt );
+	setFrameData( SimpleZigBeeTxRequestLayout::OPTIONS_INDEX, opt );
 }
 
 /**
@@ -794,7 +1106,7 @@ void SimpleOutgoingZigBeePacket::setTXRequestOption(uint8_t opt){
 *  @ param int payloadSize: Length of payload array
 */
 void SimpleOutgoingZigBeePacket::setTXRequestPayload(uint8_t* payload, int payloadSize){
-	setFrameData( 14, payload, payloadSize );
+	setFrameData( SimpleZigBeeTxRequestLayout::PAYLOAD_INDEX, payload, payloadSize );
 }
 
 /*//////////////////////////////////////////////////////////////////////
@@ -808,8 +1120,8 @@ void SimpleOutgoingZigBeePacket::setTXRequestPayload(uint8_t* payload, int paylo
 *  @ param uint16_t command: 16-bit AT Command
 */
 void SimpleOutgoingZigBeePacket::setATCommand(uint16_t command){
-	setFrameData( 2, ((command >> 8) & 0xff) );
-	setFrameData( 3, (command & 0xff) );
+	setFrameData( SimpleZigBeeAtCommandLayout::COMMAND_INDEX, ((command >> 8) & 0xff) );
+	setFrameData( SimpleZigBeeAtCommandLayout::COMMAND_INDEX + 1, (command & 0xff) );
 }
 
 /**
@@ -819,7 +1131,7 @@ void SimpleOutgoingZigBeePacket::setATCommand(uint16_t command){
 *  @ param uint8_t payload: Byte containing payload
 */
 void SimpleOutgoingZigBeePacket::setATCommandPayload(uint8_t payload){
-	setFrameData( 4, payload );
+	setFrameData( SimpleZigBeeAtCommandLayout::PAYLOAD_INDEX, payload );
 }
 
 /**
@@ -830,7 +1142,7 @@ void SimpleOutgoingZigBeePacket::setATCommandPayload(uint8_t payload){
 *  @ param int payloadSize: Length of payload array
 */
 void SimpleOutgoingZigBeePacket::setATCommandPayload(uint8_t* payload, int payloadSize){
-	setFrameData( 4, payload, payloadSize );
+	setFrameData( SimpleZigBeeAtCommandLayout::PAYLOAD_INDEX, payload, payloadSize );
 }
 
 /*//////////////////////////////////////////////////////////////////////
@@ -843,7 +1155,7 @@ void SimpleOutgoingZigBeePacket::setATCommandPayload(uint8_t* payload, int paylo
 *  @ param uint8_t opt: Option value to set 
 */
 void SimpleOutgoingZigBeePacket::setRemoteATCommandOption(uint8_t opt){
-	setFrameData( 12, opt );
+	setFrameData( SimpleZigBeeRemoteAtCommandLayout::OPTIONS_INDEX, opt );
 }
 /**
 *  Method: setRemoteATCommand(uint16_t command)
@@ -852,8 +1164,8 @@ void SimpleOutgoingZigBeePacket::setRemoteATCommandOption(uint8_t opt){
 *  @ param uint16_t command: 16-bit AT Command
 */
 void SimpleOutgoingZigBeePacket::setRemoteATCommand(uint16_t command){
-	setFrameData( 13, ((command >> 8) & 0xff) );
-	setFrameData( 14, (command & 0xff) );
+	setFrameData( SimpleZigBeeRemoteAtCommandLayout::COMMAND_INDEX, ((command >> 8) & 0xff) );
+	setFrameData( SimpleZigBeeRemoteAtCommandLayout::COMMAND_INDEX + 1, (command & 0xff) );
 }
 
 /**
@@ -863,7 +1175,7 @@ void SimpleOutgoingZigBeePacket::setRemoteATCommand(uint16_t command){
 *  @ param uint8_t payload: Byte containing payload
 */
 void SimpleOutgoingZigBeePacket::setRemoteATCommandPayload(uint8_t payload){
-	setFrameData( 15, payload );
+	setFrameData( SimpleZigBeeRemoteAtCommandLayout::PAYLOAD_INDEX, payload );
 }
 
 /**
@@ -874,6 +1186,6 @@ void SimpleOutgoingZigBeePacket::setRemoteATCommandPayload(uint8_t payload){
 *  @ param int payloadSize: Length of payload array
 */
 void SimpleOutgoingZigBeePacket::setRemoteATCommandPayload(uint8_t* payload, int payloadSize){
-	setFrameData( 15, payload, payloadSize );
+	setFrameData( SimpleZigBeeRemoteAtCommandLayout::PAYLOAD_INDEX, payload, payloadSize );
 }
 
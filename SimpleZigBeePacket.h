@@ -43,6 +43,11 @@
 #define XON 0x11
 #define XOFF 0x13
 
+// Default maximum frame length of packets (see SimpleZigBeePacket::_maxFrameLength)
+#ifndef SIMPLE_ZIGBEE_MAX_FRAME_LENGTH
+#define SIMPLE_ZIGBEE_MAX_FRAME_LENGTH 50
+#endif
+
 // Error Codes
 #define NO_ERROR 0
 #define ERROR_REALLOCATING_MEMORY 1
@@ -52,6 +57,10 @@
 #define MAX_FRAME_LENGTH_EXCEEDED 4
 #define FRAME_LENGTH_EXCEEDED 5
 #define CHECKSUM_FAILURE 6
+// The frame type of an incoming packet is not one that the XBee sends. Only applies to radios in API Mode (ATAP=1).
+#define INVALID_FRAME_TYPE 7
+// The frame length of an incoming packet is too short for its frame type (or is 0).
+#define INVALID_FRAME_LENGTH 8
 
 // Frame Indexes
 #define MSB_INDEX 1
@@ -77,6 +86,7 @@
 #define ZIGBEE_TRANSMIT_REQUEST 0x10 // #
 #define ZIGBEE_EXPLICIT_ADDRESSING_COMMAND_FRAME 0x11
 #define REMOTE_AT_COMMAND 0x17 // #
+#define CREATE_SOURCE_ROUTE 0x21
 #define AT_COMMAND_RESPONSE 0x88 // #
 #define MODEM_STATUS 0x8a // #
 #define ZIGBEE_TX_STATUS 0x8b // #
@@ -85,6 +95,10 @@
 #define ZIGBEE_IO_RX_INDICATOR 0x92
 #define NODE_INDENTIFICATION_INDICATOR 0x95
 #define REMOTE_AT_COMMAND_RESPONSE 0x97 // #
+#define XBEE_SENSOR_READ_INDICATOR 0x94
+#define OTA_FIRMWARE_UPDATE_STATUS 0xa0
+#define ROUTE_RECORD_INDICATOR 0xa1
+#define MANY_TO_ONE_ROUTE_REQUEST_INDICATOR 0xa3
 
 // AT COMMANDS, 0x08
 // REMOTE AT COMMANDS, 0x17 (INCOMPLETE LIST)
@@ -118,18 +132,64 @@
 
 
 
+// Pool of fixed size blocks that packets can use as memory arrays (see SimpleZigBeeBufferPool.h)
+class SimpleZigBeeBufferPool;
+
+/**
+* Class: SimpleZigBeeView
+* @ Since v0.1.2, October 2026
+* @ Read-only pointer and length of a block of bytes stored in a packet (for example, the payload 
+*   of a ZigBee RX packet). The bounds are checked once when the view is created, so the bytes can 
+*   be read in place without copying them and without a method call for each byte. An empty view 
+*   (length 0) is returned if the requested block is not available. A view is only valid until the 
+*   packet it points into is changed.
+*/
+class SimpleZigBeeView {
+public:
+	SimpleZigBeeView() : _data(NULL), _length(0) {}
+	SimpleZigBeeView(const uint8_t* data, int length) : _data(data), _length(length) {}
+	
+	// Pointer to the first byte (NULL if empty)
+	const uint8_t* getData() const { return _data; }
+	// Number of bytes
+	int getLength() const { return _length; }
+	bool isEmpty() const { return 0 == _length; }
+	// Returns the byte at the index. The index is not checked, so use 0 <= index < getLength().
+	uint8_t operator[](int index) const { return _data[index]; }
+	// Allow the view to be used in a range-based for loop
+	const uint8_t* begin() const { return _data; }
+	const uint8_t* end() const { return _data + _length; }
+
+private:
+	const uint8_t* _data;
+	int _length;
+};
+
+
 /**
 * Class: SimpleZigBeePacket
 * @ Since v0.1.0 by Eric Burger, August 2013
 * @ Object for incoming and outgoing packets.
+* @ Last Modified v0.1.2 by Eric Burger, October 2026
+* @ Changlog for v0.1.2:
+*    - Added getFrameDataPointer() and frameView() for reading the frame data without copying it
+*    - Added a constructor for packets that store the frame data in a fixed array (see SimpleZigBeePacketT)
+*    - Packets can be moved (the memory array is handed over) but only copied with copyFrom(). 
+*      The memory array is freed when the packet is destroyed.
+*    - Added a constructor for packets that store the frame data in a block of a SimpleZigBeeBufferPool
 */
 class SimpleZigBeePacket {
 public:
 	// INITIALIZATION METHODS //
 	SimpleZigBeePacket();
 	SimpleZigBeePacket(int maxFrameLength);
+	SimpleZigBeePacket(SimpleZigBeeBufferPool & pool);
+	SimpleZigBeePacket(SimpleZigBeePacket && packet);
+	SimpleZigBeePacket & operator=(SimpleZigBeePacket && packet);
+	~SimpleZigBeePacket();
 	void init();  
 	void reset();
+	void copyFrom(const SimpleZigBeePacket & packet);
 	
 	// MEMORY METHODS //
 	void expandMemoryArray(int size);
@@ -153,16 +213,27 @@ public:
 	// PACKET FRAME METHODS //
 	int getMaxFrameLength();
 	void setFrameData(int index, uint8_t byte);
-	void setFrameData(int startIndex, uint8_t* frameData, int frameDataLength);
+	void setFrameData(int startIndex, const uint8_t* frameData, int frameDataLength);
 	uint8_t getFrameData(int index);
 	void getFrameData(int startIndex, uint8_t* arrayPtr, int frameDataLength);
+	const uint8_t* getFrameDataPointer();
+	const uint8_t* getFrameDataPointer(int startIndex, int frameDataLength);
+	SimpleZigBeeView frameView();
 
 	// ERROR CODE METHODS //
 	bool isError();
 	int getErrorCode();
 	void setErrorCode(int errorCode); 
 
+protected:
+	SimpleZigBeePacket(uint8_t* memoryArray, int maxFrameLength);
+
 private:
+	// Packets are not copied implicitly, since a copy must allocate its own memory array (use copyFrom()).
+	SimpleZigBeePacket(const SimpleZigBeePacket &) = delete;
+	SimpleZigBeePacket & operator=(const SimpleZigBeePacket &) = delete;
+	
+
 	// Current length of memory array
 	int _memoryArrayLength;
 	// Maximum length of packet frame (also defines maximum length of memory array).
@@ -171,11 +242,15 @@ private:
 	// is 64 bytes (http://arduino.cc/en/Serial/Available). For this reason, a frame limit around 50 bytes
 	// is recommended. Incoming packets that exceed the _maxFrameLength will not be parsed. While it is 
 	// possible to receive packets larger than 64 bytes by reading from the serial port as bytes are being
-	// received, failure to do so will result in incomplete packets. To support Arduino to Arduino 
-	// communication, the length of outgoing packets is also restricted by _maxFrameLength. 
+	// received, failure to do so will result in incomplete packets (see SimpleZigBeeRadio::setAsyncReceive(),
+	// which reads them in an interrupt or thread). To support Arduino to Arduino communication, the length of outgoing packets is also restricted by _maxFrameLength. 
 	int _maxFrameLength;
-	// Memory array used to store frame data
+	// Memory array used to store frame data (either allocated with malloc or a fixed array, see SimpleZigBeePacketT)
 	uint8_t *_ptrMemoryArray;
+	// True if the memory array was allocated with malloc or taken from a pool (and must be freed or released by the packet)
+	bool _ownsMemoryArray;
+	// Pool that the memory array was taken from (NULL if not from a pool)
+	SimpleZigBeeBufferPool *_pool;
 	
 	// Packet checksum (End of packet)
 	uint8_t _checksum;
@@ -190,12 +265,16 @@ private:
 * Class: SimpleIncomingZigBeePacket
 * @ Since v0.1.0 by Eric Burger, August 2013
 * @ Object for incoming packets.
+* @ Last Modified v0.1.2 by Eric Burger, October 2026
+* @ Changlog for v0.1.2:
+*    - Added rxPayloadView(), atResponsePayloadView() and remoteATResponsePayloadView()
 */
 class SimpleIncomingZigBeePacket : public SimpleZigBeePacket {
 public:
 	// INITIALIZATION METHODS //
 	SimpleIncomingZigBeePacket();
 	SimpleIncomingZigBeePacket(int maxFrameLength);
+	SimpleIncomingZigBeePacket(SimpleZigBeeBufferPool & pool);
 	
 	// ZIGBEE RECIEVED (RX) PACKET METHODS //
 	// No Frame ID
@@ -205,6 +284,7 @@ public:
 	uint8_t getRXOptions();
 	uint8_t getRXPayloadLength();
 	uint8_t getRXPayload(int index);
+	SimpleZigBeeView rxPayloadView();
 	
 	// ZIGBEE TRANSMIT (TX) STATUS METHODS //
 	// For Frame ID, use getFrameID()
@@ -220,6 +300,7 @@ public:
 	uint8_t getATResponsePayloadLength();
 	uint8_t getATResponsePayload();
 	uint8_t getATResponsePayload(int index);
+	SimpleZigBeeView atResponsePayloadView();
 	
 	// REMOTE AT COMMAND RESPONSE METHODS //
 	// For Frame ID, use getFrameID()
@@ -231,14 +312,21 @@ public:
 	uint8_t getRemoteATResponsePayloadLength();
 	uint8_t getRemoteATResponsePayload();
 	uint8_t getRemoteATResponsePayload(int index);
+	SimpleZigBeeView remoteATResponsePayloadView();
 	
 	// MODEM STATUS METHODS //
 	uint8_t getModemStatus();
+
+protected:
+	SimpleIncomingZigBeePacket(uint8_t* memoryArray, int maxFrameLength);
+
+private:
+	SimpleZigBeeView payloadView(uint8_t frameType, int payloadIndex);
 };
 
 
 /**
-* Class: SimpleZigBeePacket
+* Class: SimpleOutgoingZigBeePacket
 * @ Since v0.1.0 by Eric Burger, August 2013
 * @ Object for outgoing packets.
 */
@@ -247,6 +335,7 @@ public:
 	// INITIALIZATION METHODS //
 	SimpleOutgoingZigBeePacket();
 	SimpleOutgoingZigBeePacket(int maxFrameLength); 
+	SimpleOutgoingZigBeePacket(SimpleZigBeeBufferPool & pool);
 
 	// GENERAL PACKET METHODS //
 	void setFrameType(uint8_t frameType);
@@ -275,6 +364,60 @@ public:
 	void setRemoteATCommandPayload(uint8_t payload);
 	void setRemoteATCommandPayload(uint8_t* payload, int payloadSize);
 
+protected:
+	SimpleOutgoingZigBeePacket(uint8_t* memoryArray, int maxFrameLength);
+};
+
+
+/**
+* Class: SimpleZigBeePacketT
+* @ Since v0.1.2, October 2026
+* @ Packet that holds its own array of MaxFrameLength bytes for the frame data, so the packet never
+*   allocates memory (no malloc or realloc) and its size is known when the program is compiled. 
+*   Packet is the class with the methods needed (SimpleZigBeePacket, SimpleIncomingZigBeePacket or 
+*   SimpleOutgoingZigBeePacket). For example, "SimpleIncomingZigBeePacketT<50> packet;" uses about 
+*   60 bytes of RAM and can be used wherever a SimpleIncomingZigBeePacket is expected.
+*   Like other packets, it is only copied with copyFrom(). Since the array cannot be handed over, 
+*   moving the packet copies the frame data into the array of the new packet.
+*/
+template<int MaxFrameLength, class Packet = SimpleZigBeePacket>
+class SimpleZigBeePacketT : public Packet {
+public:
+	SimpleZigBeePacketT() : Packet(_frame_storage, MaxFrameLength) {}
+	SimpleZigBeePacketT(SimpleZigBeePacketT && packet) : Packet(_frame_storage, MaxFrameLength) {
+		this->copyFrom( packet );
+	}
+	SimpleZigBeePacketT & operator=(SimpleZigBeePacketT && packet){
+		this->copyFrom( packet );
+		return *this;
+	}
+	
+private:
+	static_assert( MaxFrameLength > 0, "MaxFrameLength must be at least 1" );
+	uint8_t _frame_storage[MaxFrameLength];
+};
+
+// Incoming and outgoing packets with fixed arrays (for example, SimpleOutgoingZigBeePacketT<80>)
+template<int MaxFrameLength>
+using SimpleIncomingZigBeePacketT = SimpleZigBeePacketT<MaxFrameLength, SimpleIncomingZigBeePacket>;
+template<int MaxFrameLength>
+using SimpleOutgoingZigBeePacketT = SimpleZigBeePacketT<MaxFrameLength, SimpleOutgoingZigBeePacket>;
+
+/**
+* Class: SimpleZigBeePacketRef
+* @ Since v0.1.2, October 2026
+* @ Packet that uses frame data stored somewhere else (for example, in a frame queue) as its array, so a 
+*   stored frame can be handled as a packet without copying it. The frame data must stay in place while
+*   the packet is used, and the packet cannot grow beyond frameLength bytes.
+*   For example, "SimpleZigBeePacketRef<SimpleIncomingZigBeePacket> packet( frameData, frameLength );"
+*/
+template<class Packet = SimpleZigBeePacket>
+class SimpleZigBeePacketRef : public Packet {
+public:
+	SimpleZigBeePacketRef(uint8_t* frameData, int frameLength) : Packet(frameData, frameLength) {
+		this->setFrameLength( frameLength );
+		this->setChecksum( this->calculateChecksum() );
+	}
 };
 
 
@@ -0,0 +1,200 @@
+/**
+* Copyright (c) 2013 Eric Burger. All rights reserved.
+*/
+
+#include "SimpleZigBeePayloadSink.h"
+
+/*//////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////
+									SimpleZigBeePayloadSink Class
+////////////////////////////////////////////////////////////////////////
+/*//////////////////////////////////////////////////////////////////////
+
+/*//////////////////////////////////////////////////////////////////////
+									INITIALIZATION METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Constructor: SimpleZigBeePayloadSink(SimpleZigBeePayloadCallback callback)
+*  @ Since v0.1.2, October 2026
+*  @ Creates a sink that passes each chunk of the payload to a function.
+*  @ param SimpleZigBeePayloadCallback callback: Function to call with each chunk and at the end of each packet
+*/
+SimpleZigBeePayloadSink::SimpleZigBeePayloadSink(SimpleZigBeePayloadCallback callback){
+	_callback = callback;
+	_buffer = NULL;
+	_size = 0;
+	_length = 0;
+	_receiving = false;
+	_valid = false;
+	_overflow = false;
+	resetCounters();
+}
+
+/**
+*  Constructor: SimpleZigBeePayloadSink(uint8_t* buffer, int size, SimpleZigBeePayloadCallback callback)
+*  @ Since v0.1.2, October 2026
+*  @ Creates a sink that copies the payload to a buffer.
+*  @ param uint8_t* buffer: Array of size bytes
+*  @ param int size: Largest payload that can be stored
+*  @ param SimpleZigBeePayloadCallback callback: Function to call at the end of each packet (or NULL)
+*/
+SimpleZigBeePayloadSink::SimpleZigBeePayloadSink(uint8_t* buffer, int size, SimpleZigBeePayloadCallback callback){
+	_callback = callback;
+	_buffer = buffer;
+	_size = size;
+	_length = 0;
+	_receiving = false;
+	_valid = false;
+	_overflow = false;
+	resetCounters();
+}
+
+/*//////////////////////////////////////////////////////////////////////
+									STREAM METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: begin(SimpleIncomingZigBeePacket & packet)
+*  @ Since v0.1.2, October 2026
+*  @ Called by the radio once the RX header of a streamed packet has been received. Without a buffer, the
+*    callback (if set) is called with a length of 0 and data that is not NULL, so that it can read the 
+*    RX header and get ready for the chunks that follow.
+*  @ param SimpleIncomingZigBeePacket & packet: Incoming packet holding the RX header
+*/
+void SimpleZigBeePayloadSink::begin(SimpleIncomingZigBeePacket & packet){
+	// Passed to the callback at the start of a packet (only the address is used, never the value)
+	static const uint8_t beginMarker = 0;
+	_length = 0;
+	_receiving = true;
+	_valid = false;
+	_overflow = false;
+	if( NULL == _buffer && NULL != _callback ){
+		_callback( packet, &beginMarker, 0 );
+	}
+}
+
+/**
+*  Method: write(SimpleIncomingZigBeePacket & packet, const uint8_t* data, int length)
+*  @ Since v0.1.2, October 2026
+*  @ Called by the radio with the next chunk of the payload. The chunk is copied to the buffer (if set) 
+*    or passed to the callback.
+*  @ param SimpleIncomingZigBeePacket & packet: Incoming packet holding the RX header
+*  @ param const uint8_t* data: Pointer to the payload bytes
+*  @ param int length: Number of payload bytes
+*/
+void SimpleZigBeePayloadSink::write(SimpleIncomingZigBeePacket & packet, const uint8_t* data, int length){
+	if( NULL != _buffer ){
+		int count = length;
+		if( count > _size - _length ){
+			count = _size - _length;
+			_overflow = true;
+		}
+		memcpy( _buffer + _length, data, count );
+		_length += count;
+		return;
+	}
+	_length += length;
+	if( NULL != _callback ){
+		_callback( packet, data, length );
+	}
+}
+
+/**
+*  Method: end(SimpleIncomingZigBeePacket & packet)
+*  @ Since v0.1.2, October 2026
+*  @ Called by the radio when a streamed packet ends, with the verdict in packet.getErrorCode(). If the 
+*    buffer was too small, the error code is changed to MAX_FRAME_LENGTH_EXCEEDED. Then the callback 
+*    (if set) is called with NULL data and a length of 0.
+*  @ param SimpleIncomingZigBeePacket & packet: Incoming packet holding the RX header
+*/
+void SimpleZigBeePayloadSink::end(SimpleIncomingZigBeePacket & packet){
+	if( true == _overflow && !packet.isError() ){
+		packet.setErrorCode( MAX_FRAME_LENGTH_EXCEEDED );
+	}
+	_receiving = false;
+	_valid = !packet.isError();
+	if( true == _valid ){
+		_frameCount++;
+	}else{
+		_failCount++;
+	}
+	if( NULL != _callback ){
+		_callback( packet, NULL, 0 );
+	}
+}
+
+/*//////////////////////////////////////////////////////////////////////
+									RESULT METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: isReceiving()
+*  @ Since v0.1.2, October 2026
+*  @ Returns true while the payload of a packet is being received.
+*/
+bool SimpleZigBeePayloadSink::isReceiving(){
+	return _receiving;
+}
+
+/**
+*  Method: isValid()
+*  @ Since v0.1.2, October 2026
+*  @ Returns true if the last packet was completely received, its checksum verified and (when using 
+*    a buffer) its payload stored.
+*/
+bool SimpleZigBeePayloadSink::isValid(){
+	return _valid;
+}
+
+/**
+*  Method: getLength()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of payload bytes received for the current (or last) packet. When using a 
+*    buffer, only the bytes stored in the buffer are counted.
+*/
+int SimpleZigBeePayloadSink::getLength(){
+	return _length;
+}
+
+/**
+*  Method: getBuffer()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the buffer holding the payload (NULL if the sink only uses a callback). Only use the 
+*    payload if isValid() is true.
+*/
+uint8_t* SimpleZigBeePayloadSink::getBuffer(){
+	return _buffer;
+}
+
+/*//////////////////////////////////////////////////////////////////////
+									STATISTICS METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: getFrameCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of packets received without an error.
+*/
+unsigned long SimpleZigBeePayloadSink::getFrameCount(){
+	return _frameCount;
+}
+
+/**
+*  Method: getFailCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of packets that ended with an error.
+*/
+unsigned long SimpleZigBeePayloadSink::getFailCount(){
+	return _failCount;
+}
+
+/**
+*  Method: resetCounters()
+*  @ Since v0.1.2, October 2026
+*  @ Resets the frame count and the fail count.
+*/
+void SimpleZigBeePayloadSink::resetCounters(){
+	_frameCount = 0;
+	_failCount = 0;
+}
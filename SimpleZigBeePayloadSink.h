@@ -0,0 +1,129 @@
+/**
+* Library Name: SimpleZigBeePayloadSink
+* Library URI: https://github.com/ericburger/simple-zigbee
+* Description: Receives the payload of RX packets that are too large for the incoming
+* packet object in chunks, so large packets can be received without storing them.
+* Version: 0.1.2
+* Author(s): Eric Burger
+* Author URI: WallflowerOpen.com
+* License: GNU General Public License v2.0 or later
+* License URI: http://www.gnu.org/licenses/gpl-2.0.html 
+*
+* Copyright (c) 2013 Eric Burger. All rights reserved.
+*
+* This file is part of SimpleZigBee, written for XBee S2 Radios.
+*
+* SimpleZigBee is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* SimpleZigBee is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with SimpleZigBee.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SimpleZigBeePayloadSink_h
+#define SimpleZigBeePayloadSink_h
+
+#include "Arduino.h"
+// Requires SimpleIncomingZigBeePacket class
+#include "SimpleZigBeePacket.h"
+// Required for uint8_t type
+#include <inttypes.h>
+
+// Largest frame length of an incoming packet that is streamed to a payload sink (see SimpleZigBeeRadio::setPayloadSink()).
+// The XBee radio sends up to 255 bytes of RF payload (with fragmentation), plus the 12 byte RX header.
+// In API Mode (ATAP=1), a false START byte can look like the start of a long packet, so keep this small.
+#ifndef SIMPLE_ZIGBEE_MAX_STREAM_FRAME_LENGTH
+#define SIMPLE_ZIGBEE_MAX_STREAM_FRAME_LENGTH 267
+#endif
+
+// Function that receives the payload of a streamed RX packet (see SimpleZigBeePayloadSink)
+typedef void (*SimpleZigBeePayloadCallback)(SimpleIncomingZigBeePacket & packet, const uint8_t* data, int length);
+
+/**
+* Class: SimpleZigBeePayloadSink
+* @ Since v0.1.2, October 2026
+* @ Receives the payload of RX packets that are longer than the maximum frame length of the incoming packet
+*   object. When set in the radio (see SimpleZigBeeRadio::setPayloadSink()), such a packet is not dropped 
+*   with MAX_FRAME_LENGTH_EXCEEDED. Instead, the RX header (frame type, addresses and options) is stored in
+*   the incoming packet as usual, and the payload is passed to the sink in chunks as it is received:
+*     - With a callback, each chunk is passed to the callback. The packet passed with it holds the RX header, 
+*       so getRXAddress64(), getRXOptions() and getRXPayloadLength() (the full payload length) can be used, 
+*       but not getRXPayload(). Before the first chunk, the callback is called with a length of 0 and data 
+*       that is not NULL (to be ignored), to tell it that a new packet begins.
+*     - With a buffer, the chunks are copied to the buffer (see getBuffer() and getLength()). Bytes that do
+*       not fit are dropped and the packet fails with MAX_FRAME_LENGTH_EXCEEDED.
+*   Since the chunks are passed on before the checksum byte arrives, the packet is only valid if it ends
+*   well: at the end, the callback (if set) is called once more with NULL data and a length of 0, and 
+*   packet.getErrorCode() gives the verdict (NO_ERROR, CHECKSUM_FAILURE or UNEXPECTED_PACKET_START). 
+*   Streamed packets are not passed to the frame callback, frame queue or dispatcher.
+*   The sink is called wherever the bytes are parsed (in the interrupt or reader thread when using
+*   SimpleZigBeeRadio::setAsyncReceive()).
+*   Example:
+*     SimpleZigBeePayloadSinkT<255> sink;
+*     xbee.setPayloadSink( sink );
+*/
+class SimpleZigBeePayloadSink {
+public:
+	// INITIALIZATION METHODS //
+	SimpleZigBeePayloadSink(SimpleZigBeePayloadCallback callback);
+	SimpleZigBeePayloadSink(uint8_t* buffer, int size, SimpleZigBeePayloadCallback callback = NULL);
+	
+	// STREAM METHODS (called by SimpleZigBeeRadio) //
+	void begin(SimpleIncomingZigBeePacket & packet);
+	void write(SimpleIncomingZigBeePacket & packet, const uint8_t* data, int length);
+	void end(SimpleIncomingZigBeePacket & packet);
+	
+	// RESULT METHODS //
+	bool isReceiving();
+	bool isValid();
+	int getLength();
+	uint8_t* getBuffer();
+	
+	// STATISTICS METHODS //
+	unsigned long getFrameCount();
+	unsigned long getFailCount();
+	void resetCounters();
+
+private:
+	// Function called with each chunk and at the end of each packet (NULL if not set)
+	SimpleZigBeePayloadCallback _callback;
+	// Buffer for the payload (NULL if the chunks are only passed to the callback)
+	uint8_t* _buffer;
+	int _size;
+	// Number of payload bytes received for the current (or last) packet
+	int _length;
+	// Boolean indicating whether a packet is being received
+	bool _receiving;
+	// Boolean indicating whether the last packet ended without an error
+	bool _valid;
+	// Boolean indicating whether payload bytes were dropped because the buffer is full
+	bool _overflow;
+	// Number of packets received without and with an error
+	unsigned long _frameCount;
+	unsigned long _failCount;
+};
+
+/**
+* Class: SimpleZigBeePayloadSinkT
+* @ Since v0.1.2, October 2026
+* @ Payload sink that holds its own buffer of Size bytes.
+*/
+template<int Size>
+class SimpleZigBeePayloadSinkT : public SimpleZigBeePayloadSink {
+public:
+	SimpleZigBeePayloadSinkT(SimpleZigBeePayloadCallback callback = NULL) : SimpleZigBeePayloadSink(_buffer_storage, Size, callback) {}
+
+private:
+	static_assert( Size >= 1, "Size must be at least 1" );
+	uint8_t _buffer_storage[Size];
+};
+
+#endif //SimpleZigBeePayloadSink_h
@@ -21,12 +21,12 @@
 *  @ Since v0.1.0 by Eric Burger, September 2013
 *  @ Default constructor that creates packet object for incoming and outgoing packets.
 *  @ By default, library assumes XBee is in Escaped API Mode (ATAP=2).
+*  @ Last Modified v0.1.2 by Eric Burger, October 2026
+*  @ Changlog for v0.1.2:
+*       - The packet objects are members with fixed arrays and are no longer assigned (and allocated) here
+*       - Calls SimpleZigBeeRadio(true)
 */
-SimpleZigBeeRadio::SimpleZigBeeRadio() {
-	_incoming_packet = SimpleIncomingZigBeePacket();
-	_outgoing_packet = SimpleOutgoingZigBeePacket();
-	_escaped_mode = true;
-	reset();
+SimpleZigBeeRadio::SimpleZigBeeRadio() : SimpleZigBeeRadio(true) {
 }
 
 
@@ -35,11 +35,40 @@ SimpleZigBeeRadio::SimpleZigBeeRadio() {
 *  @ Since v0.1.0 by Eric Burger, September 2013
 *  @ Constructor with parameter. Creates packet object for incoming and outgoing packets.
 *  @ param bool escaped_mode: FALSE if API Mode (ATAP=1) and TRUE if Escaped API Mode (ATAP=2).
-*/
-SimpleZigBeeRadio::SimpleZigBeeRadio(bool escaped_mode) {
-	_incoming_packet = SimpleIncomingZigBeePacket();
-	_outgoing_packet = SimpleOutgoingZigBeePacket();
-	_escaped_mode = escaped_mode;
+*  @ Last Modified v0.1.2 by Eric Burger, October 2026
+*  @ Changlog for v0.1.2:
+*       - In API Mode (ATAP=1), each possible packet is checked (frame length, frame type and checksum) and
+*         dropped when the check fails, so a false START byte does not hold up the parser. Bytes after the 
+*         failed check are parsed as usual. The parser only goes back to the next START byte inside the failed
+*         packet if a lookback window has been set with setResyncBuffer() (see parseByte()). Since no bytes
+*         are escaped, API Mode uses less of the serial bandwidth for payloads with many 0x7E, 0x7D, 0x11 or 0x13 bytes.
+*       - The packet objects are members with fixed arrays and are no longer assigned (and allocated) here.
+*         The other members are set in the initializer list.
+*/
+SimpleZigBeeRadio::SimpleZigBeeRadio(bool escaped_mode) :
+	_serial(NULL),
+	_escaped_mode(escaped_mode),
+	_frame_callback(NULL),
+	_frame_queue(NULL),
+	_async_receive(false),
+	_dispatcher(NULL),
+	_request_table(NULL),
+	_retransmitter(NULL),
+	_address_cache(NULL),
+	_route_cache(NULL),
+	_fragmenter(NULL),
+	_coalescer(NULL),
+	_scheduler(NULL),
+	_payload_sink(NULL),
+	_resync_buffer(NULL),
+	_resync_size(0),
+	_resync_length(0),
+	_resync_parsed(0),
+	_out_buffer_length(0),
+	_transmit_buffer(NULL),
+	_flush_policy(FLUSH_EACH_PACKET),
+	_batch_depth(0)
+{
 	reset();
 }
 
@@ -50,6 +79,8 @@ SimpleZigBeeRadio::SimpleZigBeeRadio(bool escaped_mode) {
 */
 void SimpleZigBeeRadio::reset(){
 	resetIncoming();
+	_resync_length = 0;
+	_resync_parsed = 0;
 	resetOutgoing();
 	_out_frame_id = 0;
 	_out_acknowledgement = false;
@@ -59,6 +90,9 @@ void SimpleZigBeeRadio::reset(){
 *  Method: resetIncoming()
 *  @ Since v0.1.0 by Eric Burger, July 2014
 *  @ Resets incoming packet and the radio's private parameters.
+*  @ Last Modified v0.1.2 by Eric Burger, October 2026
+*  @ Changlog for v0.1.2:
+*       - Also resets the payload streaming state (see setPayloadSink())
 */
 void SimpleZigBeeRadio::resetIncoming(){
 	_incoming_packet.reset();
@@ -66,6 +100,8 @@ void SimpleZigBeeRadio::resetIncoming(){
 	_in_escaping = false;
 	_in_checksum = 0;
 	_in_index = 0;
+	_in_streaming = false;
+	_in_staged = 0;
 }
 
 /**
@@ -130,8 +166,14 @@ SimpleOutgoingZigBeePacket& SimpleZigBeeRadio::getOutgoingPacketObject() {
 *  Method: available()
 *  @ Since v0.1.0 by Eric Burger, January 2014
 *  @ Checks if bytes received by serial port and returns boolean
+*  @ Last Modified v0.1.2 by Eric Burger, October 2026
+*  @ Changlog for v0.1.2:
+*       - Also returns true if bytes are waiting to be parsed again after an error (API Mode only, see parseByte())
 */
 bool SimpleZigBeeRadio::available(){
+	if( _resync_parsed < _resync_length ){
+		return true;
+	}
 	if( _serial->available() > 0 ){
 		return true;
 	}
@@ -142,132 +184,1105 @@ bool SimpleZigBeeRadio::available(){
 *  Method: read()
 *  @ Since v0.1.0 by Eric Burger, September 2013
 *  @ Reads incoming ZigBee packet from serial port and stores in packet object
+*  @ Last Modified v0.1.2 by Eric Burger, October 2026
+*  @ Changlog for v0.1.2:
+*       - Moved the packet parsing into parseByte() so that it can be shared with feed()
+*       - Bytes left in the lookback window after an error (API Mode only, see parseByte()) are parsed first
 */
 void SimpleZigBeeRadio::read(){
-	// Don't do anything if _serial not available
-	if( _serial->available() ){
-		// Before receiving a new packet from the serial buffer, reset incoming packet object, if necessary
-		if( _incoming_packet.isError() || isComplete() ){
-			// Store error code before resetting
-			int err = _incoming_packet.getErrorCode();
-			// If the previous packet was completely received or contained an error, reset.
-			resetIncoming();
-			// If error was caused by UNEXPECTED_PACKET_START, set current index to 1 since the START byte has already been read from the serial buffer.
-			if( UNEXPECTED_PACKET_START == err ){
-				_in_index = 1;
+	// In API Mode (ATAP=1), first finish parsing any bytes left in the lookback window by resync()
+	if( parsePending() ){
+		return;
+	}
+	// Read from serial port, while bytes are available. Stop as soon as a packet has been completely 
+	// received or an error occured so that the packet can be checked before the next one is read.
+	while( _serial->available() ){
+		if( parseByte( _serial->read() ) ){
+			return;
+		}
+	}
+}
+
+/**
+*  Method: readAvailable()
+*  @ Since v0.1.2, October 2026
+*  @ Reads all of the bytes waiting in the serial port and parses them with feed(). Rather than
+*    calling Stream::read() (and Stream::available()) for every byte, the bytes are copied in blocks
+*    using Stream::readBytes(). Only the bytes reported by Stream::available() are requested, so
+*    the call never waits for the Stream timeout. Unlike read(), this method does not stop after 
+*    the first complete packet. Use setFrameCallback() to handle every packet that is received.
+*    Returns the number of packets that were completely received.
+*/
+int SimpleZigBeeRadio::readAvailable(){
+	uint8_t buffer[SIMPLE_ZIGBEE_READ_BUFFER_SIZE];
+	int frames = 0;
+	int count = _serial->available();
+	while( count > 0 ){
+		if( count > SIMPLE_ZIGBEE_READ_BUFFER_SIZE ){
+			count = SIMPLE_ZIGBEE_READ_BUFFER_SIZE;
+		}
+		// Cast as char* since older versions of the Stream class do not accept uint8_t*
+		size_t received = _serial->readBytes( (char*)buffer, count );
+		if( 0 == received ){
+			break;
+		}
+		frames += feed( buffer, received );
+		count = _serial->available();
+	}
+	return frames;
+}
+
+/**
+*  Method: feed(const uint8_t* data, size_t length)
+*  @ Since v0.1.2, October 2026
+*  @ Parses a block of bytes that has already been received from the XBee radio (for example, 
+*    by a serial driver or from a recording). The bytes are run through the same state machine
+*    as read(). Parsing continues after each complete packet, so a block may contain several 
+*    packets. The frame callback (see setFrameCallback()) is called for each complete packet.
+*    Returns the number of packets that were completely received.
+*    Inside the frame data, runs of bytes that do not need to be un-escaped are stored and added 
+*    to the checksum as a block (see parseFrameDataRun()). Only the START, length, checksum and escaped
+*    bytes go through parseByte() one at a time.
+*  @ param const uint8_t* data: Pointer to array of received bytes
+*  @ param size_t length: Number of bytes in array
+*/
+int SimpleZigBeeRadio::feed(const uint8_t* data, size_t length){
+	int frames = 0;
+	size_t i = 0;
+	while( i < length ){
+		size_t run = parseFrameDataRun( data+i, length-i );
+		if( run > 0 ){
+			i += run;
+		}else{
+			if( parseByte( data[i] ) && isComplete() ){
+				frames++;
 			}
+			i++;
 		}
-		
-		// Otherwise, if the previous packet was incomplete but free of errors, try and receive the rest of the packet.
-		
-		// Read from serial port, while bytes are available
-		while( _serial->available() ){
-			_in_byte = _serial->read();
-			
-			// First, check if XBee is in Escaped API Mode (ATAP=2)
-			if ( true == _escaped_mode ) {
-				// Next, check if a (non-escaped) start frame delimiter is found anywhere other than the start of the packet.
-				if ( START == _in_byte && _in_index > 0  ) {
-					// AN ERROR OCCURED
-					// If found, it means that a new packet has started before the previous packet was completely received.
-					// This may indicate a noisy environment or that the buffer overflowed when the previous packet was being 
-					// received by the XBee.
-					// Set error message and return. If read() is called again, packet object will be reset but current index will be set to 1.
-					_incoming_packet.setErrorCode( UNEXPECTED_PACKET_START );
-					return;
-				}
-				
-				// If byte has been flagged as escaped, "un-escape" the byte using the "Excusive bitwise OR" operator (^) 
-				if ( true == isEscaping() ) {
-					_in_byte = 0x20 ^ _in_byte;
-					setEscaping(false);
-				}
-				
-				// Check if current byte is escape byte. If true, this indicates that the next byte in the packet has been escaped.
-				if ( _in_byte == ESCAPE && _in_index > 0 ) {
-					// Try and read the next byte from the serial buffer, otherwise, note that next byte is escaped by 
-					// setting _escaping to true and continuing loop.
-					if ( _serial->available() ) {
-						_in_byte = _serial->read();
-						// "Un-escape" the byte using the "Excusive bitwise OR" operator (^) 
-						_in_byte = 0x20 ^ _in_byte;
-					} else {
-						setEscaping(true);
-						// Jump to the start of the while loop and re-check the condition (maybe buffer will be ready).
-						continue; 
-					}
-				}
+	}
+	// In API Mode (ATAP=1), finish parsing any bytes left in the lookback window by resync()
+	while( _resync_parsed < _resync_length ){
+		if( parsePending() && isComplete() ){
+			frames++;
+		}
+	}
+	return frames;
+}
+
+/**
+*  Method: parseFrameDataRun(const uint8_t* data, size_t length)
+*  @ Since v0.1.2, October 2026
+*  @ Stores as many bytes as possible from the start of the array in the frame data of the incoming packet,
+*    as long as the bytes would have been stored by parseByte() without any other processing. That is, the 
+*    frame length is known, the checksum byte has not been reached, the maximum frame length will not be 
+*    exceeded, and (in Escaped API Mode) the bytes are not START or ESCAPE. Returns the number of bytes 
+*    stored, which will be 0 if the first byte must be handled by parseByte().
+*    For a packet longer than the maximum frame length (see setPayloadSink()), the run stops at the end of
+*    the RX header and the payload bytes are passed to streamPayload() instead of being stored.
+*  @ param const uint8_t* data: Pointer to array of received bytes
+*  @ param size_t length: Number of bytes in array
+*/
+size_t SimpleZigBeeRadio::parseFrameDataRun(const uint8_t* data, size_t length){
+	// The first byte must go through parseByte() if the packet needs to be reset, if the frame 
+	// length is not known yet, or if the byte must be un-escaped.
+	// In API Mode (ATAP=1), bytes waiting to be parsed again (see resync()) must be parsed first and the frame type 
+	// must be checked by parsePacketByte().
+	if( _in_index < FRAME_TYPE_INDEX || isComplete() || _incoming_packet.isError() || isEscaping() ){
+		return 0;
+	}
+	if( false == _escaped_mode && (FRAME_TYPE_INDEX == _in_index || _resync_parsed < _resync_length) ){
+		return 0;
+	}
+	// The frame type of a streamed packet must be checked by parsePacketByte()
+	if( true == _in_streaming && FRAME_TYPE_INDEX == _in_index ){
+		return 0;
+	}
+	int frameIndex = _in_index - FRAME_TYPE_INDEX;
+	// Number of bytes remaining before the checksum...
+	int remaining = (_incoming_packet.getFrameLength() + 3) - _in_index;
+	if( true == _in_streaming ){
+		// ...and before the end of the RX header, if the run starts inside it
+		int header = SimpleZigBeeRxLayout::PAYLOAD_INDEX - frameIndex;
+		if( header > 0 && header < remaining ){
+			remaining = header;
+		}
+	}else{
+		// ...and before parsePacketByte() would report MAX_FRAME_LENGTH_EXCEEDED
+		int allowed = (_incoming_packet.getMaxFrameLength() + FRAME_TYPE_INDEX) - _in_index;
+		if( allowed < remaining ){
+			remaining = allowed;
+		}
+	}
+	if( remaining <= 0 ){
+		return 0;
+	}
+	size_t run = length;
+	if( (size_t)remaining < run ){
+		run = remaining;
+	}
+	// In Escaped API Mode, stop at the first START or ESCAPE byte
+	if( true == _escaped_mode ){
+		run = SimpleZigBeeCodec::findSpecial( data, run );
+	}
+	if( run > 0 ){
+		if( false == _escaped_mode && NULL != _resync_buffer ){
+			// Keep the bytes for resync() (see parseByte())
+			storeResyncBytes( data, run );
+			_resync_parsed = _resync_length;
+		}
+		if( true == _in_streaming && frameIndex >= SimpleZigBeeRxLayout::PAYLOAD_INDEX ){
+			streamPayload( data, run );
+		}else{
+			_incoming_packet.setFrameData( frameIndex, data, run );
+		}
+		_in_checksum += SimpleZigBeeCodec::sum( data, run );
+		_in_index += run;
+	}
+	return run;
+}
+
+/**
+*  Method: streamPayload(const uint8_t* data, size_t length)
+*  @ Since v0.1.2, October 2026
+*  @ Passes payload bytes of a packet longer than the maximum frame length to the payload sink (see 
+*    setPayloadSink()). The sink is told that a packet begins when the first payload byte arrives. Runs of
+*    bytes from feed() are passed on as they are. Single bytes (from read(), or bytes that were escaped) are
+*    stored after the RX header in the incoming packet and passed on in chunks (see flushStagedPayload()), 
+*    so the sink is not called for every byte and no extra memory is needed.
+*  @ param const uint8_t* data: Pointer to array of payload bytes
+*  @ param size_t length: Number of bytes in array
+*/
+void SimpleZigBeeRadio::streamPayload(const uint8_t* data, size_t length){
+	if( (FRAME_TYPE_INDEX + SimpleZigBeeRxLayout::PAYLOAD_INDEX) == _in_index ){
+		_payload_sink->begin( _incoming_packet );
+	}
+	if( length > 1 ){
+		// Bytes stored before the run come first
+		flushStagedPayload();
+		_payload_sink->write( _incoming_packet, data, length );
+		return;
+	}
+	if( (SimpleZigBeeRxLayout::PAYLOAD_INDEX + _in_staged) >= _incoming_packet.getMaxFrameLength() ){
+		flushStagedPayload();
+	}
+	_incoming_packet.setFrameData( (SimpleZigBeeRxLayout::PAYLOAD_INDEX + _in_staged), data[0] );
+	_in_staged++;
+}
+
+/**
+*  Method: flushStagedPayload()
+*  @ Since v0.1.2, October 2026
+*  @ Passes the payload bytes stored after the RX header (see streamPayload()) to the payload sink.
+*/
+void SimpleZigBeeRadio::flushStagedPayload(){
+	if( _in_staged > 0 ){
+		_payload_sink->write( _incoming_packet, _incoming_packet.getFrameDataPointer( SimpleZigBeeRxLayout::PAYLOAD_INDEX, _in_staged ), _in_staged );
+		_in_staged = 0;
+	}
+}
+
+/**
+*  Method: endStream()
+*  @ Since v0.1.2, October 2026
+*  @ Called by parsePacketByte() when a streamed packet ends, with the verdict set as the error code of 
+*    the incoming packet. Passes the remaining payload bytes and the verdict to the payload sink. If the
+*    packet ended before its payload started, the sink was never told about it and nothing is done.
+*/
+void SimpleZigBeeRadio::endStream(){
+	if( _in_index <= (FRAME_TYPE_INDEX + SimpleZigBeeRxLayout::PAYLOAD_INDEX) ){
+		return;
+	}
+	flushStagedPayload();
+	_payload_sink->end( _incoming_packet );
+}
+
+/**
+*  Method: setFrameCallback(SimpleZigBeeFrameCallback callback)
+*  @ Since v0.1.2, October 2026
+*  @ Sets the function that is called each time an incoming packet is completely received.
+*    The function is passed the incoming packet object and is called before the next byte is parsed.
+*  @ param SimpleZigBeeFrameCallback callback: Function to call, or NULL to disable
+*/
+void SimpleZigBeeRadio::setFrameCallback(SimpleZigBeeFrameCallback callback){
+	_frame_callback = callback;
+}
+
+/**
+*  Method: setFrameQueue(SimpleZigBeeFrameQueue & queue)
+*  @ Since v0.1.2, October 2026
+*  @ Sets the queue that stores a copy of each incoming packet once it is completely received. 
+*    When packets arrive in bursts, readAvailable() can parse all of them and the program can 
+*    handle them later with queue.pop(). Packets that do not fit are counted by queue.getDropCount().
+*    The radio is the only producer of the queue, so do not push() to it from elsewhere.
+*  @ param SimpleZigBeeFrameQueue & queue: Queue object (for example, SimpleZigBeeFrameQueueT<8>)
+*/
+void SimpleZigBeeRadio::setFrameQueue(SimpleZigBeeFrameQueue & queue){
+	_frame_queue = &queue;
+}
+
+/**
+*  Method: setAsyncReceive(SimpleZigBeeFrameQueue & queue)
+*  @ Since v0.1.2, October 2026
+*  @ Starts the asynchronous receive mode, in which the bytes from the XBee radio are parsed outside of loop(), 
+*    as soon as they arrive, so the 64 byte receive buffer of the serial port cannot overflow while the program
+*    is busy. The bytes are passed to feed() (or read with readAvailable()) by an interrupt (for example, a timer
+*    interrupt or the receive interrupt of a serial driver) or, on a computer, by a reader thread. Complete packets
+*    are only copied to the queue there. The program then calls poll(), which handles each queued packet (request 
+*    table, retransmitter, frame callback and dispatcher) and sends, but does not read the serial port.
+*    The parser and the queue are the only things used by the interrupt or thread, and the queue needs no locks
+*    (see SimpleZigBeeFrameQueue), so nothing else has to be protected. Do not call read(), readAvailable() or 
+*    feed() from the program in this mode, and do not use getIncomingPacketObject() (use the packet passed to the 
+*    frame callback or handlers instead). Packets larger than SIMPLE_ZIGBEE_MAX_FRAME_LENGTH need a larger 
+*    incoming packet and queue slots.
+*    Call before the interrupt or thread starts.
+*  @ param SimpleZigBeeFrameQueue & queue: Queue object (for example, SimpleZigBeeFrameQueueT<8>)
+*/
+void SimpleZigBeeRadio::setAsyncReceive(SimpleZigBeeFrameQueue & queue){
+	_frame_queue = &queue;
+	_async_receive = true;
+}
+
+/**
+*  Method: isAsyncReceive()
+*  @ Since v0.1.2, October 2026
+*  @ Checks if the asynchronous receive mode is used (see setAsyncReceive()).
+*/
+bool SimpleZigBeeRadio::isAsyncReceive(){
+	return _async_receive;
+}
+
+/**
+*  Method: setPayloadSink(SimpleZigBeePayloadSink & sink)
+*  @ Since v0.1.2, October 2026
+*  @ Sets the sink that receives the payload of RX packets longer than the maximum frame length of the 
+*    incoming packet (SIMPLE_ZIGBEE_MAX_FRAME_LENGTH), up to a frame length of SIMPLE_ZIGBEE_MAX_STREAM_FRAME_LENGTH.
+*    Without a sink, these packets are dropped with MAX_FRAME_LENGTH_EXCEEDED. With a sink, the RX header is 
+*    stored in the incoming packet and the payload is passed to the sink in chunks, followed by the checksum
+*    verdict (see SimpleZigBeePayloadSink). The incoming packet is then reset, so read() and feed() do not 
+*    report it as complete. Other frame types that are too long are still dropped. 
+*    The maximum frame length must be larger than 12 (the RX header).
+*  @ param SimpleZigBeePayloadSink & sink: Sink object (for example, SimpleZigBeePayloadSinkT<255>)
+*/
+void SimpleZigBeeRadio::setPayloadSink(SimpleZigBeePayloadSink & sink){
+	_payload_sink = &sink;
+}
+
+/**
+*  Method: getPayloadSink()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the payload sink, or NULL if it has not been set.
+*/
+SimpleZigBeePayloadSink * SimpleZigBeeRadio::getPayloadSink(){
+	return _payload_sink;
+}
+
+/**
+*  Method: getFrameQueue()
+*  @ Since v0.1.2, October 2026
+*  @ Returns a pointer to the queue set by setFrameQueue(), or NULL if no queue is set.
+*/
+SimpleZigBeeFrameQueue * SimpleZigBeeRadio::getFrameQueue(){
+	return _frame_queue;
+}
+
+/**
+*  Method: setResyncBuffer(uint8_t* buffer, int size)
+*  @ Since v0.1.2, October 2026
+*  @ API Mode (ATAP=1) only. Sets the array used as the lookback window, so that a packet that starts inside
+*    a corrupted packet is still received (see parseByte()). The size should be at least the maximum frame 
+*    length plus 4 (for example, 64 bytes). Without a buffer, false START bytes are still rejected by the 
+*    frame type and frame length checks, but the bytes of a failed packet are not parsed again. Any bytes 
+*    waiting in the previous buffer are discarded. Set a NULL buffer to stop using the window.
+*  @ param uint8_t* buffer: Pointer to array owned by the caller
+*  @ param int size: Number of bytes in array
+*/
+void SimpleZigBeeRadio::setResyncBuffer(uint8_t* buffer, int size){
+	if( NULL == buffer || size <= 0 ){
+		buffer = NULL;
+		size = 0;
+	}
+	_resync_buffer = buffer;
+	_resync_size = size;
+	_resync_length = 0;
+	_resync_parsed = 0;
+}
+
+/**
+*  Method: setDispatcher(SimpleZigBeeDispatcher & dispatcher)
+*  @ Since v0.1.2, October 2026
+*  @ Sets the table of handlers that is used for each incoming packet. The handler for the frame type
+*    of the packet is called as soon as the packet is completely received, after the frame callback (if set).
+*    If a frame queue is also set, packets are instead dispatched when poll() removes them from the queue.
+*  @ param SimpleZigBeeDispatcher & dispatcher: Dispatcher object
+*/
+void SimpleZigBeeRadio::setDispatcher(SimpleZigBeeDispatcher & dispatcher){
+	_dispatcher = &dispatcher;
+}
+
+/**
+*  Method: getDispatcher()
+*  @ Since v0.1.2, October 2026
+*  @ Returns a pointer to the dispatcher set by setDispatcher(), or NULL if no dispatcher is set.
+*/
+SimpleZigBeeDispatcher * SimpleZigBeeRadio::getDispatcher(){
+	return _dispatcher;
+}
+
+/**
+*  Method: poll()
+*  @ Since v0.1.2, October 2026
+*  @ Handles every packet that is waiting, so it can be the only radio call in loop(). All bytes
+*    waiting in the serial port are parsed (see readAvailable()). If a frame queue is set, the queued 
+*    packets are then passed one at a time to the dispatcher (if set) where they are stored in the queue
+*    (see SimpleZigBeePacketRef) and popped. If a request table is set, requests that have waited too long
+*    are marked as timed out. If a retransmitter is set, the failed TX requests that are due are sent again.
+*    If a fragmenter is set, messages that are missing fragments for too long are dropped. If a coalescer is
+*    set, the bundles that are due are sent. If a scheduler is set, the queued requests are sent as far as
+*    the radio allows.
+*    If a transmit buffer is set, waiting outgoing bytes are written as far as the serial port allows.
+*    In asynchronous receive mode (see setAsyncReceive()), the serial port is not read. Instead, each packet
+*    waiting in the frame queue is matched with its request, passed to the frame callback and dispatcher, and popped.
+*    Returns the number of packets that were handled.
+*/
+int SimpleZigBeeRadio::poll(){
+	service();
+	int frames;
+	if( true == _async_receive ){
+		frames = handleQueuedFrames();
+	}else{
+		frames = readAvailable();
+	}
+	if( NULL != _request_table ){
+		_request_table->checkTimeouts();
+	}
+	if( NULL != _retransmitter ){
+		_retransmitter->service( *this );
+	}
+	if( NULL != _fragmenter ){
+		_fragmenter->checkTimeouts();
+	}
+	if( NULL != _coalescer ){
+		_coalescer->service( *this );
+	}
+	if( NULL != _scheduler ){
+		_scheduler->service( *this );
+	}
+	service();
+	if( true == _async_receive || NULL == _frame_queue || NULL == _dispatcher ){
+		return frames;
+	}
+	frames = 0;
+	const uint8_t* frameData;
+	while( NULL != (frameData = _frame_queue->peekFrameData()) ){
+		// Dispatched where it is stored in the queue, since the incoming packet may hold a partly received packet
+		SimpleZigBeePacketRef<SimpleIncomingZigBeePacket> packet( (uint8_t*)frameData, _frame_queue->peekFrameLength() );
+		_dispatcher->dispatch( packet );
+		_frame_queue->pop();
+		frames++;
+	}
+	return frames;
+}
+
+/**
+*  Method: setRequestTable(SimpleZigBeeRequestTable & table)
+*  @ Since v0.1.2, October 2026
+*  @ Sets the table that records each request sent with send() and matches it with the TX status, AT command
+*    response or remote AT command response that has the same frame ID. While a table is set, setNextFrameID()
+*    skips frame IDs that are still waiting for a response.
+*  @ param SimpleZigBeeRequestTable & table: Table object (for example, SimpleZigBeeRequestTableT<16>)
+*/
+void SimpleZigBeeRadio::setRequestTable(SimpleZigBeeRequestTable & table){
+	_request_table = &table;
+}
+
+/**
+*  Method: getRequestTable()
+*  @ Since v0.1.2, October 2026
+*  @ Returns a pointer to the table set by setRequestTable(), or NULL if no table is set.
+*/
+SimpleZigBeeRequestTable * SimpleZigBeeRadio::getRequestTable(){
+	return _request_table;
+}
+
+/**
+*  Method: canSend()
+*  @ Since v0.1.2, October 2026
+*  @ Checks if another TX request can be sent now. If the request table has a transmit window (see 
+*    SimpleZigBeeRequestTable::setTransmitWindow()), returns false while the window is full or no frame ID 
+*    is free. Call poll() so that TX status packets open the window again. Returns true if there is no window.
+*/
+bool SimpleZigBeeRadio::canSend(){
+	if( NULL == _request_table || NULL == _request_table->getTransmitWindow() ){
+		return true;
+	}
+	if( !_request_table->getTransmitWindow()->isOpen() ){
+		return false;
+	}
+	return 0 != _request_table->getNextFrameID( getLastFrameID() );
+}
+
+/**
+*  Method: getSendCapacity()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of TX requests that can be sent one after the other right now, or 255 if nothing
+*    limits it. If a scheduler is set, requests are queued and given their frame IDs when poll() sends 
+*    them, so the free slots of the scheduler are counted (0 if acknowledgement is on and no frame ID is 
+*    free). Otherwise, when acknowledgement is on, each request needs a free frame ID in the request table
+*    (if set) and room in its transmit window (if set). Used to send every fragment of a message or none.
+*/
+uint8_t SimpleZigBeeRadio::getSendCapacity(){
+	bool ack = (_out_acknowledgement == true && NULL != _request_table);
+	if( NULL != _scheduler ){
+		if( ack && 0 == _request_table->getNextFrameID( getLastFrameID() ) ){
+			return 0;
+		}
+		return _scheduler->getFreeCount();
+	}
+	if( !ack ){
+		return 255;
+	}
+	uint8_t capacity = _request_table->getFreeCount();
+	SimpleZigBeeTransmitWindow * window = _request_table->getTransmitWindow();
+	if( NULL != window ){
+		uint8_t open = window->isOpen() ? window->getWindow() - window->getInFlight() : 0;
+		if( open < capacity ){
+			capacity = open;
+		}
+	}
+	return capacity;
+}
+
+/**
+*  Method: setRetransmitter(SimpleZigBeeRetransmitter & retransmitter)
+*  @ Since v0.1.2, October 2026
+*  @ Sets the retransmitter that keeps a copy of each TX request sent with send() until its TX status arrives.
+*    Failed requests are sent again by poll(), depending on the delivery status (see SimpleZigBeeRetransmitter).
+*  @ param SimpleZigBeeRetransmitter & retransmitter: Retransmitter object (for example, SimpleZigBeeRetransmitterT<4>)
+*/
+void SimpleZigBeeRadio::setRetransmitter(SimpleZigBeeRetransmitter & retransmitter){
+	_retransmitter = &retransmitter;
+}
+
+/**
+*  Method: getRetransmitter()
+*  @ Since v0.1.2, October 2026
+*  @ Returns a pointer to the retransmitter set by setRetransmitter(), or NULL if no retransmitter is set.
+*/
+SimpleZigBeeRetransmitter * SimpleZigBeeRadio::getRetransmitter(){
+	return _retransmitter;
+}
+
+/**
+*  Method: setAddressCache(SimpleZigBeeAddressCache & cache)
+*  @ Since v0.1.2, October 2026
+*  @ Sets the cache of 16-bit network addresses. The cache learns the addresses from incoming RX packets, 
+*    remote AT command responses and TX status packets. Requests sent with send() or sendTXRequest() with the 
+*    16-bit address 0xFFFE (for example, from prepareTXRequestToCoordinator()) are given the known address, 
+*    so the XBee radio does not have to discover it (see SimpleZigBeeAddressCache).
+*  @ param SimpleZigBeeAddressCache & cache: Cache object (for example, SimpleZigBeeAddressCacheT<32>)
+*/
+void SimpleZigBeeRadio::setAddressCache(SimpleZigBeeAddressCache & cache){
+	_address_cache = &cache;
+}
+
+/**
+*  Method: getAddressCache()
+*  @ Since v0.1.2, October 2026
+*  @ Returns a pointer to the cache set by setAddressCache(), or NULL if no cache is set.
+*/
+SimpleZigBeeAddressCache * SimpleZigBeeRadio::getAddressCache(){
+	return _address_cache;
+}
+
+/**
+*  Method: setRouteCache(SimpleZigBeeRouteCache & cache)
+*  @ Since v0.1.2, October 2026
+*  @ Sets the cache of source routes. The cache stores the route of each Route Record Indicator packet 
+*    (sent by the XBee radio of a data collector with many-to-one routing, see ATAR). Before a request to a
+*    device with a route is sent with send(), sendTXRequest() or sendFrame(), a Create Source Route frame 
+*    is sent, so the XBee radio does not have to discover the route (see SimpleZigBeeRouteCache).
+*  @ param SimpleZigBeeRouteCache & cache: Cache object (for example, SimpleZigBeeRouteCacheT<16>)
+*/
+void SimpleZigBeeRadio::setRouteCache(SimpleZigBeeRouteCache & cache){
+	_route_cache = &cache;
+}
+
+/**
+*  Method: getRouteCache()
+*  @ Since v0.1.2, October 2026
+*  @ Returns a pointer to the cache set by setRouteCache(), or NULL if no cache is set.
+*/
+SimpleZigBeeRouteCache * SimpleZigBeeRadio::getRouteCache(){
+	return _route_cache;
+}
+
+/**
+*  Method: setFragmenter(SimpleZigBeeFragmenter & fragmenter)
+*  @ Since v0.1.2, October 2026
+*  @ Sets the fragmenter used by sendMessage(). Incoming fragments are passed to the fragmenter instead of 
+*    the frame callback, frame queue and dispatcher, and each complete message is passed to the callback of
+*    the fragmenter (see SimpleZigBeeFragmenter::setCallback()).
+*  @ param SimpleZigBeeFragmenter & fragmenter: Fragmenter object (for example, SimpleZigBeeFragmenterT<512>)
+*/
+void SimpleZigBeeRadio::setFragmenter(SimpleZigBeeFragmenter & fragmenter){
+	_fragmenter = &fragmenter;
+}
+
+/**
+*  Method: getFragmenter()
+*  @ Since v0.1.2, October 2026
+*  @ Returns a pointer to the fragmenter set by setFragmenter(), or NULL if no fragmenter is set.
+*/
+SimpleZigBeeFragmenter * SimpleZigBeeRadio::getFragmenter(){
+	return _fragmenter;
+}
+
+/**
+*  Method: setCoalescer(SimpleZigBeeCoalescer & coalescer)
+*  @ Since v0.1.2, October 2026
+*  @ Sets the coalescer. TX requests sent with send() that are small enough are packed with the other 
+*    messages to the same destination and sent together by poll() (see SimpleZigBeeCoalescer). Incoming 
+*    packed packets are passed to the coalescer instead of the frame callback, frame queue and dispatcher,
+*    and each message is passed to the callback of the coalescer (see SimpleZigBeeCoalescer::setCallback()).
+*  @ param SimpleZigBeeCoalescer & coalescer: Coalescer object (for example, SimpleZigBeeCoalescerT<2>)
+*/
+void SimpleZigBeeRadio::setCoalescer(SimpleZigBeeCoalescer & coalescer){
+	_coalescer = &coalescer;
+}
+
+/**
+*  Method: getCoalescer()
+*  @ Since v0.1.2, October 2026
+*  @ Returns a pointer to the coalescer set by setCoalescer(), or NULL if no coalescer is set.
+*/
+SimpleZigBeeCoalescer * SimpleZigBeeRadio::getCoalescer(){
+	return _coalescer;
+}
+
+/**
+*  Method: setScheduler(SimpleZigBeeScheduler & scheduler)
+*  @ Since v0.1.2, October 2026
+*  @ Sets the scheduler. Requests to other devices sent with send() or sendFrame() are queued by destination
+*    and priority class (see SimpleZigBeeScheduler::setPriority()) and sent by poll(), so a bulk transfer or an 
+*    unreachable device does not hold up the requests to other devices. send() and sendFrame() then return 
+*    false only if the request could not be queued. Retries from the retransmitter are sent at once.
+*  @ param SimpleZigBeeScheduler & scheduler: Scheduler object (for example, SimpleZigBeeSchedulerT<8>)
+*/
+void SimpleZigBeeRadio::setScheduler(SimpleZigBeeScheduler & scheduler){
+	_scheduler = &scheduler;
+}
+
+/**
+*  Method: getScheduler()
+*  @ Since v0.1.2, October 2026
+*  @ Returns a pointer to the scheduler set by setScheduler(), or NULL if no scheduler is set.
+*/
+SimpleZigBeeScheduler * SimpleZigBeeRadio::getScheduler(){
+	return _scheduler;
+}
+
+/**
+*  Method: setTransmitBuffer(SimpleZigBeeTransmitBuffer & buffer)
+*  @ Since v0.1.2, October 2026
+*  @ Sets the buffer that outgoing packets are added to. With a buffer, send() returns as soon as the packet 
+*    is in the buffer (or returns false if there is no room), and the bytes are written to the serial port 
+*    by service() and poll() as fast as the port can take them. The serial port is never flushed.
+*  @ param SimpleZigBeeTransmitBuffer & buffer: Buffer object (for example, SimpleZigBeeTransmitBufferT<128>)
+*/
+void SimpleZigBeeRadio::setTransmitBuffer(SimpleZigBeeTransmitBuffer & buffer){
+	_transmit_buffer = &buffer;
+}
+
+/**
+*  Method: getTransmitBuffer()
+*  @ Since v0.1.2, October 2026
+*  @ Returns a pointer to the buffer set by setTransmitBuffer(), or NULL if no buffer is set.
+*/
+SimpleZigBeeTransmitBuffer * SimpleZigBeeRadio::getTransmitBuffer(){
+	return _transmit_buffer;
+}
+
+/**
+*  Method: service()
+*  @ Since v0.1.2, October 2026
+*  @ Writes bytes waiting in the transmit buffer to the serial port, as many as the port can take without 
+*    waiting. Called by send() and poll(), but can also be called more often (for example, between samples).
+*    Returns the number of bytes written (0 if no transmit buffer is set).
+*/
+int SimpleZigBeeRadio::service(){
+	if( NULL == _transmit_buffer || NULL == _serial ){
+		return 0;
+	}
+	return _transmit_buffer->drain( *_serial );
+}
+
+/**
+*  Method: canWrite(int frameLength)
+*  @ Since v0.1.2, October 2026
+*  @ Checks if a packet with frameLength bytes of frame data can be sent now without waiting. Always true
+*    if no transmit buffer is set. Otherwise, the buffer must have room for the packet with every byte 
+*    escaped (the longest it can be), after writing as many waiting bytes as possible to the serial port.
+*  @ param int frameLength: Number of frame data bytes of the packet
+*/
+bool SimpleZigBeeRadio::canWrite(int frameLength){
+	if( NULL == _transmit_buffer ){
+		return true;
+	}
+	// START, then length (2 bytes), frame data and checksum, each of which may be escaped
+	long packetLength = 1 + (long)(frameLength + 3) * (_escaped_mode ? 2 : 1);
+	if( packetLength <= _transmit_buffer->space() ){
+		return true;
+	}
+	service();
+	if( packetLength > 0xffff ){
+		return false;
+	}
+	return _transmit_buffer->hasSpace( (uint16_t)packetLength );
+}
+
+/**
+*  Method: parseByte(uint8_t byte)
+*  @ Since v0.1.2, October 2026
+*  @ Adds one byte received from the XBee radio to the incoming packet. Returns true if the packet was 
+*    completely received or if an error was found that ended the packet.
+*    In Escaped API Mode (ATAP=2), the byte is passed straight to parsePacketByte(). In API Mode (ATAP=1),
+*    a START byte inside a packet is just another byte, so a packet that begins inside a corrupted packet
+*    would normally be lost with it. To avoid this, the bytes of the current packet are also kept in a 
+*    lookback window. When the packet ends with an error, the window is searched for the next START byte 
+*    and the bytes from that point are parsed again (see resync()). Bytes waiting to be parsed again are 
+*    handled before the new byte. The window is only used if a buffer has been set with setResyncBuffer().
+*    Without it, a START byte found after a failed packet begins a new packet, but a packet that began 
+*    inside the failed packet is lost.
+*  @ param uint8_t byte: Byte received from the XBee radio
+*/
+bool SimpleZigBeeRadio::parseByte(uint8_t byte){
+	if( false == _escaped_mode && NULL != _resync_buffer ){
+		storeResyncBytes( &byte, 1 );
+		return parsePending();
+	}
+	return parsePacketByte( byte );
+}
+
+/**
+*  Method: parsePending()
+*  @ Since v0.1.2, October 2026
+*  @ API Mode (ATAP=1) only. Parses the bytes in the lookback window that have not been parsed yet. Stops 
+*    and returns true as soon as a packet is completely received or an error ends the packet, leaving 
+*    the remaining bytes for the next call. Returns false if all of the bytes have been parsed (always, if
+*    no buffer has been set with setResyncBuffer()).
+*/
+bool SimpleZigBeeRadio::parsePending(){
+	while( _resync_parsed < _resync_length ){
+		bool done = parsePacketByte( _resync_buffer[_resync_parsed++] );
+		if( done && _incoming_packet.isError() ){
+			resync();
+			return true;
+		}
+		// Once a packet is complete (or the byte was not part of a packet), the bytes are not needed anymore
+		if( done || 0 == _in_index ){
+			discardResyncBytes( _resync_parsed );
+		}
+		if( done ){
+			return true;
+		}
+	}
+	return false;
+}
 
+/**
+*  Method: resync()
+*  @ Since v0.1.2, October 2026
+*  @ API Mode (ATAP=1) only. Called when the incoming packet ended with an error. Searches the lookback window 
+*    for the first START byte after the START of the failed packet. The bytes before it are discarded and 
+*    the rest will be parsed again by parsePending(), so a packet that started inside the failed packet 
+*    is still received. If there is no other START byte, the bytes of the failed packet are discarded.
+*/
+void SimpleZigBeeRadio::resync(){
+	// Skip the first byte, which is the START byte of the failed packet (unless the packet was longer than 
+	// the window and its first bytes have been discarded)
+	int next = _resync_parsed;
+	if( 1 < _resync_parsed ){
+		const uint8_t* found = (const uint8_t*)memchr( _resync_buffer + 1, START, _resync_parsed - 1 );
+		if( NULL != found ){
+			next = found - _resync_buffer;
+		}
+	}
+	discardResyncBytes( next );
+	// Parse the remaining bytes again
+	_resync_parsed = 0;
+}
+
+/**
+*  Method: storeResyncBytes(const uint8_t* data, size_t length)
+*  @ Since v0.1.2, October 2026
+*  @ API Mode (ATAP=1) only. Adds bytes to the end of the lookback window. If the window is full, the oldest
+*    bytes of the current packet are discarded (only packets longer than the buffer set by setResyncBuffer()
+*    are affected, and the resync will just have fewer bytes to search).
+*  @ param const uint8_t* data: Pointer to array of received bytes
+*  @ param size_t length: Number of bytes in array
+*/
+void SimpleZigBeeRadio::storeResyncBytes(const uint8_t* data, size_t length){
+	if( length > (size_t)_resync_size ){
+		// Only called with a long run of frame data when there are no bytes waiting to be parsed again
+		data += length - _resync_size;
+		length = _resync_size;
+		discardResyncBytes( _resync_parsed );
+	}else if( _resync_length + length > (size_t)_resync_size ){
+		// Discard at least half of the window so that this does not happen for every byte
+		int count = _resync_length + length - _resync_size;
+		if( count < _resync_size/2 ){
+			count = _resync_size/2;
+		}
+		if( count > _resync_parsed ){
+			count = _resync_parsed;
+		}
+		discardResyncBytes( count );
+	}
+	memcpy( _resync_buffer + _resync_length, data, length );
+	_resync_length += length;
+}
+
+/**
+*  Method: discardResyncBytes(int count)
+*  @ Since v0.1.2, October 2026
+*  @ Removes bytes from the start of the lookback window. Only bytes that have already been parsed are removed.
+*  @ param int count: Number of bytes to remove
+*/
+void SimpleZigBeeRadio::discardResyncBytes(int count){
+	if( count <= 0 ){
+		return;
+	}
+	if( count < _resync_length ){
+		memmove( _resync_buffer, _resync_buffer + count, _resync_length - count );
+	}
+	_resync_length -= count;
+	_resync_parsed -= count;
+}
+
+/**
+*  Method: getMinFrameLength(uint8_t frameType)
+*  @ Since v0.1.2, October 2026
+*  @ Returns the smallest frame length of a packet of the given frame type, or 0 if the frame type is not
+*    one that the XBee radio (or another Arduino using this library) sends. Used in API Mode (ATAP=1) to reject false START bytes.
+*  @ param uint8_t frameType: Frame type (first byte of frame data)
+*/
+int SimpleZigBeeRadio::getMinFrameLength(uint8_t frameType){
+	switch( frameType ){
+		// Frame types with a layout in SimpleZigBeeFrames.h
+		case AT_COMMAND_RESPONSE: return SimpleZigBeeAtResponseLayout::MIN_FRAME_LENGTH;
+		case MODEM_STATUS: return SimpleZigBeeModemStatusLayout::MIN_FRAME_LENGTH;
+		case ZIGBEE_TX_STATUS: return SimpleZigBeeTxStatusLayout::MIN_FRAME_LENGTH;
+		case ZIGBEE_RECIEVED_PACKET: return SimpleZigBeeRxLayout::MIN_FRAME_LENGTH;
+		case REMOTE_AT_COMMAND_RESPONSE: return SimpleZigBeeRemoteAtResponseLayout::MIN_FRAME_LENGTH;
+		// ZigBee RX packet plus Endpoints (2 bytes), Cluster ID (2 bytes) and Profile ID (2 bytes)
+		case ZIGBEE_EXPLICIT_RX_INDICATOR: return SimpleZigBeeRxLayout::MIN_FRAME_LENGTH + 6;
+		// ZigBee RX packet plus Number of Samples, Digital Mask (2 bytes) and Analog Mask
+		case ZIGBEE_IO_RX_INDICATOR: return SimpleZigBeeRxLayout::MIN_FRAME_LENGTH + 4;
+		// ZigBee RX packet plus 1-Wire Sensors, A/D Values (8 bytes) and Temperature (2 bytes)
+		case XBEE_SENSOR_READ_INDICATOR: return SimpleZigBeeRxLayout::MIN_FRAME_LENGTH + 11;
+		// Frame Type, 64-bit Address, 16-bit Address, Options, Remote Addresses (10 bytes), Node Identifier (at least 
+		// the null character), Parent Address (2 bytes), Device Type, Source Event, Profile ID (2 bytes), Manufacturer ID (2 bytes)
+		case NODE_INDENTIFICATION_INDICATOR: return 31;
+		// Frame Type, 64-bit Address, 16-bit Address, Options, Message Type, Block Number, Target Address (8 bytes)
+		case OTA_FIRMWARE_UPDATE_STATUS: return 22;
+		case ROUTE_RECORD_INDICATOR: return SimpleZigBeeRouteRecordLayout::MIN_FRAME_LENGTH;
+		// Frame Type, 64-bit Address, 16-bit Address, Reserved
+		case MANY_TO_ONE_ROUTE_REQUEST_INDICATOR: return 12;
+		// Packets sent to the XBee are accepted so that two Arduinos can be connected directly
+		case AT_COMMAND: return SimpleZigBeeAtCommandLayout::MIN_FRAME_LENGTH;
+		case AT_COMMAND_QUEUED: return SimpleZigBeeAtCommandLayout::MIN_FRAME_LENGTH;
+		case ZIGBEE_TRANSMIT_REQUEST: return SimpleZigBeeTxRequestLayout::MIN_FRAME_LENGTH;
+		// ZigBee TX request plus Endpoints (2 bytes), Cluster ID (2 bytes) and Profile ID (2 bytes)
+		case ZIGBEE_EXPLICIT_ADDRESSING_COMMAND_FRAME: return SimpleZigBeeTxRequestLayout::MIN_FRAME_LENGTH + 6;
+		case REMOTE_AT_COMMAND: return SimpleZigBeeRemoteAtCommandLayout::MIN_FRAME_LENGTH;
+		case CREATE_SOURCE_ROUTE: return SimpleZigBeeCreateSourceRouteLayout::MIN_FRAME_LENGTH;
+	}
+	return 0;
+}
+
+/**
+*  Method: parsePacketByte(uint8_t byte)
+*  @ Since v0.1.2, October 2026
+*  @ Adds one byte to the incoming packet. Code moved from read() (v0.1.0 by Eric Burger, September 2013).
+*    Returns true if the packet was completely received or if an error was found that ended the packet.
+*    The frame length is checked against the maximum frame length as soon as it is received. Packets with
+*    a frame length up to (and including) the maximum frame length are accepted. In API Mode (ATAP=1), the
+*    frame type and frame length are also checked against getMinFrameLength() before the rest of the packet is stored.
+*    If a payload sink is set, RX packets longer than the maximum frame length are accepted and their payload
+*    is streamed to the sink (see setPayloadSink()).
+*  @ param uint8_t byte: Byte received from the XBee radio
+*/
+bool SimpleZigBeeRadio::parsePacketByte(uint8_t byte){
+	// Before receiving a new packet, reset incoming packet object, if necessary
+	if( _incoming_packet.isError() || isComplete() ){
+		// Store error code before resetting
+		int err = _incoming_packet.getErrorCode();
+		// If the previous packet was completely received or contained an error, reset.
+		resetIncoming();
+		// If error was caused by UNEXPECTED_PACKET_START, set current index to 1 since the START byte has already been read.
+		if( UNEXPECTED_PACKET_START == err ){
+			_in_index = 1;
+		}
+	}
+	// Otherwise, if the previous packet was incomplete but free of errors, try and receive the rest of the packet.
+	
+	// First, check if XBee is in Escaped API Mode (ATAP=2)
+	if ( true == _escaped_mode ) {
+		// Next, check if a (non-escaped) start frame delimiter is found anywhere other than the start of the packet.
+		if ( START == byte && _in_index > 0  ) {
+			// AN ERROR OCCURED
+			// If found, it means that a new packet has started before the previous packet was completely received.
+			// This may indicate a noisy environment or that the buffer overflowed when the previous packet was being 
+			// received by the XBee.
+			// Set error message and return. When the next byte is parsed, packet object will be reset but current index will be set to 1.
+			_incoming_packet.setErrorCode( UNEXPECTED_PACKET_START );
+			if ( true == _in_streaming ) {
+				endStream();
 			}
-			// Note that if the XBee is not in Escaped API Mode (ATAP=2) and the start delimiter is found in a position other than the beginning of a packet,
-			// it is not treated as the start of a packet. In this case, it is treated as just another byte. This can lead to trouble when radios
-			// are placed in a noisy environment.
-			// For reference: http://www.digi.com/support/kbase/kbaseresultdetl?id=2199
-			
-			// All bytes starting with the Frame Type are included in the checksum
-			if ( _in_index >= FRAME_TYPE_INDEX ) {
-				_in_checksum += _in_byte;
+			return true;
+		}
+		
+		if ( true == isEscaping() ) {
+			// If byte has been flagged as escaped, "un-escape" the byte using the "Excusive bitwise OR" operator (^) 
+			byte = 0x20 ^ byte;
+			setEscaping(false);
+		}else if ( ESCAPE == byte && _in_index > 0 ) {
+			// Check if current byte is escape byte. If true, this indicates that the next byte in the packet has been escaped.
+			// Note that the escaped byte may not have been received yet, so wait for the next call.
+			setEscaping(true);
+			return false;
+		}
+	}
+	// Note that if the XBee is not in Escaped API Mode (ATAP=2) and the start delimiter is found in a position other than the beginning of a packet,
+	// it is not treated as the start of a packet. In this case, it is treated as just another byte. This can lead to trouble when radios
+	// are placed in a noisy environment.
+	// For reference: http://www.digi.com/support/kbase/kbaseresultdetl?id=2199
+	
+	// All bytes starting with the Frame Type are included in the checksum
+	if ( _in_index >= FRAME_TYPE_INDEX ) {
+		_in_checksum += byte;
+	}
+	
+	// Start storing incoming information in _incoming_packet object
+	if ( 0 == _in_index ){
+		if ( START == byte ) {
+			// There is nothing to do with the start byte, so move unto the next position.
+			_in_index++;
+		}else{
+			// AN ERROR OCCURED
+			// If START byte was not found, set error code indicating that packet was not read correctly
+			_incoming_packet.setErrorCode( PACKET_INCOMPLETE );
+		}
+	}else if( 1 == _in_index ){
+		// Store "Most Significant Byte" of packet's length
+		_incoming_packet.setFrameLengthMSB(byte);
+		_in_index++;
+	}else if( 2 == _in_index ){
+		// Store "Least Significant Byte" of packet's length
+		_incoming_packet.setFrameLengthLSB(byte);
+		_in_index++;
+		// A packet that is longer than the maximum frame length cannot be stored, so stop now rather than
+		// after the maximum frame length has been received. In API Mode (ATAP=1), this is usually a false START.
+		// Unless a payload sink is set, in which case the payload of an RX packet will be streamed to it.
+		if ( _incoming_packet.getFrameLength() > _incoming_packet.getMaxFrameLength() ) {
+			if ( NULL == _payload_sink || _incoming_packet.getFrameLength() > SIMPLE_ZIGBEE_MAX_STREAM_FRAME_LENGTH
+					|| _incoming_packet.getMaxFrameLength() <= SimpleZigBeeRxLayout::PAYLOAD_INDEX ) {
+				// AN ERROR OCCURED
+				_incoming_packet.setErrorCode( MAX_FRAME_LENGTH_EXCEEDED );
+				return true;
 			}
-			
-			// Start storing incoming information in _incoming_packet object
-			if ( 0 == _in_index ){
-				if ( START == _in_byte ) {
-					// There is nothing to do with the start byte, so move unto the next position.
-					_in_index++;
-				}else{
-					// AN ERROR OCCURED
-					// If START byte was not found, set error code indicating that packet was not read correctly
-					_incoming_packet.setErrorCode( PACKET_INCOMPLETE );
-				}
-			}else if( 1 == _in_index ){
-				// Store "Most Significant Byte" of packet's length
-				_incoming_packet.setFrameLengthMSB(_in_byte);
-				_in_index++;
-			}else if( 2 == _in_index ){
-				// Store "Least Significant Byte" of packet's length
-				_incoming_packet.setFrameLengthLSB(_in_byte);
-				_in_index++;
+			_in_streaming = true;
+		}
+		// Every packet contains at least the frame type
+		if ( 0 == _incoming_packet.getFrameLength() ) {
+			// AN ERROR OCCURED
+			_incoming_packet.setErrorCode( INVALID_FRAME_LENGTH );
+			return true;
+		}
+	}else if( FRAME_TYPE_INDEX == _in_index && false == _escaped_mode ){
+		// In API Mode (ATAP=1), a START byte may be part of the data of another packet. Before storing the rest 
+		// of the packet, check that the XBee could have sent a packet of this frame type and frame length.
+		int minFrameLength = getMinFrameLength( byte );
+		if ( 0 == minFrameLength ) {
+			// AN ERROR OCCURED
+			_incoming_packet.setErrorCode( INVALID_FRAME_TYPE );
+			return true;
+		}
+		if ( _incoming_packet.getFrameLength() < minFrameLength ) {
+			// AN ERROR OCCURED
+			_incoming_packet.setErrorCode( INVALID_FRAME_LENGTH );
+			return true;
+		}
+		// Only RX packets can be streamed
+		if ( true == _in_streaming && ZIGBEE_RECIEVED_PACKET != byte ) {
+			// AN ERROR OCCURED
+			_incoming_packet.setErrorCode( MAX_FRAME_LENGTH_EXCEEDED );
+			return true;
+		}
+		_incoming_packet.setFrameData( 0, byte );
+		_in_index++;
+	}else{
+		// Only RX packets can be streamed
+		if ( true == _in_streaming && FRAME_TYPE_INDEX == _in_index && ZIGBEE_RECIEVED_PACKET != byte ) {
+			// AN ERROR OCCURED
+			_incoming_packet.setErrorCode( MAX_FRAME_LENGTH_EXCEEDED );
+			return true;
+		}
+		// For the remaining bytes in the packet, check that the maximum frame length has not been exceeded...
+		if ( false == _in_streaming && (_in_index - FRAME_TYPE_INDEX) >= _incoming_packet.getMaxFrameLength() && (_incoming_packet.getFrameLength() + 3) != _in_index ) {
+			// AN ERROR OCCURED
+			_incoming_packet.setErrorCode( MAX_FRAME_LENGTH_EXCEEDED );
+			return true;
+		}
+		// ...Then check if the end of the packet has been reached (which should be the checksum).
+		// Note: When setFrameLengthLSB() was last called, the frame length of the incoming packet was updated
+		// based on the MSB and LSB. Therefore, the frame length should not have increased due to calls to
+		// setOutgoingFrameData(). 
+		// This length does not include the start byte, MSB, LSB, or checksum byte. Therefore, the length
+		// plus 3 should be the position of the checksum (i.e. frame length plus 4 minus 1).
+		if ( (_incoming_packet.getFrameLength() + 3) == _in_index ) {
+			// Verify checksum using the bitwise AND operator (&)
+			if ( 0xff == (_in_checksum & 0xff) && true == _in_streaming ) {
+				// The payload has already been passed to the payload sink, so only the verdict is left. The 
+				// packet is then reset, since it does not hold the payload.
+				_incoming_packet.setErrorCode( NO_ERROR );
+				endStream();
+				resetIncoming();
+			}else if ( 0xff == (_in_checksum & 0xff) ) {
+				// Success!!! The packet was completely received and the checksum verified.
+				setComplete(true);
+				_incoming_packet.setChecksum(_in_checksum);
+				_incoming_packet.setErrorCode( NO_ERROR );
+				frameReceived();
 			}else{
-				// For the remaining bytes in the packet, check that the maximum frame length has not been exceeded...
-				if ( _in_index > _incoming_packet.getMaxFrameLength() ) {
-					// AN ERROR OCCURED
-					_incoming_packet.setErrorCode( MAX_FRAME_LENGTH_EXCEEDED );
-					return;
+				// Failure!!! The packet is not usable because the checksum failed.
+				// AN ERROR OCCURED 
+				_incoming_packet.setErrorCode( CHECKSUM_FAILURE );
+				if ( true == _in_streaming ) {
+					endStream();
 				}
-				// ...Then check if the end of the packet has been reached (which should be the checksum).
-				// Note: When setFrameLengthLSB() was last called, the frame length of the incoming packet was updated
-				// based on the MSB and LSB. Therefore, the frame length should not have increased due to calls to
-				// setOutgoingFrameData(). 
-				// This length does not include the start byte, MSB, LSB, or checksum byte. Therefore, the length
-				// plus 3 should be the position of the checksum (i.e. frame length plus 4 minus 1).
-				if ( (_incoming_packet.getFrameLength() + 3) == _in_index ) {
-					// Verify checksum using the bitwise AND operator (&)
-					if ( 0xff == (_in_checksum & 0xff) ) {
-						// Success!!! The packet was completely received and the checksum verified.
-						setComplete(true);
-						_incoming_packet.setChecksum(_in_checksum);
-						_incoming_packet.setErrorCode( NO_ERROR );
-					}else{
-						// Failure!!! The packet is not usable because the checksum failed.
-						// AN ERROR OCCURED 
-						_incoming_packet.setErrorCode( CHECKSUM_FAILURE );
-						return;
-					}
-					
-					
-					// TODO: Process packet?
-					
-					
-					return;
-				}
-				
-				// Otherwise, beginning with Packet index 3 (Frame index 0), store byte is FrameData array.
-				// Frame index 0 should contain the Frame Type
-				_incoming_packet.setFrameData( (_in_index - FRAME_TYPE_INDEX) , _in_byte);
-				_in_index++;
-			}    
+			}
+			return true;
 		}
-	}	
+		
+		// The payload of a streamed packet is passed to the payload sink
+		if ( true == _in_streaming && (_in_index - FRAME_TYPE_INDEX) >= SimpleZigBeeRxLayout::PAYLOAD_INDEX ) {
+			streamPayload( &byte, 1 );
+			_in_index++;
+			return false;
+		}
+		
+		// Otherwise, beginning with Packet index 3 (Frame index 0), store byte is FrameData array.
+		// Frame index 0 should contain the Frame Type
+		_incoming_packet.setFrameData( (_in_index - FRAME_TYPE_INDEX) , byte);
+		_in_index++;
+	}
+	return false;
+}
+
+/**
+*  Method: frameReceived()
+*  @ Since v0.1.2, October 2026
+*  @ Called by parsePacketByte() once the incoming packet has been completely received and the checksum verified.
+*    The packet is matched with its request (if a request table is set), passed to the address cache and the
+*    route cache (if set), and matched with its stored TX request and its destination in the retransmitter
+*    and the scheduler (if set). A fragment or packed packet is then passed to the fragmenter or coalescer
+*    (if set) and nothing else. Otherwise, the packet is copied to the frame queue (if set), the frame 
+*    callback is called (if set) and then the dispatcher handler for the frame type (if set and there is no
+*    frame queue, see poll()).
+*    In asynchronous receive mode (see setAsyncReceive()), this may run in an interrupt or a reader thread, so the
+*    packet is only copied to the frame queue. Everything else is done by poll() in the program.
+*/
+void SimpleZigBeeRadio::frameReceived(){
+	if( true == _async_receive ){
+		const uint8_t* frameData = _incoming_packet.getFrameDataPointer();
+		if( NULL != frameData ){
+			_frame_queue->push( frameData, _incoming_packet.getFrameLength() );
+		}
+		return;
+	}
+	if( NULL != _request_table ){
+		_request_table->complete( _incoming_packet );
+	}
+	if( NULL != _address_cache ){
+		_address_cache->packetReceived( _incoming_packet );
+	}
+	if( NULL != _route_cache ){
+		_route_cache->packetReceived( _incoming_packet );
+	}
+	if( NULL != _retransmitter ){
+		_retransmitter->statusReceived( _incoming_packet );
+	}
+	if( NULL != _scheduler ){
+		_scheduler->packetReceived( _incoming_packet );
+	}
+	// Fragments and packed messages are only passed on as messages
+	if( NULL != _fragmenter && _fragmenter->packetReceived( _incoming_packet ) ){
+		return;
+	}
+	if( NULL != _coalescer && _coalescer->packetReceived( _incoming_packet ) ){
+		return;
+	}
+	if( NULL != _frame_queue ){
+		const uint8_t* frameData = _incoming_packet.getFrameDataPointer();
+		if( NULL != frameData ){
+			_frame_queue->push( frameData, _incoming_packet.getFrameLength() );
+		}
+	}
+	if( NULL != _frame_callback ){
+		_frame_callback( _incoming_packet );
+	}
+	if( NULL != _dispatcher && NULL == _frame_queue ){
+		_dispatcher->dispatch( _incoming_packet );
+	}
+}
+
+/**
+*  Method: handleQueuedFrames()
+*  @ Since v0.1.2, October 2026
+*  @ Used by poll() in asynchronous receive mode. Handles each packet in the frame queue like frameReceived()
+*    does in the normal mode: the packet is matched with its request, passed to the address cache and the 
+*    route cache, and matched in the retransmitter and the scheduler (each if set). Then a fragment or packed
+*    packet is passed to the fragmenter or coalescer (if set), and any other packet to the frame callback and
+*    the dispatcher (if set). The packets are handled where they are stored in the queue (see 
+*    SimpleZigBeePacketRef), so they are not copied. Returns the number of packets that were handled.
+*/
+int SimpleZigBeeRadio::handleQueuedFrames(){
+	int frames = 0;
+	const uint8_t* frameData;
+	while( NULL != (frameData = _frame_queue->peekFrameData()) ){
+		// The slot belongs to the program until pop(), so the packet can use it directly
+		SimpleZigBeePacketRef<SimpleIncomingZigBeePacket> packet( (uint8_t*)frameData, _frame_queue->peekFrameLength() );
+		if( NULL != _request_table ){
+			_request_table->complete( packet );
+		}
+		if( NULL != _address_cache ){
+			_address_cache->packetReceived( packet );
+		}
+		if( NULL != _route_cache ){
+			_route_cache->packetReceived( packet );
+		}
+		if( NULL != _retransmitter ){
+			_retransmitter->statusReceived( packet );
+		}
+		if( NULL != _scheduler ){
+			_scheduler->packetReceived( packet );
+		}
+		if( (NULL != _fragmenter && _fragmenter->packetReceived( packet )) || (NULL != _coalescer && _coalescer->packetReceived( packet )) ){
+			_frame_queue->pop();
+			frames++;
+			continue;
+		}
+		if( NULL != _frame_callback ){
+			_frame_callback( packet );
+		}
+		if( NULL != _dispatcher ){
+			_dispatcher->dispatch( packet );
+		}
+		_frame_queue->pop();
+		frames++;
+	}
+	return frames;
 }
 
 /**
@@ -706,18 +1721,34 @@ void SimpleZigBeeRadio::saveLastFrameID(uint8_t frameID){
 	_out_frame_id = frameID;
 }
 
+/**
+*  Method: getNextFrameID()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the frame ID that follows the last frame ID (1 to 255). If a request table is set, frame IDs 
+*    that are still waiting for a response are skipped, and 0 is returned if no frame ID is free.
+*/
+uint8_t SimpleZigBeeRadio::getNextFrameID(){
+	uint8_t prev = getLastFrameID();
+	if( NULL != _request_table ){
+		return _request_table->getNextFrameID( prev );
+	}
+	return ((prev)%255 + 1) ;
+}
+
 /**
 *  Method: setNextFrameID()
 *  @ Since v0.1.0 by Eric Burger, August 2013
 *  @ Sets frame ID (Packet index 4, Frame Index 1)
 *      If acknowledgement requested, increment frame id using mod operator and set value. Otherwise, set 0.
 *      Note: Maximum value stored in a byte is 255.
+*  @ Last Modified v0.1.2 by Eric Burger, October 2026
+*  @ Changlog for v0.1.2:
+*       - If a request table is set, frame IDs that are still waiting for a response are skipped
 */
 void SimpleZigBeeRadio::setNextFrameID(){
 	uint8_t id = 0;
 	if( _out_acknowledgement == true ){
-		uint8_t prev = getLastFrameID();
-		id = ((prev)%255 + 1) ;
+		id = getNextFrameID();
 	}
 	setOutgoingFrameID( id );
 }
@@ -794,10 +1825,20 @@ void SimpleZigBeeRadio::setOutgoingAddress16(uint16_t adr16){
 *  Method: send()
 *  @ Since v0.1.0 by Eric Burger, September 2013
 *  @ Send packet to serial port based on _outgoing_packet object
+*  @ Last Modified v0.1.2 by Eric Burger, October 2026
+*  @ Changlog for v0.1.2:
+*       - The request is recorded in the request table (if set)
+*       - Returns false if the packet was not sent (see send(SimpleZigBeePacket & packet))
+*       - Returns false without sending if acknowledgement is on and setNextFrameID() found no free frame ID 
+*         in the request table, since the request could not be matched with its response
 */ 
-void SimpleZigBeeRadio::send(){
-	saveLastFrameID( _outgoing_packet.getFrameID() ); // Record frame ID
-	sendPacket(_outgoing_packet);
+bool SimpleZigBeeRadio::send(){
+	uint8_t id = _outgoing_packet.getFrameID();
+	if( _out_acknowledgement == true && NULL != _request_table && 0 == id ){
+		return false;
+	}
+	saveLastFrameID( id ); // Record frame ID
+	return send(_outgoing_packet);
 }
 
 /**
@@ -805,9 +1846,63 @@ void SimpleZigBeeRadio::send(){
 *  @ Since v0.1.0 by Eric Burger, September 2013
 *  @ Send packet to serial port based on input Packet object
 *  @ param SimpleZigBeePacket & packet: Pointer to packet object
+*  @ Last Modified v0.1.2 by Eric Burger, October 2026
+*  @ Changlog for v0.1.2:
+*       - The request is recorded in the request table (if set)
+*       - TX requests are stored in the retransmitter (if set)
+*       - Returns false if the transmit buffer (if set) has no room for the packet. Then nothing is sent or recorded.
+*       - Requests with an unknown 16-bit address are given the address from the address cache (if set)
+*       - Requests to a device with a known route are preceded by a Create Source Route frame (if a route cache is set)
+*       - Small TX requests are packed by the coalescer (if set) and sent later by poll(). Retries from the 
+*         retransmitter and requests sent by the scheduler are never packed. Returns false if the waiting 
+*         messages to the same destination had to be sent first and could not be.
+*       - Requests to other devices are queued in the scheduler (if set) and sent later by poll()
+*       - TX requests whose payload starts with the fragment marker are sent as a message of one fragment 
+*         (if a fragmenter is set), so that the receiving radio does not mistake them for a fragment. Those that
+*         are not packed and start with the bundle marker are sent as a packed TX request of one message (if a 
+*         coalescer is set).
 */  
-void SimpleZigBeeRadio::send(SimpleZigBeePacket & packet){
-	sendPacket(packet);
+bool SimpleZigBeeRadio::send(SimpleZigBeePacket & packet){
+	// Retries and queued requests have already been offered to the coalescer
+	bool resent = (NULL != _retransmitter && _retransmitter->isResending()) || (NULL != _scheduler && _scheduler->isSending());
+	if( NULL != _coalescer && !resent ){
+		uint8_t coalesced = _coalescer->coalesce( *this, packet );
+		if( COALESCE_NOT_PACKED != coalesced ){
+			return COALESCE_PACKED == coalesced;
+		}
+	}
+	uint8_t marker = getMarkerToFrame( packet.getFrameDataPointer(), packet.getFrameLength(), NULL, 0 );
+	if( 0 != marker ){
+		if( NULL != _address_cache ){
+			_address_cache->fill(packet);
+		}
+		return sendMarkerFramed( marker, packet.getFrameDataPointer(), packet.getFrameLength(), NULL, 0 );
+	}
+	if( isScheduled( packet.getFrameDataPointer(), packet.getFrameLength() ) ){
+		return _scheduler->enqueue( packet );
+	}
+	uint8_t route[SIMPLE_ZIGBEE_MAX_SOURCE_ROUTE_FRAME_LENGTH];
+	int routeLength = 0;
+	if( NULL != _route_cache ){
+		routeLength = _route_cache->prepareSourceRoute( packet.getFrameDataPointer(), packet.getFrameLength(), route );
+	}
+	// Both packets must fit (the extra START, length and checksum bytes of the route frame are counted too)
+	if( !canWrite( packet.getFrameLength() + (routeLength > 0 ? routeLength + 4 : 0) ) ){
+		return false;
+	}
+	if( NULL != _address_cache ){
+		_address_cache->fill(packet);
+	}
+	if( routeLength > 0 ){
+		sendSourceRoute( route, routeLength );
+	}
+	if( NULL != _request_table ){
+		_request_table->begin(packet);
+	}
+	if( NULL != _retransmitter ){
+		_retransmitter->store(packet);
+	}
+	return sendPacket(packet);
 }
 
 /**
@@ -815,22 +1910,328 @@ void SimpleZigBeeRadio::send(SimpleZigBeePacket & packet){
 *  @ Since v0.1.0 by Eric Burger, September 2013
 *  @ Send packet to serial port
 *  @ param SimpleZigBeePacket & p: Pointer to packet object 
-*/
-void SimpleZigBeeRadio::sendPacket(SimpleZigBeePacket & p){
+*  @ Last Modified v0.1.2 by Eric Burger, October 2026
+*  @ Changlog for v0.1.2:
+*       - The packet is escaped into a buffer (see beginFrame(), writeFrameData() and endFrame()) and 
+*         written to the serial port with one call to Stream::write(), instead of one call per byte
+*       - The serial port is only flushed if the flush policy is FLUSH_EACH_PACKET and no batch is open 
+*         (see setFlushPolicy() and beginBatch())
+*       - If a transmit buffer is set, the packet is added to the buffer and the method returns without
+*         waiting for the serial port. Returns false if the buffer has no room for the packet.
+*/
+bool SimpleZigBeeRadio::sendPacket(SimpleZigBeePacket & p){
+	if( !canWrite( p.getFrameLength() ) ){
+		return false;
+	}
 	// Everything should be ready to go, so write it to the serial port...
-	write( START );
-	writeByte( p.getLengthMSB() );
-	writeByte( p.getLengthLSB() );
+	beginFrame( p.getFrameLength() );
 	// Frame Type and Frame ID are stored in Frame Data
-	uint8_t checksum = 0;
-	for( int i=0; i<p.getFrameLength(); i++){
-		writeByte(p.getFrameData(i));
-		checksum += p.getFrameData(i); 
+	const uint8_t* frameData = p.getFrameDataPointer();
+	if( NULL != frameData ){
+		writeFrameData( frameData, p.getFrameLength() );
+	}else{
+		for( int i=0; i<p.getFrameLength(); i++){
+			uint8_t byte = p.getFrameData(i);
+			writeFrameData( &byte, 1 );
+		}
+	}
+	endFrame();
+	return true;
+}
+
+/**
+*  Method: sendFrame(const uint8_t* header, int headerLength, const SimpleZigBeeSegment* segments, uint8_t segmentCount)
+*  @ Since v0.1.2, October 2026
+*  @ Sends a packet whose frame data is the header followed by each segment. The segments are escaped
+*    and added to the checksum straight from the caller's memory, so the payload is never copied into a
+*    packet object. Like send(), the request is recorded in the request table and stored in the 
+*    retransmitter (if set), is preceded by a Create Source Route frame if the route cache (if set) has a 
+*    route to the destination, and false is returned if the transmit buffer (if set) has no room for the packet.
+*    If a scheduler is set, a request to another device is copied into its queue instead and sent later by poll().
+*    Like send(), a TX request whose payload starts with the fragment or bundle marker is framed first (see getMarkerToFrame()).
+*  @ param const uint8_t* header: Frame data up to the payload (starting with the frame type)
+*  @ param int headerLength: Number of bytes in header
+*  @ param const SimpleZigBeeSegment* segments: Array of payload segments (may be NULL if segmentCount is 0)
+*  @ param uint8_t segmentCount: Number of segments
+*/
+bool SimpleZigBeeRadio::sendFrame(const uint8_t* header, int headerLength, const SimpleZigBeeSegment* segments, uint8_t segmentCount){
+	uint8_t marker = getMarkerToFrame( header, headerLength, segments, segmentCount );
+	if( 0 != marker ){
+		return sendMarkerFramed( marker, header, headerLength, segments, segmentCount );
+	}
+	return sendSegments( header, headerLength, segments, segmentCount );
+}
+
+/**
+*  Method: sendSegments(const uint8_t* header, int headerLength, const SimpleZigBeeSegment* segments, uint8_t segmentCount)
+*  @ Since v0.1.2, October 2026
+*  @ Sends (or queues in the scheduler) a packet whose frame data is the header followed by each segment,
+*    without framing its payload (see sendFrame()).
+*  @ param const uint8_t* header: Frame data up to the payload (starting with the frame type)
+*  @ param int headerLength: Number of bytes in header
+*  @ param const SimpleZigBeeSegment* segments: Array of payload segments (may be NULL if segmentCount is 0)
+*  @ param uint8_t segmentCount: Number of segments
+*/
+bool SimpleZigBeeRadio::sendSegments(const uint8_t* header, int headerLength, const SimpleZigBeeSegment* segments, uint8_t segmentCount){
+	if( isScheduled( header, headerLength ) ){
+		return _scheduler->enqueue( header, headerLength, segments, segmentCount, _scheduler->getPriority() );
+	}
+	int frameLength = headerLength;
+	for( uint8_t i = 0; i < segmentCount; i++ ){
+		frameLength += segments[i].length;
+	}
+	uint8_t route[SIMPLE_ZIGBEE_MAX_SOURCE_ROUTE_FRAME_LENGTH];
+	int routeLength = 0;
+	if( NULL != _route_cache ){
+		routeLength = _route_cache->prepareSourceRoute( header, headerLength, route );
+	}
+	if( !canWrite( frameLength + (routeLength > 0 ? routeLength + 4 : 0) ) ){
+		return false;
+	}
+	if( routeLength > 0 ){
+		sendSourceRoute( route, routeLength );
+	}
+	if( NULL != _request_table ){
+		_request_table->begin( header, headerLength );
+	}
+	if( NULL != _retransmitter ){
+		_retransmitter->store( header, headerLength, segments, segmentCount );
+	}
+	beginFrame( frameLength );
+	writeFrameData( header, headerLength );
+	for( uint8_t i = 0; i < segmentCount; i++ ){
+		writeFrameData( segments[i].data, segments[i].length );
+	}
+	endFrame();
+	return true;
+}
+
+/**
+*  Method: sendSourceRoute(const uint8_t* routeFrameData, int routeLength)
+*  @ Since v0.1.2, October 2026
+*  @ Sends a Create Source Route frame prepared by the route cache, just before the request it was prepared 
+*    for, and tells the cache that the XBee radio has the route. The caller has checked canWrite() for both.
+*  @ param const uint8_t* routeFrameData: Frame data of the Create Source Route frame
+*  @ param int routeLength: Number of bytes of frame data
+*/
+void SimpleZigBeeRadio::sendSourceRoute(const uint8_t* routeFrameData, int routeLength){
+	beginFrame( routeLength );
+	writeFrameData( routeFrameData, routeLength );
+	endFrame();
+	_route_cache->sourceRouteSent( routeFrameData );
+}
+
+/**
+*  Method: isScheduled(const uint8_t* frameData, int frameLength)
+*  @ Since v0.1.2, October 2026
+*  @ Returns true if a request must be queued in the scheduler instead of sent: a scheduler is set, the request
+*    goes to another device (see SimpleZigBeeScheduler::isSchedulable()) and it is neither sent by the 
+*    scheduler itself nor a retry from the retransmitter.
+*  @ param const uint8_t* frameData: Frame data of the request (may be NULL)
+*  @ param int frameLength: Number of bytes of frame data
+*/
+bool SimpleZigBeeRadio::isScheduled(const uint8_t* frameData, int frameLength){
+	if( NULL == _scheduler || _scheduler->isSending() || (NULL != _retransmitter && _retransmitter->isResending()) ){
+		return false;
+	}
+	return SimpleZigBeeScheduler::isSchedulable( frameData, frameLength );
+}
+
+/**
+*  Method: getMarkerToFrame(const uint8_t* header, int headerLength, const SimpleZigBeeSegment* segments, uint8_t segmentCount)
+*  @ Since v0.1.2, October 2026
+*  @ Returns the marker byte that a TX request's payload starts with if the receiving radio would take it for
+*    a fragment (SIMPLE_ZIGBEE_FRAGMENT_MARKER, while a fragmenter is set) or for a packed TX request 
+*    (SIMPLE_ZIGBEE_BUNDLE_MARKER, while a coalescer is set). The request must then be framed (see 
+*    sendMarkerFramed()). Returns 0 otherwise. Fragments and bundles sent by the fragmenter and coalescer, 
+*    retries from the retransmitter and requests sent by the scheduler (which were framed when first sent) are
+*    left as they are. So are requests too long to be stored by the receiving radio, since it does not look 
+*    at their payload.
+*  @ param const uint8_t* header: Frame data up to the payload (starting with the frame type)
+*  @ param int headerLength: Number of bytes in header
+*  @ param const SimpleZigBeeSegment* segments: Array of payload segments (may be NULL if segmentCount is 0)
+*  @ param uint8_t segmentCount: Number of segments
+*/
+uint8_t SimpleZigBeeRadio::getMarkerToFrame(const uint8_t* header, int headerLength, const SimpleZigBeeSegment* segments, uint8_t segmentCount){
+	bool fragments = (NULL != _fragmenter);
+	bool bundles = (NULL != _coalescer);
+	if( (!fragments && !bundles) || (fragments && _fragmenter->isSending()) || (bundles && _coalescer->isSending()) ){
+		return 0;
+	}
+	if( (NULL != _retransmitter && _retransmitter->isResending()) || (NULL != _scheduler && _scheduler->isSending()) ){
+		return 0;
+	}
+	if( NULL == header || headerLength < SimpleZigBeeTxRequestLayout::PAYLOAD_INDEX || ZIGBEE_TRANSMIT_REQUEST != header[0] ){
+		return 0;
+	}
+	int frameLength = headerLength;
+	for( uint8_t i = 0; i < segmentCount; i++ ){
+		frameLength += segments[i].length;
+	}
+	// The RX header is 2 bytes shorter than the TX request header
+	if( frameLength - (SimpleZigBeeTxRequestLayout::PAYLOAD_INDEX - SimpleZigBeeRxLayout::PAYLOAD_INDEX) > SIMPLE_ZIGBEE_MAX_FRAME_LENGTH ){
+		return 0;
+	}
+	// First payload byte
+	int first = -1;
+	if( headerLength > SimpleZigBeeTxRequestLayout::PAYLOAD_INDEX ){
+		first = header[SimpleZigBeeTxRequestLayout::PAYLOAD_INDEX];
+	}else{
+		for( uint8_t i = 0; i < segmentCount; i++ ){
+			if( segments[i].length > 0 ){
+				first = segments[i].data[0];
+				break;
+			}
+		}
+	}
+	if( (fragments && SIMPLE_ZIGBEE_FRAGMENT_MARKER == first) || (bundles && SIMPLE_ZIGBEE_BUNDLE_MARKER == first) ){
+		return first;
 	}
+	return 0;
+}
+
+/**
+*  Method: sendMarkerFramed(uint8_t marker, const uint8_t* header, int headerLength, const SimpleZigBeeSegment* segments, uint8_t segmentCount)
+*  @ Since v0.1.2, October 2026
+*  @ Sends a TX request with its payload framed (see getMarkerToFrame()): as a message of one fragment if 
+*    it starts with the fragment marker, or as a packed TX request holding one message if it starts with 
+*    the bundle marker. The receiving fragmenter or coalescer passes the payload to its callback. The frame
+*    ID, addresses, broadcast radius and options are kept. Returns false if the framed request would be too
+*    long for the receiving radio to store, or if it could not be sent.
+*  @ param uint8_t marker: Marker byte returned by getMarkerToFrame()
+*  @ param const uint8_t* header: Frame data up to the payload (starting with the frame type)
+*  @ param int headerLength: Number of bytes in header
+*  @ param const SimpleZigBeeSegment* segments: Array of payload segments (may be NULL if segmentCount is 0)
+*  @ param uint8_t segmentCount: Number of segments
+*/
+bool SimpleZigBeeRadio::sendMarkerFramed(uint8_t marker, const uint8_t* header, int headerLength, const SimpleZigBeeSegment* segments, uint8_t segmentCount){
+	// Largest TX request whose RX packet fits in the incoming packet of the receiving radio
+	uint8_t frameData[SIMPLE_ZIGBEE_MAX_FRAME_LENGTH + SimpleZigBeeTxRequestLayout::PAYLOAD_INDEX - SimpleZigBeeRxLayout::PAYLOAD_INDEX];
+	// A packed TX request has the marker and a length byte in front of each message
+	int prefixLength = (SIMPLE_ZIGBEE_FRAGMENT_MARKER == marker) ? SimpleZigBeeFragmentLayout::HEADER_LENGTH : 2;
+	int payloadLength = headerLength - SimpleZigBeeTxRequestLayout::PAYLOAD_INDEX;
+	for( uint8_t i = 0; i < segmentCount; i++ ){
+		payloadLength += segments[i].length;
+	}
+	int frameLength = SimpleZigBeeTxRequestLayout::PAYLOAD_INDEX + prefixLength + payloadLength;
+	if( frameLength > (int)sizeof(frameData) || (SIMPLE_ZIGBEE_BUNDLE_MARKER == marker && payloadLength > 255) ){
+		return false;
+	}
+	// TX request header, fragment header (or marker and length), then the payload
+	int index = SimpleZigBeeTxRequestLayout::PAYLOAD_INDEX;
+	memcpy( frameData, header, index );
+	if( SIMPLE_ZIGBEE_FRAGMENT_MARKER == marker ){
+		_fragmenter->prepareSingleFragment( frameData + index, payloadLength );
+	}else{
+		frameData[index] = SIMPLE_ZIGBEE_BUNDLE_MARKER;
+		frameData[index + 1] = payloadLength;
+	}
+	index += prefixLength;
+	memcpy( frameData + index, header + SimpleZigBeeTxRequestLayout::PAYLOAD_INDEX, headerLength - SimpleZigBeeTxRequestLayout::PAYLOAD_INDEX );
+	index += headerLength - SimpleZigBeeTxRequestLayout::PAYLOAD_INDEX;
+	for( uint8_t i = 0; i < segmentCount; i++ ){
+		memcpy( frameData + index, segments[i].data, segments[i].length );
+		index += segments[i].length;
+	}
+	return sendSegments( frameData, frameLength, NULL, 0 );
+}
+
+/**
+*  Method: beginFrame(int frameLength)
+*  @ Since v0.1.2, October 2026
+*  @ Starts a new outgoing packet in the write buffer by adding the START byte and the (escaped) frame length.
+*  @ param int frameLength: Number of frame data bytes in the packet
+*/
+void SimpleZigBeeRadio::beginFrame(int frameLength){
+	_out_checksum = 0;
+	// The START byte is never escaped
+	if( _out_buffer_length >= SIMPLE_ZIGBEE_WRITE_BUFFER_SIZE ){
+		writeBuffer();
+	}
+	_out_buffer[_out_buffer_length++] = START;
+	uint8_t length[2] = { (uint8_t)((frameLength >> 8) & 0xff), (uint8_t)(frameLength & 0xff) };
+	writeEscaped( length, 2 );
+}
+
+/**
+*  Method: writeFrameData(const uint8_t* data, int length)
+*  @ Since v0.1.2, October 2026
+*  @ Adds frame data bytes to the outgoing packet in the write buffer and to the checksum.
+*  @ param const uint8_t* data: Pointer to array of frame data bytes
+*  @ param int length: Number of bytes in array
+*/
+void SimpleZigBeeRadio::writeFrameData(const uint8_t* data, int length){
+	_out_checksum += SimpleZigBeeCodec::sum( data, length );
+	writeEscaped( data, length );
+}
+
+/**
+*  Method: endFrame()
+*  @ Since v0.1.2, October 2026
+*  @ Adds the checksum to the outgoing packet and writes the write buffer to the serial port.
+*    The serial port is then flushed if the flush policy is FLUSH_EACH_PACKET and no batch is open.
+*    If a transmit buffer is set, the bytes are instead drained as far as the serial port allows (see service()).
+*/
+void SimpleZigBeeRadio::endFrame(){
 	// Calculate checksum based on summation of frame bytes
-	checksum = 0xff - checksum;
-	writeByte(checksum);
-	flush();
+	uint8_t checksum = 0xff - _out_checksum;
+	writeEscaped( &checksum, 1 );
+	writeBuffer();
+	if( NULL != _transmit_buffer ){
+		service();
+	}else if( 0 == _batch_depth && FLUSH_EACH_PACKET == _flush_policy ){
+		// Wait for the serial port only if each packet should be flushed and no batch is open
+		flush();
+	}
+}
+
+/**
+*  Method: writeEscaped(const uint8_t* data, int length)
+*  @ Since v0.1.2, October 2026
+*  @ Adds bytes to the write buffer, escaping them if the XBee is in Escaped API Mode (ATAP=2).
+*    The buffer is written to the serial port whenever it becomes full.
+*  @ param const uint8_t* data: Pointer to array of bytes
+*  @ param int length: Number of bytes in array
+*/
+void SimpleZigBeeRadio::writeEscaped(const uint8_t* data, int length){
+	size_t done = 0;
+	while( done < (size_t)length ){
+		// Make sure there is room for at least one escaped byte (2 bytes)
+		if( _out_buffer_length > SIMPLE_ZIGBEE_WRITE_BUFFER_SIZE - 2 ){
+			writeBuffer();
+		}
+		size_t space = SIMPLE_ZIGBEE_WRITE_BUFFER_SIZE - _out_buffer_length;
+		size_t consumed;
+		if( true == _escaped_mode ){
+			_out_buffer_length += SimpleZigBeeCodec::escape( data+done, length-done, _out_buffer+_out_buffer_length, space, &consumed );
+		}else{
+			consumed = length - done;
+			if( consumed > space ){
+				consumed = space;
+			}
+			memcpy( _out_buffer+_out_buffer_length, data+done, consumed );
+			_out_buffer_length += consumed;
+		}
+		done += consumed;
+	}
+}
+
+/**
+*  Method: writeBuffer()
+*  @ Since v0.1.2, October 2026
+*  @ Writes the bytes stored in the write buffer to the serial port (or to the transmit buffer, if set)
+*    and empties the buffer.
+*/
+void SimpleZigBeeRadio::writeBuffer(){
+	if( _out_buffer_length > 0 ){
+		if( NULL != _transmit_buffer ){
+			// Room for the whole packet was checked by canWrite()
+			_transmit_buffer->write( _out_buffer, _out_buffer_length );
+		}else{
+			_serial->write( _out_buffer, _out_buffer_length );
+		}
+		_out_buffer_length = 0;
+	}
 }
 
 /**
@@ -871,6 +2272,65 @@ void SimpleZigBeeRadio::flush(){
 	_serial->flush();
 }
 
+/**
+*  Method: setFlushPolicy(uint8_t policy)
+*  @ Since v0.1.2, October 2026
+*  @ Sets when the serial port is flushed (when sendPacket() waits until all outgoing bytes have been sent):
+*      FLUSH_EACH_PACKET: after each packet that is not part of a batch, and at the end of each batch (default)
+*      FLUSH_AT_END: only at the end of each batch (see endBatch())
+*      FLUSH_NEVER: never. The packets are written to the transmit buffer of the serial port and
+*        sent while the program continues (the write only waits if the transmit buffer is full).
+*  @ param uint8_t policy: FLUSH_EACH_PACKET, FLUSH_AT_END or FLUSH_NEVER
+*/
+void SimpleZigBeeRadio::setFlushPolicy(uint8_t policy){
+	_flush_policy = policy;
+}
+
+/**
+*  Method: getFlushPolicy()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the flush policy (see setFlushPolicy()).
+*/
+uint8_t SimpleZigBeeRadio::getFlushPolicy(){
+	return _flush_policy;
+}
+
+/**
+*  Method: beginBatch()
+*  @ Since v0.1.2, October 2026
+*  @ Starts a batch of packets. Until endBatch() is called, each packet is written to the serial port
+*    as soon as it is ready, but the serial port is not flushed. So the next packet can be prepared 
+*    while the previous one is still being sent. Batches can be nested (only the outer endBatch() flushes).
+*/
+void SimpleZigBeeRadio::beginBatch(){
+	_batch_depth++;
+}
+
+/**
+*  Method: endBatch()
+*  @ Since v0.1.2, October 2026
+*  @ Ends a batch of packets (see beginBatch()) and flushes the serial port once, unless the flush policy is 
+*    FLUSH_NEVER or a transmit buffer is set.
+*/
+void SimpleZigBeeRadio::endBatch(){
+	if( 0 == _batch_depth ){
+		return;
+	}
+	_batch_depth--;
+	if( 0 == _batch_depth && FLUSH_NEVER != _flush_policy && NULL == _transmit_buffer ){
+		flush();
+	}
+}
+
+/**
+*  Method: isBatching()
+*  @ Since v0.1.2, October 2026
+*  @ Checks if a batch of packets is open (see beginBatch()).
+*/
+bool SimpleZigBeeRadio::isBatching(){
+	return _batch_depth > 0;
+}
+
 /*//////////////////////////////////////////////////////////////////////
 								ZIGBEE TRANSMIT (TX) REQUEST METHODS
 /*//////////////////////////////////////////////////////////////////////
@@ -962,6 +2422,105 @@ void SimpleZigBeeRadio::prepareTXRequestToCoordinator(uint8_t* payload, int payl
 	prepareTXRequest(COORDINATOR_ADDRESS_64_MSB,COORDINATOR_ADDRESS_64_LSB,BROADCAST_ADDRESS_16,payload,payloadSize);
 }
 
+/**
+*  Method: sendTXRequest(uint32_t adr64MSB, uint32_t adr64LSB, uint16_t adr16, const SimpleZigBeeSegment* segments, uint8_t segmentCount)
+*  @ Since v0.1.2, October 2026
+*  @ Sends a transmit request whose payload is made of the segments, without copying them (see sendFrame()).
+*    The outgoing packet object is not used or changed. The frame ID is chosen like setNextFrameID() and 
+*    saved as the last frame ID. The broadcast radius and frame options are 0. Returns false if the packet
+*    was not sent (see sendFrame()), or if acknowledgement is on and the request table (if set) has no free
+*    frame ID, since the request could not be matched with its TX status. If adr16 is 0xFFFE, the address 
+*    from the address cache (if set) is used.
+*  @ param uint32_t adr64MSB: Most significant bytes (1st half) of 64-bit address
+*  @ param uint32_t adr64LSB: Least significant bytes (2nd half) of 64-bit address 
+*  @ param uint16_t adr16: 16-bit destination address 
+*  @ param const SimpleZigBeeSegment* segments: Array of payload segments
+*  @ param uint8_t segmentCount: Number of segments
+*/
+bool SimpleZigBeeRadio::sendTXRequest(uint32_t adr64MSB, uint32_t adr64LSB, uint16_t adr16, const SimpleZigBeeSegment* segments, uint8_t segmentCount){
+	uint8_t header[SimpleZigBeeTxRequestLayout::MIN_FRAME_LENGTH];
+	uint8_t id = 0;
+	if( _out_acknowledgement == true ){
+		id = getNextFrameID();
+		if( 0 == id ){
+			return false;
+		}
+	}
+	header[0] = SimpleZigBeeTxRequestLayout::FRAME_TYPE;
+	header[SimpleZigBeeTxRequestLayout::ID_INDEX] = id;
+	SimpleZigBeeBigEndian::write32( header + SimpleZigBeeTxRequestLayout::ADDRESS64_INDEX, adr64MSB );
+	SimpleZigBeeBigEndian::write32( header + SimpleZigBeeTxRequestLayout::ADDRESS64_INDEX + 4, adr64LSB );
+	SimpleZigBeeBigEndian::write16( header + SimpleZigBeeTxRequestLayout::ADDRESS16_INDEX, adr16 );
+	header[SimpleZigBeeTxRequestLayout::RADIUS_INDEX] = 0;
+	header[SimpleZigBeeTxRequestLayout::OPTIONS_INDEX] = 0;
+	if( NULL != _address_cache ){
+		_address_cache->fill( header, sizeof(header) );
+	}
+	saveLastFrameID( id );
+	return sendFrame( header, sizeof(header), segments, segmentCount );
+}
+
+/**
+*  Method: sendTXRequest(SimpleZigBeeAddress address, const SimpleZigBeeSegment* segments, uint8_t segmentCount)
+*  @ Since v0.1.2, October 2026
+*  @ Sends a transmit request whose payload is made of the segments, without copying them.
+*  @ param SimpleZigBeeAddress address: Object containing 64-bit and 16-bit destination addresses
+*  @ param const SimpleZigBeeSegment* segments: Array of payload segments
+*  @ param uint8_t segmentCount: Number of segments
+*/
+bool SimpleZigBeeRadio::sendTXRequest(SimpleZigBeeAddress address, const SimpleZigBeeSegment* segments, uint8_t segmentCount){
+	SimpleZigBeeAddress64 adr64 = address.getAddress64();
+	SimpleZigBeeAddress16 adr16 = address.getAddress16();
+	return sendTXRequest( adr64.getAddressMSB(), adr64.getAddressLSB(), adr16.getAddress(), segments, segmentCount );
+}
+
+/**
+*  Method: sendTXRequest(SimpleZigBeeAddress address, const uint8_t* payload, int payloadSize)
+*  @ Since v0.1.2, October 2026
+*  @ Sends a transmit request with the payload, without copying it into the outgoing packet 
+*    (same as prepareTXRequest() followed by send(), but faster).
+*  @ param SimpleZigBeeAddress address: Object containing 64-bit and 16-bit destination addresses
+*  @ param const uint8_t* payload: Pointer to array of bytes to send
+*  @ param int payloadSize: Length of payload array
+*/
+bool SimpleZigBeeRadio::sendTXRequest(SimpleZigBeeAddress address, const uint8_t* payload, int payloadSize){
+	SimpleZigBeeSegment segment = { payload, payloadSize };
+	return sendTXRequest( address, &segment, 1 );
+}
+
+/**
+*  Method: sendMessage(uint32_t adr64MSB, uint32_t adr64LSB, uint16_t adr16, const uint8_t* message, int length)
+*  @ Since v0.1.2, October 2026
+*  @ Sends a message that may be larger than one RF payload, split into fragments by the fragmenter (see 
+*    SimpleZigBeeFragmenter::send()). The receiving radio also needs a fragmenter. Returns false if no 
+*    fragmenter is set or the message was not sent.
+*  @ param uint32_t adr64MSB: Most significant bytes (1st half) of 64-bit address
+*  @ param uint32_t adr64LSB: Least significant bytes (2nd half) of 64-bit address 
+*  @ param uint16_t adr16: 16-bit destination address 
+*  @ param const uint8_t* message: Pointer to array of bytes to send
+*  @ param int length: Length of message array
+*/
+bool SimpleZigBeeRadio::sendMessage(uint32_t adr64MSB, uint32_t adr64LSB, uint16_t adr16, const uint8_t* message, int length){
+	if( NULL == _fragmenter ){
+		return false;
+	}
+	return _fragmenter->send( *this, adr64MSB, adr64LSB, adr16, message, length );
+}
+
+/**
+*  Method: sendMessage(SimpleZigBeeAddress address, const uint8_t* message, int length)
+*  @ Since v0.1.2, October 2026
+*  @ Sends a message that may be larger than one RF payload (see above).
+*  @ param SimpleZigBeeAddress address: Object containing 64-bit and 16-bit destination addresses
+*  @ param const uint8_t* message: Pointer to array of bytes to send
+*  @ param int length: Length of message array
+*/
+bool SimpleZigBeeRadio::sendMessage(SimpleZigBeeAddress address, const uint8_t* message, int length){
+	SimpleZigBeeAddress64 adr64 = address.getAddress64();
+	SimpleZigBeeAddress16 adr16 = address.getAddress16();
+	return sendMessage( adr64.getAddressMSB(), adr64.getAddressLSB(), adr16.getAddress(), message, length );
+}
+
 /*//////////////////////////////////////////////////////////////////////
 												AT COMMAND METHODS
 /*//////////////////////////////////////////////////////////////////////
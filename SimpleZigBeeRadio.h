@@ -79,9 +79,60 @@
 #include "Arduino.h"
 // Requires SimpleZigBeePacket classes
 #include "SimpleZigBeePacket.h"
+// Block scanning and checksum helpers
+#include "SimpleZigBeeCodec.h"
+// Frame layouts and decoders
+#include "SimpleZigBeeFrames.h"
+// Optional queue of complete incoming packets
+#include "SimpleZigBeeFrameQueue.h"
+// Requires SimpleZigBeeBufferPool class
+#include "SimpleZigBeeBufferPool.h"
+// Requires SimpleZigBeeDispatcher class (and SimpleZigBeeFrameCallback type)
+#include "SimpleZigBeeDispatcher.h"
+// Requires SimpleZigBeeRequestTable class
+#include "SimpleZigBeeRequestTable.h"
+// Requires SimpleZigBeeTransmitWindow class
+#include "SimpleZigBeeTransmitWindow.h"
+// Requires SimpleZigBeeRetransmitter class
+#include "SimpleZigBeeRetransmitter.h"
+// Requires SimpleZigBeeTransmitBuffer class
+#include "SimpleZigBeeTransmitBuffer.h"
+// Requires SimpleZigBeePayloadSink class
+#include "SimpleZigBeePayloadSink.h"
+// Requires SimpleZigBeeAddressCache class
+#include "SimpleZigBeeAddressCache.h"
+// Requires SimpleZigBeeRouteCache class
+#include "SimpleZigBeeRouteCache.h"
+// Requires SimpleZigBeeFragmenter class
+#include "SimpleZigBeeFragmenter.h"
+// Requires SimpleZigBeeCoalescer class
+#include "SimpleZigBeeCoalescer.h"
+// Requires SimpleZigBeeScheduler class
+#include "SimpleZigBeeScheduler.h"
 // Required for uint8_t type
 #include <inttypes.h>
 
+// Number of bytes pulled from the serial port per call to Stream::readBytes() by readAvailable().
+// The buffer is placed on the stack, so keep this small on boards with little RAM.
+#ifndef SIMPLE_ZIGBEE_READ_BUFFER_SIZE
+#define SIMPLE_ZIGBEE_READ_BUFFER_SIZE 32
+#endif
+
+// Number of bytes collected before they are written to the serial port with a single call to Stream::write().
+// Most packets fit in the buffer and are written at once.
+#ifndef SIMPLE_ZIGBEE_WRITE_BUFFER_SIZE
+#if defined(__AVR__)
+#define SIMPLE_ZIGBEE_WRITE_BUFFER_SIZE 32
+#else
+#define SIMPLE_ZIGBEE_WRITE_BUFFER_SIZE 256
+#endif
+#endif
+
+// Flush Policies (see SimpleZigBeeRadio::setFlushPolicy())
+#define FLUSH_EACH_PACKET 0
+#define FLUSH_AT_END 1
+#define FLUSH_NEVER 2
+
 /**
 * Class: SimpleZigBeeRadio
 * @ Since v0.1.0 by Eric Burger, August 2013
@@ -91,6 +142,33 @@
 *   not recommended due to the inability to identify incoming packets that are incomplete. 
 *   In other words, in Escaped API Mode, incoming packets can only contain the start byte,
 *   0x7E, at the start of a packet since the byte is "escaped" at all other positions.
+* @ Last Modified v0.1.2 by Eric Burger, October 2026
+* @ Changlog for v0.1.2:
+*    - Added feed() and readAvailable() for parsing blocks of bytes, and setFrameCallback()
+*    - feed() stores runs of frame data in blocks (see SimpleZigBeeCodec)
+*    - sendPacket() escapes the packet into a buffer and writes it with a single call to Stream::write()
+*    - Added setFrameQueue() for storing complete packets in a SimpleZigBeeFrameQueue
+*    - Added setResyncBuffer() so that, in API Mode (ATAP=1), packets that start inside a corrupted packet are recovered
+*    - In API Mode (ATAP=1), the frame type and frame length are checked before a packet is stored, and a packet
+*      that fails the check is dropped. Bytes already stored are only parsed again with setResyncBuffer().
+*    - Added setDispatcher() for handling packets by frame type, and poll() for handling every waiting packet
+*    - The incoming and outgoing packets store their frame data in fixed arrays (see SimpleZigBeePacketT), so the
+*      radio does not allocate memory. Define SIMPLE_ZIGBEE_MAX_FRAME_LENGTH to change their size.
+*    - Added setRequestTable() for matching each request with its status or response by frame ID
+*    - Added canSend() for sending several TX requests without waiting for each TX status (see SimpleZigBeeTransmitWindow)
+*      and getSendCapacity() for checking how many can be sent at once
+*    - Added setRetransmitter() for sending failed TX requests again, depending on the delivery status
+*    - Added beginBatch(), endBatch() and setFlushPolicy() for sending several packets without waiting for each one
+*    - Added sendFrame() and sendTXRequest() for sending payloads from the caller's memory without copying them
+*    - Added setTransmitBuffer() and service() so that send() does not wait for the serial port. The send 
+*      methods return false if a packet could not be sent.
+*    - Added setAsyncReceive() for parsing incoming bytes in an interrupt or a reader thread
+*    - Added setPayloadSink() for receiving RX packets longer than the maximum frame length in chunks
+*    - Added setAddressCache() for filling in known 16-bit addresses, so requests skip network address discovery
+*    - Added setRouteCache() for source routing: routes from route records are sent to the XBee radio before each request
+*    - Added setFragmenter() and sendMessage() for sending messages larger than one RF payload
+*    - Added setCoalescer() for packing small TX requests to the same destination into one
+*    - Added setScheduler() for sending requests by priority class, with each destination taking its turn
 */
 class SimpleZigBeeRadio {
 public:
@@ -110,6 +188,39 @@ public:
 	// INCOMING PACKET METHODS //
 	bool available();
 	void read();
+	int readAvailable();
+	int feed(const uint8_t* data, size_t length);
+	void setFrameCallback(SimpleZigBeeFrameCallback callback);
+	void setFrameQueue(SimpleZigBeeFrameQueue & queue);
+	SimpleZigBeeFrameQueue * getFrameQueue();
+	void setResyncBuffer(uint8_t* buffer, int size);
+	void setAsyncReceive(SimpleZigBeeFrameQueue & queue);
+	bool isAsyncReceive();
+	void setPayloadSink(SimpleZigBeePayloadSink & sink);
+	SimpleZigBeePayloadSink * getPayloadSink();
+	void setDispatcher(SimpleZigBeeDispatcher & dispatcher);
+	SimpleZigBeeDispatcher * getDispatcher();
+	int poll();
+	void setRequestTable(SimpleZigBeeRequestTable & table);
+	SimpleZigBeeRequestTable * getRequestTable();
+	bool canSend();
+	uint8_t getSendCapacity();
+	void setRetransmitter(SimpleZigBeeRetransmitter & retransmitter);
+	SimpleZigBeeRetransmitter * getRetransmitter();
+	void setAddressCache(SimpleZigBeeAddressCache & cache);
+	SimpleZigBeeAddressCache * getAddressCache();
+	void setRouteCache(SimpleZigBeeRouteCache & cache);
+	SimpleZigBeeRouteCache * getRouteCache();
+	void setFragmenter(SimpleZigBeeFragmenter & fragmenter);
+	SimpleZigBeeFragmenter * getFragmenter();
+	void setCoalescer(SimpleZigBeeCoalescer & coalescer);
+	SimpleZigBeeCoalescer * getCoalescer();
+	void setScheduler(SimpleZigBeeScheduler & scheduler);
+	SimpleZigBeeScheduler * getScheduler();
+	void setTransmitBuffer(SimpleZigBeeTransmitBuffer & buffer);
+	SimpleZigBeeTransmitBuffer * getTransmitBuffer();
+	int service();
+	bool canWrite(int frameLength);
 	bool isEscaping();  
 	void setEscaping(bool escape);  
 	bool isComplete();  
@@ -167,6 +278,7 @@ public:
 	void setOutgoingFrameID(uint8_t id);
 	uint8_t getLastFrameID();
 	void saveLastFrameID(uint8_t frameID);
+	uint8_t getNextFrameID();
 	void setNextFrameID();
 	void setAcknowledgement(bool ack);
 	void setOutgoingFrameData(int index, uint8_t byte);
@@ -177,12 +289,18 @@ public:
 	void setOutgoingAddress64(uint32_t adr64MSB, uint32_t adr64LSB);
 	void setOutgoingAddress16(uint16_t adr16);
 	
-	void send();
-	void send(SimpleZigBeePacket & packet);
-	void sendPacket(SimpleZigBeePacket & packet);
+	bool send();
+	bool send(SimpleZigBeePacket & packet);
+	bool sendPacket(SimpleZigBeePacket & packet);
+	bool sendFrame(const uint8_t* header, int headerLength, const SimpleZigBeeSegment* segments, uint8_t segmentCount);
 	void writeByte(uint8_t byte);
 	void write(uint8_t byte);
 	void flush();
+	void setFlushPolicy(uint8_t policy);
+	uint8_t getFlushPolicy();
+	void beginBatch();
+	void endBatch();
+	bool isBatching();
 	
 	// ZIGBEE TRANSMIT (TX) REQUEST METHODS //
 	// Use General Packet Methods for Frame Type, Frame ID, and Address
@@ -195,6 +313,12 @@ public:
 	void prepareTXRequestBroadcast(uint8_t* payload, int payloadSize);
 	void prepareTXRequestToCoordinator(uint8_t* payload, int payloadSize);
 	
+	bool sendTXRequest(uint32_t adr64MSB, uint32_t adr64LSB, uint16_t adr16, const SimpleZigBeeSegment* segments, uint8_t segmentCount);
+	bool sendTXRequest(SimpleZigBeeAddress address, const SimpleZigBeeSegment* segments, uint8_t segmentCount);
+	bool sendTXRequest(SimpleZigBeeAddress address, const uint8_t* payload, int payloadSize);
+	bool sendMessage(uint32_t adr64MSB, uint32_t adr64LSB, uint16_t adr16, const uint8_t* message, int length);
+	bool sendMessage(SimpleZigBeeAddress address, const uint8_t* message, int length);
+	
 	// AT COMMAND METHODS //
 	// Use General Packet Methods for Frame Type, Frame ID, and Address
 	void setATCommand(uint16_t command); 
@@ -230,10 +354,53 @@ private:
 	// Boolean indicating whether or not serial port is SoftwareSerial 
 	bool _is_software_serial;
 
-	// Object for storing incoming packet
-	SimpleIncomingZigBeePacket _incoming_packet;
-	// Most recent byte received from incoming packet
-	uint8_t _in_byte;
+	// Parses one byte of an incoming packet (shared by read(), readAvailable() and feed())
+	bool parseByte(uint8_t byte);
+	// Incoming packet state machine used by parseByte()
+	bool parsePacketByte(uint8_t byte);
+	int getMinFrameLength(uint8_t frameType);
+	// Lookback window for API Mode (ATAP=1)
+	bool parsePending();
+	void resync();
+	void storeResyncBytes(const uint8_t* data, size_t length);
+	void discardResyncBytes(int count);
+	// Stores a run of frame data bytes that need no special treatment (used by feed())
+	size_t parseFrameDataRun(const uint8_t* data, size_t length);
+	// Passes the payload of a packet longer than the maximum frame length to the payload sink
+	void streamPayload(const uint8_t* data, size_t length);
+	void flushStagedPayload();
+	void endStream();
+	// Called by parseByte() each time a packet is completely received
+	void frameReceived();
+	// Handles the packets in the frame queue in asynchronous receive mode (used by poll())
+	int handleQueuedFrames();
+
+	// Object for storing incoming packet (fixed array, no memory is allocated)
+	SimpleIncomingZigBeePacketT<SIMPLE_ZIGBEE_MAX_FRAME_LENGTH> _incoming_packet;
+	// Function called for each complete incoming packet (NULL if not set)
+	SimpleZigBeeFrameCallback _frame_callback;
+	// Queue that receives a copy of each complete incoming packet (NULL if not set)
+	SimpleZigBeeFrameQueue * _frame_queue;
+	// Boolean indicating whether packets are received by an interrupt or thread and handled by poll()
+	bool _async_receive;
+	// Table of handlers called for each complete incoming packet by frame type (NULL if not set)
+	SimpleZigBeeDispatcher * _dispatcher;
+	// Table of outgoing requests waiting for a response (NULL if not set)
+	SimpleZigBeeRequestTable * _request_table;
+	// Copies of TX requests that are sent again if their delivery fails (NULL if not set)
+	SimpleZigBeeRetransmitter * _retransmitter;
+	// 16-bit addresses learned from incoming packets and filled in on outgoing requests (NULL if not set)
+	SimpleZigBeeAddressCache * _address_cache;
+	// Routes from route records that are sent to the XBee radio before each request (NULL if not set)
+	SimpleZigBeeRouteCache * _route_cache;
+	// Splits outgoing messages into fragments and reassembles incoming ones (NULL if not set)
+	SimpleZigBeeFragmenter * _fragmenter;
+	// Packs small TX requests to the same destination and unpacks incoming ones (NULL if not set)
+	SimpleZigBeeCoalescer * _coalescer;
+	// Queues requests by destination and priority class until poll() sends them (NULL if not set)
+	SimpleZigBeeScheduler * _scheduler;
+	// Receives the payload of RX packets longer than the maximum frame length (NULL if not set)
+	SimpleZigBeePayloadSink * _payload_sink;
 	// Current index of incoming packet
 	int _in_index;
 	// Current checksum of incoming packet
@@ -242,9 +409,49 @@ private:
 	bool _in_escaping;
 	// Boolean for tracking if incoming packet is completely received
 	bool _in_complete;
+	// Boolean indicating whether the payload of incoming packet is passed to the payload sink
+	bool _in_streaming;
+	// Number of payload bytes stored after the RX header that have not been passed to the payload sink
+	int _in_staged;
+	// API Mode (ATAP=1) lookback window. Bytes before _resync_parsed have been parsed and belong to the
+	// current packet. Bytes from _resync_parsed to _resync_length are waiting to be parsed again after an error.
+	// The buffer is owned by the caller (NULL if not set, see setResyncBuffer()).
+	uint8_t * _resync_buffer;
+	int _resync_size;
+	int _resync_length;
+	int _resync_parsed;
 	
-	// Object for preparing outgoing packet
-	SimpleOutgoingZigBeePacket _outgoing_packet;
+	// Methods for escaping an outgoing packet into _out_buffer (used by sendPacket())
+	void beginFrame(int frameLength);
+	void writeFrameData(const uint8_t* data, int length);
+	void endFrame();
+	void writeEscaped(const uint8_t* data, int length);
+	void writeBuffer();
+	// Sends a Create Source Route frame from the route cache (used by send() and sendFrame())
+	void sendSourceRoute(const uint8_t* routeFrameData, int routeLength);
+	// Checks if a request is queued in the scheduler instead of sent (used by send() and sendFrame())
+	bool isScheduled(const uint8_t* frameData, int frameLength);
+	// Frames TX request payloads that start with a marker byte, so the receiving radio does not mistake them 
+	// for a fragment or a packed TX request (used by send() and sendFrame())
+	uint8_t getMarkerToFrame(const uint8_t* header, int headerLength, const SimpleZigBeeSegment* segments, uint8_t segmentCount);
+	bool sendMarkerFramed(uint8_t marker, const uint8_t* header, int headerLength, const SimpleZigBeeSegment* segments, uint8_t segmentCount);
+	// Sends (or queues) a packet from a header and segments, as they are (used by sendFrame())
+	bool sendSegments(const uint8_t* header, int headerLength, const SimpleZigBeeSegment* segments, uint8_t segmentCount);
+
+	// Object for preparing outgoing packet (fixed array, no memory is allocated)
+	SimpleOutgoingZigBeePacketT<SIMPLE_ZIGBEE_MAX_FRAME_LENGTH> _outgoing_packet;
+	// Escaped bytes waiting to be written to the serial port
+	uint8_t _out_buffer[SIMPLE_ZIGBEE_WRITE_BUFFER_SIZE];
+	// Number of bytes stored in _out_buffer
+	int _out_buffer_length;
+	// Ring that _out_buffer is written to instead of the serial port (NULL if not set)
+	SimpleZigBeeTransmitBuffer * _transmit_buffer;
+	// Sum of the frame data bytes of the packet being written
+	uint8_t _out_checksum;
+	// FLUSH_EACH_PACKET, FLUSH_AT_END or FLUSH_NEVER
+	uint8_t _flush_policy;
+	// Number of calls to beginBatch() without a call to endBatch()
+	uint8_t _batch_depth;
 	// Boolean specifying if outgoing packets should require acknowledgement.
 	bool _out_acknowledgement;
 	// Frame ID of last outgoing packet
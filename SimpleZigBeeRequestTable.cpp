@@ -0,0 +1,439 @@
+/**
+* Copyright (c) 2013 Eric Burger. All rights reserved.
+*/
+
+#include "SimpleZigBeeRequestTable.h"
+// Frame index of each field (frame layouts)
+#include "SimpleZigBeeFrames.h"
+// Congestion window for TX requests
+#include "SimpleZigBeeTransmitWindow.h"
+
+/*//////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////
+										SimpleZigBeeRequestTable Class
+////////////////////////////////////////////////////////////////////////
+/*//////////////////////////////////////////////////////////////////////
+
+/*//////////////////////////////////////////////////////////////////////
+									INITIALIZATION METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Constructor: SimpleZigBeeRequestTable(SimpleZigBeeRequest* requestStorage, uint8_t slots)
+*  @ Since v0.1.2, October 2026
+*  @ Creates a table using the provided storage. Normally called by SimpleZigBeeRequestTableT.
+*  @ param SimpleZigBeeRequest* requestStorage: Array of slots requests
+*  @ param uint8_t slots: Number of requests that can be stored (255 for one slot per frame ID)
+*/
+SimpleZigBeeRequestTable::SimpleZigBeeRequestTable(SimpleZigBeeRequest* requestStorage, uint8_t slots){
+	_requests = requestStorage;
+	_slots = slots;
+	_timeout = SIMPLE_ZIGBEE_REQUEST_TIMEOUT;
+	_callback = NULL;
+	_window = NULL;
+	clear();
+}
+
+/**
+*  Method: clear()
+*  @ Since v0.1.2, October 2026
+*  @ Removes all requests and resets the counters (and the transmit window, if set).
+*/
+void SimpleZigBeeRequestTable::clear(){
+	memset( _requests, 0, sizeof(SimpleZigBeeRequest) * _slots );
+	_pendingCount = 0;
+	if( NULL != _window ){
+		_window->reset();
+	}
+	resetCounters();
+}
+
+/**
+*  Method: setTimeout(unsigned long timeout)
+*  @ Since v0.1.2, October 2026
+*  @ Sets the number of milliseconds to wait for the response of a request.
+*  @ param unsigned long timeout: Milliseconds (default SIMPLE_ZIGBEE_REQUEST_TIMEOUT)
+*/
+void SimpleZigBeeRequestTable::setTimeout(unsigned long timeout){
+	_timeout = timeout;
+}
+
+/**
+*  Method: getTimeout()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of milliseconds to wait for the response of a request.
+*/
+unsigned long SimpleZigBeeRequestTable::getTimeout(){
+	return _timeout;
+}
+
+/**
+*  Method: setCallback(SimpleZigBeeRequestCallback callback)
+*  @ Since v0.1.2, October 2026
+*  @ Sets the function that is called each time a request is completed or times out. 
+*  @ param SimpleZigBeeRequestCallback callback: Function to call, or NULL to disable
+*/
+void SimpleZigBeeRequestTable::setCallback(SimpleZigBeeRequestCallback callback){
+	_callback = callback;
+}
+
+/**
+*  Method: setTransmitWindow(SimpleZigBeeTransmitWindow & window)
+*  @ Since v0.1.2, October 2026
+*  @ Sets the congestion window that is told each time a TX request is sent, completed or times out. 
+*  @ param SimpleZigBeeTransmitWindow & window: Window object
+*/
+void SimpleZigBeeRequestTable::setTransmitWindow(SimpleZigBeeTransmitWindow & window){
+	_window = &window;
+	_window->reset();
+}
+
+/**
+*  Method: getTransmitWindow()
+*  @ Since v0.1.2, October 2026
+*  @ Returns a pointer to the window set by setTransmitWindow(), or NULL if no window is set.
+*/
+SimpleZigBeeTransmitWindow * SimpleZigBeeRequestTable::getTransmitWindow(){
+	return _window;
+}
+
+/*//////////////////////////////////////////////////////////////////////
+										REQUEST METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: begin(SimpleZigBeePacket & packet)
+*  @ Since v0.1.2, October 2026
+*  @ Records an outgoing request as it is sent. Returns false if the packet does not ask for a response
+*    (frame ID 0, or a frame type without a status or response frame). If another request is still waiting
+*    in the same slot, that request is counted as timed out.
+*  @ param SimpleZigBeePacket & packet: Outgoing packet
+*/
+bool SimpleZigBeeRequestTable::begin(SimpleZigBeePacket & packet){
+	return begin( packet.getFrameDataPointer(), packet.getFrameLength() );
+}
+
+/**
+*  Method: begin(const uint8_t* frameData, int frameLength)
+*  @ Since v0.1.2, October 2026
+*  @ Records an outgoing request from its frame data (see begin(SimpleZigBeePacket & packet)). Only the
+*    frame type, frame ID and destination are read, so the payload does not need to be included.
+*  @ param const uint8_t* frameData: Pointer to the frame data (starting with the frame type)
+*  @ param int frameLength: Number of bytes in frameData
+*/
+bool SimpleZigBeeRequestTable::begin(const uint8_t* frameData, int frameLength){
+	if( NULL == frameData || frameLength <= SimpleZigBeeTxRequestLayout::ID_INDEX ){
+		return false;
+	}
+	uint8_t frameID = frameData[SimpleZigBeeTxRequestLayout::ID_INDEX];
+	if( 0 == frameID || 0 == getResponseType( frameData[0] ) ){
+		return false;
+	}
+	SimpleZigBeeRequest & request = slot( frameID );
+	if( REQUEST_PENDING == request.state ){
+		finish( request, REQUEST_TIMED_OUT );
+	}
+	request.frameID = frameID;
+	request.requestType = frameData[0];
+	request.state = REQUEST_PENDING;
+	request.status = 0;
+	request.retryCount = 0;
+	request.address64MSB = 0;
+	request.address64LSB = 0;
+	request.address16 = 0;
+	// TX requests and remote AT commands have the destination at the same index (local AT commands have none)
+	if( AT_COMMAND_RESPONSE != getResponseType(request.requestType) && frameLength >= SimpleZigBeeTxRequestLayout::ADDRESS16_INDEX + 2 ){
+		request.address64MSB = SimpleZigBeeBigEndian::read32( frameData + SimpleZigBeeTxRequestLayout::ADDRESS64_INDEX );
+		request.address64LSB = SimpleZigBeeBigEndian::read32( frameData + SimpleZigBeeTxRequestLayout::ADDRESS64_INDEX + 4 );
+		request.address16 = SimpleZigBeeBigEndian::read16( frameData + SimpleZigBeeTxRequestLayout::ADDRESS16_INDEX );
+	}
+	request.sentTime = millis();
+	request.latency = 0;
+	_pendingCount++;
+	if( NULL != _window && ZIGBEE_TX_STATUS == getResponseType(request.requestType) ){
+		_window->requestSent();
+	}
+	return true;
+}
+
+/**
+*  Method: complete(SimpleZigBeePacket & packet)
+*  @ Since v0.1.2, October 2026
+*  @ Matches an incoming TX status, AT command response or remote AT command response with the request
+*    that has the same frame ID. Returns true if a waiting request was found and marked as complete.
+*  @ param SimpleZigBeePacket & packet: Incoming packet
+*/
+bool SimpleZigBeeRequestTable::complete(SimpleZigBeePacket & packet){
+	const uint8_t* frameData = packet.getFrameDataPointer();
+	int frameLength = packet.getFrameLength();
+	if( NULL == frameData || frameLength <= SimpleZigBeeTxStatusLayout::ID_INDEX ){
+		return false;
+	}
+	uint8_t frameType = frameData[0];
+	uint8_t frameID = frameData[SimpleZigBeeTxStatusLayout::ID_INDEX];
+	if( 0 == frameID ){
+		return false;
+	}
+	SimpleZigBeeRequest & request = slot( frameID );
+	if( REQUEST_PENDING != request.state || request.frameID != frameID || getResponseType(request.requestType) != frameType ){
+		return false;
+	}
+	if( ZIGBEE_TX_STATUS == frameType && frameLength >= SimpleZigBeeTxStatusLayout::MIN_FRAME_LENGTH ){
+		request.status = frameData[SimpleZigBeeTxStatusLayout::DELIVERY_STATUS_INDEX];
+		request.retryCount = frameData[SimpleZigBeeTxStatusLayout::RETRY_COUNT_INDEX];
+	}else if( AT_COMMAND_RESPONSE == frameType && frameLength >= SimpleZigBeeAtResponseLayout::MIN_FRAME_LENGTH ){
+		request.status = frameData[SimpleZigBeeAtResponseLayout::STATUS_INDEX];
+	}else if( REMOTE_AT_COMMAND_RESPONSE == frameType && frameLength >= SimpleZigBeeRemoteAtResponseLayout::MIN_FRAME_LENGTH ){
+		request.status = frameData[SimpleZigBeeRemoteAtResponseLayout::STATUS_INDEX];
+	}else{
+		return false;
+	}
+	request.latency = millis() - request.sentTime;
+	_latencySum += request.latency;
+	if( request.latency > _maxLatency ){
+		_maxLatency = request.latency;
+	}
+	finish( request, REQUEST_COMPLETE );
+	return true;
+}
+
+/**
+*  Method: checkTimeouts()
+*  @ Since v0.1.2, October 2026
+*  @ Marks each request that has waited longer than getTimeout() as timed out. Returns the number of requests
+*    that timed out. Called by SimpleZigBeeRadio::poll() when the table is set in the radio.
+*/
+uint8_t SimpleZigBeeRequestTable::checkTimeouts(){
+	if( 0 == _pendingCount ){
+		return 0;
+	}
+	uint8_t count = 0;
+	unsigned long now = millis();
+	for( int i=0; i<_slots; i++ ){
+		SimpleZigBeeRequest & request = _requests[i];
+		if( REQUEST_PENDING == request.state && (now - request.sentTime) >= _timeout ){
+			request.latency = now - request.sentTime;
+			finish( request, REQUEST_TIMED_OUT );
+			count++;
+		}
+	}
+	return count;
+}
+
+/**
+*  Method: getNextFrameID(uint8_t lastFrameID)
+*  @ Since v0.1.2, October 2026
+*  @ Returns the frame ID after lastFrameID (1 to 255) whose slot is not waiting for a response. 
+*    Returns 0 (no response requested) if every slot is waiting.
+*  @ param uint8_t lastFrameID: Frame ID of the last request
+*/
+uint8_t SimpleZigBeeRequestTable::getNextFrameID(uint8_t lastFrameID){
+	uint8_t id = lastFrameID;
+	for( int i=0; i<255; i++ ){
+		id = (id % 255) + 1;
+		if( REQUEST_PENDING != slot(id).state ){
+			return id;
+		}
+	}
+	return 0;
+}
+
+/**
+*  Method: getResponseType(uint8_t requestType)
+*  @ Since v0.1.2, October 2026
+*  @ Returns the frame type of the status or response frame for a request frame type, or 0 if the 
+*    request does not have one.
+*  @ param uint8_t requestType: Frame type of the request
+*/
+uint8_t SimpleZigBeeRequestTable::getResponseType(uint8_t requestType){
+	switch( requestType ){
+		case ZIGBEE_TRANSMIT_REQUEST:
+		case ZIGBEE_EXPLICIT_ADDRESSING_COMMAND_FRAME:
+			return ZIGBEE_TX_STATUS;
+		case AT_COMMAND:
+		case AT_COMMAND_QUEUED:
+			return AT_COMMAND_RESPONSE;
+		case REMOTE_AT_COMMAND:
+			return REMOTE_AT_COMMAND_RESPONSE;
+		default:
+			return 0;
+	}
+}
+
+/**
+*  Method: slot(uint8_t frameID)
+*  @ Since v0.1.2, October 2026
+*  @ Returns the slot used by the frame ID (1 to 255).
+*  @ param uint8_t frameID: Frame ID
+*/
+SimpleZigBeeRequest & SimpleZigBeeRequestTable::slot(uint8_t frameID){
+	return _requests[(uint8_t)(frameID - 1) % _slots];
+}
+
+/**
+*  Method: finish(SimpleZigBeeRequest & request, uint8_t state)
+*  @ Since v0.1.2, October 2026
+*  @ Marks a waiting request as complete or timed out, updates the counters and the transmit window (TX requests), 
+*    and calls the callback.
+*  @ param SimpleZigBeeRequest & request: Waiting request
+*  @ param uint8_t state: REQUEST_COMPLETE or REQUEST_TIMED_OUT
+*/
+void SimpleZigBeeRequestTable::finish(SimpleZigBeeRequest & request, uint8_t state){
+	request.state = state;
+	_pendingCount--;
+	if( REQUEST_COMPLETE == state ){
+		_completeCount++;
+	}else{
+		_timeoutCount++;
+	}
+	if( NULL != _window && ZIGBEE_TX_STATUS == getResponseType(request.requestType) ){
+		_window->requestFinished( request );
+	}
+	if( NULL != _callback ){
+		_callback( request );
+	}
+}
+
+/*//////////////////////////////////////////////////////////////////////
+										LOOKUP METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: getRequest(uint8_t frameID)
+*  @ Since v0.1.2, October 2026
+*  @ Returns a pointer to the last request sent with the frame ID, or NULL if there is none (or its 
+*    slot has been used by another frame ID).
+*  @ param uint8_t frameID: Frame ID (1 to 255)
+*/
+SimpleZigBeeRequest * SimpleZigBeeRequestTable::getRequest(uint8_t frameID){
+	if( 0 == frameID ){
+		return NULL;
+	}
+	SimpleZigBeeRequest & request = slot( frameID );
+	if( REQUEST_FREE == request.state || request.frameID != frameID ){
+		return NULL;
+	}
+	return &request;
+}
+
+/**
+*  Method: isPending(uint8_t frameID)
+*  @ Since v0.1.2, October 2026
+*  @ Checks if the request with the frame ID is waiting for a response.
+*  @ param uint8_t frameID: Frame ID
+*/
+bool SimpleZigBeeRequestTable::isPending(uint8_t frameID){
+	SimpleZigBeeRequest * request = getRequest( frameID );
+	return NULL != request && REQUEST_PENDING == request->state;
+}
+
+/**
+*  Method: isComplete(uint8_t frameID)
+*  @ Since v0.1.2, October 2026
+*  @ Checks if the response of the request with the frame ID has been received.
+*  @ param uint8_t frameID: Frame ID
+*/
+bool SimpleZigBeeRequestTable::isComplete(uint8_t frameID){
+	SimpleZigBeeRequest * request = getRequest( frameID );
+	return NULL != request && REQUEST_COMPLETE == request->state;
+}
+
+/**
+*  Method: isTimedOut(uint8_t frameID)
+*  @ Since v0.1.2, October 2026
+*  @ Checks if the request with the frame ID timed out.
+*  @ param uint8_t frameID: Frame ID
+*/
+bool SimpleZigBeeRequestTable::isTimedOut(uint8_t frameID){
+	SimpleZigBeeRequest * request = getRequest( frameID );
+	return NULL != request && REQUEST_TIMED_OUT == request->state;
+}
+
+/**
+*  Method: getLatency(uint8_t frameID)
+*  @ Since v0.1.2, October 2026
+*  @ Returns the milliseconds from sending the request with the frame ID to receiving its response 
+*    (0 if the request is not complete).
+*  @ param uint8_t frameID: Frame ID
+*/
+unsigned long SimpleZigBeeRequestTable::getLatency(uint8_t frameID){
+	SimpleZigBeeRequest * request = getRequest( frameID );
+	if( NULL == request || REQUEST_COMPLETE != request->state ){
+		return 0;
+	}
+	return request->latency;
+}
+
+/*//////////////////////////////////////////////////////////////////////
+									STATISTICS METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: getPendingCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of requests waiting for a response.
+*/
+uint8_t SimpleZigBeeRequestTable::getPendingCount(){
+	return _pendingCount;
+}
+
+/**
+*  Method: getFreeCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of slots that are not waiting for a response, which is the number of requests 
+*    that can still be given a frame ID.
+*/
+uint8_t SimpleZigBeeRequestTable::getFreeCount(){
+	return _slots - _pendingCount;
+}
+
+/**
+*  Method: getCompleteCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of requests completed since the counters were reset.
+*/
+unsigned long SimpleZigBeeRequestTable::getCompleteCount(){
+	return _completeCount;
+}
+
+/**
+*  Method: getTimeoutCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of requests that timed out since the counters were reset.
+*/
+unsigned long SimpleZigBeeRequestTable::getTimeoutCount(){
+	return _timeoutCount;
+}
+
+/**
+*  Method: getAverageLatency()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the average latency (milliseconds) of the requests completed since the counters were reset.
+*/
+unsigned long SimpleZigBeeRequestTable::getAverageLatency(){
+	if( 0 == _completeCount ){
+		return 0;
+	}
+	return _latencySum / _completeCount;
+}
+
+/**
+*  Method: getMaxLatency()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the largest latency (milliseconds) of the requests completed since the counters were reset.
+*/
+unsigned long SimpleZigBeeRequestTable::getMaxLatency(){
+	return _maxLatency;
+}
+
+/**
+*  Method: resetCounters()
+*  @ Since v0.1.2, October 2026
+*  @ Resets the complete and timeout counts and the latency statistics.
+*/
+void SimpleZigBeeRequestTable::resetCounters(){
+	_completeCount = 0;
+	_timeoutCount = 0;
+	_latencySum = 0;
+	_maxLatency = 0;
+}
@@ -0,0 +1,174 @@
+/**
+* Library Name: SimpleZigBeeRequestTable
+* Library URI: https://github.com/ericburger/simple-zigbee
+* Description: Table of outgoing requests waiting for the status or response frame
+* with the same frame ID.
+* Version: 0.1.2
+* Author(s): Eric Burger
+* Author URI: WallflowerOpen.com
+* License: GNU General Public License v2.0 or later
+* License URI: http://www.gnu.org/licenses/gpl-2.0.html 
+*
+* Copyright (c) 2013 Eric Burger. All rights reserved.
+*
+* This file is part of SimpleZigBee, written for XBee S2 Radios.
+*
+* SimpleZigBee is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* SimpleZigBee is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with SimpleZigBee.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SimpleZigBeeRequestTable_h
+#define SimpleZigBeeRequestTable_h
+
+#include "Arduino.h"
+// Requires SimpleZigBeePacket classes
+#include "SimpleZigBeePacket.h"
+// Required for uint8_t type
+#include <inttypes.h>
+
+// Milliseconds to wait for the status or response of a request (see SimpleZigBeeRequestTable::setTimeout())
+#ifndef SIMPLE_ZIGBEE_REQUEST_TIMEOUT
+#define SIMPLE_ZIGBEE_REQUEST_TIMEOUT 5000
+#endif
+
+// Request States
+#define REQUEST_FREE 0
+#define REQUEST_PENDING 1
+#define REQUEST_COMPLETE 2
+#define REQUEST_TIMED_OUT 3
+
+/**
+* Struct: SimpleZigBeeRequest
+* @ Since v0.1.2, October 2026
+* @ One outgoing request (TX request, AT command or remote AT command) and, once it has arrived, 
+*   the result reported by its status or response frame.
+*/
+struct SimpleZigBeeRequest {
+	uint8_t frameID;
+	// Frame type of the request (for example, ZIGBEE_TRANSMIT_REQUEST)
+	uint8_t requestType;
+	// REQUEST_PENDING, REQUEST_COMPLETE or REQUEST_TIMED_OUT
+	uint8_t state;
+	// Delivery status (TX status) or command status (AT responses) of the response
+	uint8_t status;
+	// Transmit retry count (TX status only)
+	uint8_t retryCount;
+	// Destination of the request (0 for local AT commands)
+	uint32_t address64MSB;
+	uint32_t address64LSB;
+	uint16_t address16;
+	// millis() when the request was sent
+	unsigned long sentTime;
+	// Milliseconds from sending the request to receiving the response
+	unsigned long latency;
+};
+
+// Congestion window for TX requests (see SimpleZigBeeTransmitWindow.h)
+class SimpleZigBeeTransmitWindow;
+
+// Function called when a request is completed or times out (see SimpleZigBeeRequestTable::setCallback())
+typedef void (*SimpleZigBeeRequestCallback)(SimpleZigBeeRequest & request);
+
+/**
+* Class: SimpleZigBeeRequestTable
+* @ Since v0.1.2, October 2026
+* @ Records each outgoing request that asks for a status or response (frame ID not 0) and matches it
+*   with the TX status, AT command response or remote AT command response that has the same frame ID.
+*   The frame ID is used as the index into the table, so both steps take the same time no matter how
+*   many requests are waiting. For each request, the table keeps the destination, the time it was sent 
+*   and, once the response arrives, the status and round-trip latency. Requests without a response 
+*   after getTimeout() milliseconds are marked as timed out by checkTimeouts().
+*   When the table is set in the radio (see SimpleZigBeeRadio::setRequestTable()), every request 
+*   sent with send() is recorded, every response is matched as it is received, poll() checks for 
+*   timeouts, and setNextFrameID() skips frame IDs that are still waiting for a response.
+*   With a transmit window (see setTransmitWindow()), the number of TX requests waiting at the same 
+*   time is limited by the congestion window (see SimpleZigBeeRadio::canSend()).
+*   The storage for the requests is provided by SimpleZigBeeRequestTableT (see below).
+*/
+class SimpleZigBeeRequestTable {
+public:
+	// INITIALIZATION METHODS //
+	SimpleZigBeeRequestTable(SimpleZigBeeRequest* requestStorage, uint8_t slots);
+	void clear();
+	void setTimeout(unsigned long timeout);
+	unsigned long getTimeout();
+	void setCallback(SimpleZigBeeRequestCallback callback);
+	void setTransmitWindow(SimpleZigBeeTransmitWindow & window);
+	SimpleZigBeeTransmitWindow * getTransmitWindow();
+	
+	// REQUEST METHODS //
+	bool begin(SimpleZigBeePacket & packet);
+	bool begin(const uint8_t* frameData, int frameLength);
+	bool complete(SimpleZigBeePacket & packet);
+	uint8_t checkTimeouts();
+	uint8_t getNextFrameID(uint8_t lastFrameID);
+	static uint8_t getResponseType(uint8_t requestType);
+	
+	// LOOKUP METHODS //
+	SimpleZigBeeRequest * getRequest(uint8_t frameID);
+	bool isPending(uint8_t frameID);
+	bool isComplete(uint8_t frameID);
+	bool isTimedOut(uint8_t frameID);
+	unsigned long getLatency(uint8_t frameID);
+	
+	// STATISTICS METHODS //
+	uint8_t getPendingCount();
+	uint8_t getFreeCount();
+	unsigned long getCompleteCount();
+	unsigned long getTimeoutCount();
+	unsigned long getAverageLatency();
+	unsigned long getMaxLatency();
+	void resetCounters();
+
+private:
+	SimpleZigBeeRequest & slot(uint8_t frameID);
+	void finish(SimpleZigBeeRequest & request, uint8_t state);
+
+	// One request for each frame ID (frame IDs share a slot if there are less than 255 slots)
+	SimpleZigBeeRequest* _requests;
+	uint8_t _slots;
+	// Milliseconds to wait for a response
+	unsigned long _timeout;
+	// Function called when a request is completed or times out (NULL if not set)
+	SimpleZigBeeRequestCallback _callback;
+	// Congestion window told about each TX request (NULL if not set)
+	SimpleZigBeeTransmitWindow * _window;
+	// Number of requests waiting for a response
+	uint8_t _pendingCount;
+	// Number of requests completed and timed out
+	unsigned long _completeCount;
+	unsigned long _timeoutCount;
+	// Sum and maximum of the latency of completed requests
+	unsigned long _latencySum;
+	unsigned long _maxLatency;
+};
+
+/**
+* Class: SimpleZigBeeRequestTableT
+* @ Since v0.1.2, October 2026
+* @ Request table that holds its own storage. With 255 slots (the default), every frame ID has its own
+*   slot. Each slot uses about 24 bytes of RAM on Arduino boards, so use fewer slots there (for example,
+*   "SimpleZigBeeRequestTableT<8> table;"). Then at most that many requests can wait at the same time.
+*/
+template<uint8_t Slots = 255>
+class SimpleZigBeeRequestTableT : public SimpleZigBeeRequestTable {
+public:
+	SimpleZigBeeRequestTableT() : SimpleZigBeeRequestTable(_request_storage, Slots) {}
+	
+private:
+	static_assert( Slots >= 1, "Slots must be between 1 and 255" );
+	SimpleZigBeeRequest _request_storage[Slots];
+};
+
+#endif //SimpleZigBeeRequestTable_h
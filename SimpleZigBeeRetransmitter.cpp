@@ -0,0 +1,475 @@
+/**
+* Copyright (c) 2013 Eric Burger. All rights reserved.
+*/
+
+#include "SimpleZigBeeRetransmitter.h"
+// Frame index of each field (frame layouts)
+#include "SimpleZigBeeFrames.h"
+// Requires SimpleZigBeeRequestTable::getResponseType() and SIMPLE_ZIGBEE_REQUEST_TIMEOUT
+#include "SimpleZigBeeRequestTable.h"
+// Requires SimpleZigBeeRadio class for sending the stored requests
+#include "SimpleZigBeeRadio.h"
+
+/*//////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////
+										SimpleZigBeeRetransmitter Class
+////////////////////////////////////////////////////////////////////////
+/*//////////////////////////////////////////////////////////////////////
+
+/*//////////////////////////////////////////////////////////////////////
+									INITIALIZATION METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Constructor: SimpleZigBeeRetransmitter(SimpleZigBeeRetransmitSlot* slotStorage, uint8_t* frameStorage, uint8_t slots, int maxFrameLength)
+*  @ Since v0.1.2, October 2026
+*  @ Creates a retransmitter using the provided storage. Normally called by SimpleZigBeeRetransmitterT.
+*  @ param SimpleZigBeeRetransmitSlot* slotStorage: Array of slots slot states
+*  @ param uint8_t* frameStorage: Array of slots * maxFrameLength bytes for the frame data
+*  @ param uint8_t slots: Number of TX requests that can be stored
+*  @ param int maxFrameLength: Largest frame length that can be stored
+*/
+SimpleZigBeeRetransmitter::SimpleZigBeeRetransmitter(SimpleZigBeeRetransmitSlot* slotStorage, uint8_t* frameStorage, uint8_t slots, int maxFrameLength){
+	_slots = slotStorage;
+	_frames = frameStorage;
+	_slotCount = slots;
+	_maxFrameLength = maxFrameLength;
+	_policy = defaultPolicy;
+	_maxRetries = SIMPLE_ZIGBEE_MAX_RETRIES;
+	_resending = false;
+	setBackoff( 50, 2000 );
+	setBudget( 4, 4 );
+	setStatusTimeout( SIMPLE_ZIGBEE_REQUEST_TIMEOUT );
+	clear();
+}
+
+/**
+*  Method: clear()
+*  @ Since v0.1.2, October 2026
+*  @ Removes all stored requests and resets the counters.
+*/
+void SimpleZigBeeRetransmitter::clear(){
+	memset( _slots, 0, sizeof(SimpleZigBeeRetransmitSlot) * _slotCount );
+	resetCounters();
+}
+
+/**
+*  Method: setPolicy(SimpleZigBeeRetryPolicy policy)
+*  @ Since v0.1.2, October 2026
+*  @ Sets the function that chooses RETRY_IMMEDIATE, RETRY_BACKOFF or RETRY_GIVE_UP for the delivery
+*    status of a failed TX request. The function can call defaultPolicy() for the statuses it does not handle.
+*  @ param SimpleZigBeeRetryPolicy policy: Function to call, or NULL for defaultPolicy()
+*/
+void SimpleZigBeeRetransmitter::setPolicy(SimpleZigBeeRetryPolicy policy){
+	_policy = (NULL == policy) ? defaultPolicy : policy;
+}
+
+/**
+*  Method: defaultPolicy(uint8_t deliveryStatus)
+*  @ Since v0.1.2, October 2026
+*  @ Returns the retry policy used for a delivery status if no other policy is set.
+*    Failures caused by a busy channel or a neighbor that did not answer are backed off, an unknown
+*    16-bit address is retried at once, and failures that a retry cannot fix are given up.
+*  @ param uint8_t deliveryStatus: Delivery status of the TX status
+*/
+uint8_t SimpleZigBeeRetransmitter::defaultPolicy(uint8_t deliveryStatus){
+	switch( deliveryStatus ){
+		case TRANSMIT_STATUS_MAC_ACK_FAILURE:
+		case TRANSMIT_STATUS_CCA_FAILURE:
+		case TRANSMIT_STATUS_NETWORK_ACK_FAILURE:
+		case TRANSMIT_STATUS_ROUTE_NOT_FOUND:
+			return RETRY_BACKOFF;
+		case TRANSMIT_STATUS_ADDRESS_NOT_FOUND:
+			return RETRY_IMMEDIATE;
+		default:
+			return RETRY_GIVE_UP;
+	}
+}
+
+/**
+*  Method: setMaxRetries(uint8_t maxRetries)
+*  @ Since v0.1.2, October 2026
+*  @ Sets the number of times a TX request is sent again before it is given up.
+*  @ param uint8_t maxRetries: Number of retries (default SIMPLE_ZIGBEE_MAX_RETRIES)
+*/
+void SimpleZigBeeRetransmitter::setMaxRetries(uint8_t maxRetries){
+	_maxRetries = maxRetries;
+}
+
+/**
+*  Method: getMaxRetries()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of times a TX request is sent again before it is given up.
+*/
+uint8_t SimpleZigBeeRetransmitter::getMaxRetries(){
+	return _maxRetries;
+}
+
+/**
+*  Method: setBackoff(unsigned long baseDelay, unsigned long maxDelay)
+*  @ Since v0.1.2, October 2026
+*  @ Sets the backoff of RETRY_BACKOFF. The backoff is baseDelay before the first retry and doubles
+*    with each retry up to maxDelay. The request is sent again after a random delay between half and
+*    all of the backoff.
+*  @ param unsigned long baseDelay: Milliseconds before the first retry (default 50)
+*  @ param unsigned long maxDelay: Largest backoff in milliseconds (default 2000)
+*/
+void SimpleZigBeeRetransmitter::setBackoff(unsigned long baseDelay, unsigned long maxDelay){
+	_baseDelay = baseDelay;
+	_maxDelay = (maxDelay < baseDelay) ? baseDelay : maxDelay;
+}
+
+/**
+*  Method: setBudget(uint8_t retriesPerSecond, uint8_t burst)
+*  @ Since v0.1.2, October 2026
+*  @ Limits the retries to retriesPerSecond on average, with up to burst retries at once.
+*  @ param uint8_t retriesPerSecond: Average number of retries per second (default 4)
+*  @ param uint8_t burst: Number of retries that can be sent at once (default 4, at least 1)
+*/
+void SimpleZigBeeRetransmitter::setBudget(uint8_t retriesPerSecond, uint8_t burst){
+	if( burst < 1 ){
+		burst = 1;
+	}
+	_retriesPerSecond = retriesPerSecond;
+	_maxTokens = 1000UL * burst;
+	_tokens = _maxTokens;
+	_tokenTime = millis();
+}
+
+/**
+*  Method: setStatusTimeout(unsigned long timeout)
+*  @ Since v0.1.2, October 2026
+*  @ Sets the number of milliseconds to wait for the TX status of a stored request. Requests without
+*    a TX status are backed off (for example, if the request was lost on the serial port).
+*  @ param unsigned long timeout: Milliseconds (default SIMPLE_ZIGBEE_REQUEST_TIMEOUT)
+*/
+void SimpleZigBeeRetransmitter::setStatusTimeout(unsigned long timeout){
+	_statusTimeout = timeout;
+}
+
+/*//////////////////////////////////////////////////////////////////////
+										RETRANSMIT METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: store(SimpleZigBeePacket & packet)
+*  @ Since v0.1.2, October 2026
+*  @ Stores a copy of a TX request that is being sent. Returns true if the packet was stored. Packets
+*    that are not TX requests or have frame ID 0 are ignored. If the packet is too long or all slots are
+*    in use, the packet is not stored and counted (see getDropCount()). Called by SimpleZigBeeRadio::send().
+*  @ param SimpleZigBeePacket & packet: TX request
+*/
+bool SimpleZigBeeRetransmitter::store(SimpleZigBeePacket & packet){
+	return store( packet.getFrameDataPointer(), packet.getFrameLength(), NULL, 0 );
+}
+
+/**
+*  Method: store(const uint8_t* header, int headerLength, const SimpleZigBeeSegment* segments, uint8_t segmentCount)
+*  @ Since v0.1.2, October 2026
+*  @ Stores a copy of a TX request that is sent from a header and payload segments (see store(SimpleZigBeePacket & packet)).
+*    The segments are copied one after the other behind the header. Called by SimpleZigBeeRadio::sendFrame().
+*  @ param const uint8_t* header: Frame data up to the payload (starting with the frame type)
+*  @ param int headerLength: Number of bytes in header
+*  @ param const SimpleZigBeeSegment* segments: Array of payload segments (may be NULL if segmentCount is 0)
+*  @ param uint8_t segmentCount: Number of segments
+*/
+bool SimpleZigBeeRetransmitter::store(const uint8_t* header, int headerLength, const SimpleZigBeeSegment* segments, uint8_t segmentCount){
+	if( _resending || NULL == header || headerLength < SimpleZigBeeTxRequestLayout::MIN_FRAME_LENGTH ){
+		return false;
+	}
+	uint8_t frameID = header[SimpleZigBeeTxRequestLayout::ID_INDEX];
+	if( 0 == frameID || ZIGBEE_TX_STATUS != SimpleZigBeeRequestTable::getResponseType( header[0] ) ){
+		return false;
+	}
+	// A stored request with the same frame ID will never get its TX status, so its slot is reused
+	int index = find( frameID );
+	if( index >= 0 ){
+		remove( index );
+		_giveUpCount++;
+	}
+	int frameLength = headerLength;
+	for( uint8_t i = 0; i < segmentCount; i++ ){
+		frameLength += segments[i].length;
+	}
+	if( frameLength > _maxFrameLength ){
+		_dropCount++;
+		return false;
+	}
+	for( index = 0; index < _slotCount; index++ ){
+		if( RETRANSMIT_FREE == _slots[index].state ){
+			break;
+		}
+	}
+	if( index == _slotCount ){
+		_dropCount++;
+		return false;
+	}
+	SimpleZigBeeRetransmitSlot & s = _slots[index];
+	uint8_t* data = frameData(index);
+	memcpy( data, header, headerLength );
+	data += headerLength;
+	for( uint8_t i = 0; i < segmentCount; i++ ){
+		memcpy( data, segments[i].data, segments[i].length );
+		data += segments[i].length;
+	}
+	s.frameID = frameID;
+	s.state = RETRANSMIT_WAITING;
+	s.attempts = 1;
+	s.frameLength = frameLength;
+	s.time = millis();
+	return true;
+}
+
+/**
+*  Method: statusReceived(SimpleZigBeePacket & packet)
+*  @ Since v0.1.2, October 2026
+*  @ Checks a received TX status. If it belongs to a stored request, the request is removed when it was
+*    delivered and otherwise handled by the retry policy for the delivery status. Returns true if the
+*    TX status belonged to a stored request. Called by the radio for each received packet.
+*  @ param SimpleZigBeePacket & packet: Received packet
+*/
+bool SimpleZigBeeRetransmitter::statusReceived(SimpleZigBeePacket & packet){
+	const uint8_t* data = packet.getFrameDataPointer();
+	if( NULL == data || packet.getFrameLength() < SimpleZigBeeTxStatusLayout::MIN_FRAME_LENGTH || SimpleZigBeeTxStatusLayout::FRAME_TYPE != data[0] ){
+		return false;
+	}
+	int index = find( data[SimpleZigBeeTxStatusLayout::ID_INDEX] );
+	if( index < 0 ){
+		return false;
+	}
+	uint8_t deliveryStatus = data[SimpleZigBeeTxStatusLayout::DELIVERY_STATUS_INDEX];
+	if( TRANSMIT_STATUS_SUCCESS == deliveryStatus ){
+		if( _slots[index].attempts > 1 ){
+			_recoveredCount++;
+		}
+		remove( index );
+		return true;
+	}
+	uint8_t policy = _policy( deliveryStatus );
+	if( TRANSMIT_STATUS_ADDRESS_NOT_FOUND == deliveryStatus && RETRY_GIVE_UP != policy ){
+		// Send to the unknown 16-bit address (0xFFFE), so that the XBee radio looks up the address again
+		uint8_t* address16 = frameData(index) + SimpleZigBeeTxRequestLayout::ADDRESS16_INDEX;
+		address16[0] = 0xff;
+		address16[1] = 0xfe;
+	}
+	schedule( index, policy );
+	return true;
+}
+
+/**
+*  Method: service(SimpleZigBeeRadio & radio)
+*  @ Since v0.1.2, October 2026
+*  @ Backs off the stored requests that have waited too long for their TX status and sends the requests
+*    that are due, as long as the radio can send (see SimpleZigBeeRadio::canSend() and canWrite()) and the retry budget
+*    allows it. Each request is sent with a new frame ID. Returns the number of requests sent.
+*    Called by SimpleZigBeeRadio::poll().
+*  @ param SimpleZigBeeRadio & radio: Radio that sends the requests
+*/
+int SimpleZigBeeRetransmitter::service(SimpleZigBeeRadio & radio){
+	unsigned long now = millis();
+	for( int i = 0; i < _slotCount; i++ ){
+		if( RETRANSMIT_WAITING == _slots[i].state && now - _slots[i].time >= _statusTimeout ){
+			schedule( i, RETRY_BACKOFF );
+		}
+	}
+	int sent = 0;
+	for( int i = 0; i < _slotCount; i++ ){
+		SimpleZigBeeRetransmitSlot & s = _slots[i];
+		// Scheduled time is compared as a signed difference, so it still works when millis() wraps
+		if( RETRANSMIT_SCHEDULED != s.state || (long)(now - s.time) < 0 ){
+			continue;
+		}
+		if( !radio.canSend() || !radio.canWrite( s.frameLength ) ){
+			break;
+		}
+		uint8_t frameID = radio.getNextFrameID();
+		if( 0 == frameID || !takeToken() ){
+			break;
+		}
+		uint8_t* data = frameData(i);
+		data[SimpleZigBeeTxRequestLayout::ID_INDEX] = frameID;
+		s.frameID = frameID;
+		s.state = RETRANSMIT_WAITING;
+		s.attempts++;
+		s.time = now;
+		radio.saveLastFrameID( frameID );
+		SimpleZigBeePacketRef<> packet( data, s.frameLength );
+		_resending = true;
+		radio.send( packet );
+		_resending = false;
+		_retryCount++;
+		sent++;
+	}
+	return sent;
+}
+
+/**
+*  Method: isResending()
+*  @ Since v0.1.2, October 2026
+*  @ Returns true while service() is sending a stored request, so the radio can tell a retry from a new request.
+*/
+bool SimpleZigBeeRetransmitter::isResending(){
+	return _resending;
+}
+
+/*//////////////////////////////////////////////////////////////////////
+										STATISTICS METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: getStoredCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of TX requests that are stored (waiting for a TX status or a retry).
+*/
+uint8_t SimpleZigBeeRetransmitter::getStoredCount(){
+	uint8_t count = 0;
+	for( int i = 0; i < _slotCount; i++ ){
+		if( RETRANSMIT_FREE != _slots[i].state ){
+			count++;
+		}
+	}
+	return count;
+}
+
+/**
+*  Method: getRetryCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of retries sent since the last call to resetCounters().
+*/
+unsigned long SimpleZigBeeRetransmitter::getRetryCount(){
+	return _retryCount;
+}
+
+/**
+*  Method: getRecoveredCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of TX requests delivered after at least one retry.
+*/
+unsigned long SimpleZigBeeRetransmitter::getRecoveredCount(){
+	return _recoveredCount;
+}
+
+/**
+*  Method: getGiveUpCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of stored TX requests that were given up (by the policy or after getMaxRetries() retries).
+*/
+unsigned long SimpleZigBeeRetransmitter::getGiveUpCount(){
+	return _giveUpCount;
+}
+
+/**
+*  Method: getDropCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of TX requests that could not be stored (all slots in use or frame too long).
+*/
+unsigned long SimpleZigBeeRetransmitter::getDropCount(){
+	return _dropCount;
+}
+
+/**
+*  Method: resetCounters()
+*  @ Since v0.1.2, October 2026
+*  @ Sets the retry, recovered, give up and drop counters to 0.
+*/
+void SimpleZigBeeRetransmitter::resetCounters(){
+	_retryCount = 0;
+	_recoveredCount = 0;
+	_giveUpCount = 0;
+	_dropCount = 0;
+}
+
+/*//////////////////////////////////////////////////////////////////////
+										PRIVATE METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: find(uint8_t frameID)
+*  @ Since v0.1.2, October 2026
+*  @ Returns the index of the slot waiting for the TX status of frameID, or -1.
+*  @ param uint8_t frameID: Frame ID of the TX status
+*/
+int SimpleZigBeeRetransmitter::find(uint8_t frameID){
+	for( int i = 0; i < _slotCount; i++ ){
+		if( RETRANSMIT_WAITING == _slots[i].state && frameID == _slots[i].frameID ){
+			return i;
+		}
+	}
+	return -1;
+}
+
+/**
+*  Method: frameData(int index)
+*  @ Since v0.1.2, October 2026
+*  @ Returns a pointer to the frame data stored for a slot.
+*  @ param int index: Index of the slot
+*/
+uint8_t* SimpleZigBeeRetransmitter::frameData(int index){
+	return _frames + index * _maxFrameLength;
+}
+
+/**
+*  Method: schedule(int index, uint8_t policy)
+*  @ Since v0.1.2, October 2026
+*  @ Chooses when a stored request is sent again, or removes it if the policy gives up or it has
+*    already been sent again getMaxRetries() times.
+*  @ param int index: Index of the slot
+*  @ param uint8_t policy: RETRY_IMMEDIATE, RETRY_BACKOFF or RETRY_GIVE_UP
+*/
+void SimpleZigBeeRetransmitter::schedule(int index, uint8_t policy){
+	SimpleZigBeeRetransmitSlot & s = _slots[index];
+	if( RETRY_GIVE_UP == policy || s.attempts > _maxRetries ){
+		remove( index );
+		_giveUpCount++;
+		return;
+	}
+	s.state = RETRANSMIT_SCHEDULED;
+	s.time = millis();
+	if( RETRY_BACKOFF == policy ){
+		// Backoff doubles with each retry: baseDelay, 2 * baseDelay, 4 * baseDelay, ... up to maxDelay
+		unsigned long backoff = _maxDelay;
+		uint8_t retries = s.attempts - 1;
+		if( retries < 16 && (_baseDelay << retries) < _maxDelay ){
+			backoff = _baseDelay << retries;
+		}
+		// Random delay between half and all of the backoff
+		s.time += backoff / 2 + random( backoff / 2 + 1 );
+	}
+}
+
+/**
+*  Method: remove(int index)
+*  @ Since v0.1.2, October 2026
+*  @ Frees a slot.
+*  @ param int index: Index of the slot
+*/
+void SimpleZigBeeRetransmitter::remove(int index){
+	_slots[index].state = RETRANSMIT_FREE;
+	_slots[index].frameID = 0;
+}
+
+/**
+*  Method: takeToken()
+*  @ Since v0.1.2, October 2026
+*  @ Refills the retry budget for the time since the last call and takes one retry from it.
+*    Returns false if the budget is used up.
+*/
+bool SimpleZigBeeRetransmitter::takeToken(){
+	unsigned long now = millis();
+	unsigned long elapsed = now - _tokenTime;
+	_tokenTime = now;
+	// Budget is counted in 1/1000 of a retry, so each millisecond adds retriesPerSecond
+	if( _retriesPerSecond > 0 && elapsed >= _maxTokens ){
+		_tokens = _maxTokens;
+	}else{
+		_tokens += elapsed * _retriesPerSecond;
+		if( _tokens > _maxTokens ){
+			_tokens = _maxTokens;
+		}
+	}
+	if( _tokens < 1000 ){
+		return false;
+	}
+	_tokens -= 1000;
+	return true;
+}
@@ -0,0 +1,184 @@
+/**
+* Library Name: SimpleZigBeeRetransmitter
+* Library URI: https://github.com/ericburger/simple-zigbee
+* Description: Keeps a copy of each TX request until its TX status arrives and sends
+* it again, depending on the delivery status.
+* Version: 0.1.2
+* Author(s): Eric Burger
+* Author URI: WallflowerOpen.com
+* License: GNU General Public License v2.0 or later
+* License URI: http://www.gnu.org/licenses/gpl-2.0.html
+*
+* Copyright (c) 2013 Eric Burger. All rights reserved.
+*
+* This file is part of SimpleZigBee, written for XBee S2 Radios.
+*
+* SimpleZigBee is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* SimpleZigBee is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with SimpleZigBee.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SimpleZigBeeRetransmitter_h
+#define SimpleZigBeeRetransmitter_h
+
+#include "Arduino.h"
+// Requires SimpleZigBeePacket classes
+#include "SimpleZigBeePacket.h"
+// Requires SimpleZigBeeSegment struct
+#include "SimpleZigBeeCodec.h"
+// Required for uint8_t type
+#include <inttypes.h>
+
+// Number of times a TX request is sent again before giving up (see SimpleZigBeeRetransmitter::setMaxRetries())
+#ifndef SIMPLE_ZIGBEE_MAX_RETRIES
+#define SIMPLE_ZIGBEE_MAX_RETRIES 3
+#endif
+
+// Retry Policies (see SimpleZigBeeRetransmitter::defaultPolicy())
+#define RETRY_GIVE_UP 0
+#define RETRY_IMMEDIATE 1
+#define RETRY_BACKOFF 2
+
+// Retransmit Slot States
+#define RETRANSMIT_FREE 0
+#define RETRANSMIT_WAITING 1
+#define RETRANSMIT_SCHEDULED 2
+
+/**
+* Struct: SimpleZigBeeRetransmitSlot
+* @ Since v0.1.2, October 2026
+* @ State of one stored TX request. The frame data is kept by the retransmitter next to the slot.
+*/
+struct SimpleZigBeeRetransmitSlot {
+	// Frame ID of the last transmission
+	uint8_t frameID;
+	// RETRANSMIT_FREE, RETRANSMIT_WAITING (for its TX status) or RETRANSMIT_SCHEDULED (to be sent again)
+	uint8_t state;
+	// Number of times the request was sent
+	uint8_t attempts;
+	// Length of the stored frame data
+	int frameLength;
+	// millis() when the request was sent (waiting) or when it will be sent again (scheduled)
+	unsigned long time;
+};
+
+// Radio used to send the stored requests again (see SimpleZigBeeRadio.h)
+class SimpleZigBeeRadio;
+
+// Function that chooses the retry policy for a delivery status (see SimpleZigBeeRetransmitter::setPolicy())
+typedef uint8_t (*SimpleZigBeeRetryPolicy)(uint8_t deliveryStatus);
+
+/**
+* Class: SimpleZigBeeRetransmitter
+* @ Since v0.1.2, October 2026
+* @ Keeps a copy of each TX request that asks for a TX status (frame ID not 0) until the TX status arrives.
+*   If the delivery failed, the policy for the delivery status decides what happens to the copy:
+*     - RETRY_IMMEDIATE: sent again as soon as possible
+*     - RETRY_BACKOFF: sent again after a random delay between half and all of the backoff, which starts at
+*       the base delay and doubles with each attempt (up to the maximum delay), so that radios that collided
+*       do not collide again
+*     - RETRY_GIVE_UP: removed
+*   The default policy (see defaultPolicy()) backs off after MAC ACK, CCA, network ACK and route failures,
+*   retries at once when the 16-bit address was not found (after clearing it, so that the XBee radio
+*   looks it up again) and gives up for all other failures. A request without a TX status after the
+*   status timeout is backed off. After getMaxRetries() retries, a request is removed.
+*   Retries may only use a share of the radio: each retry takes a token from a bucket that is refilled
+*   at a fixed rate (see setBudget()), and retries are only sent while SimpleZigBeeRadio::canSend() is true,
+*   so new requests are never held back by old ones.
+*   When set in the radio (see SimpleZigBeeRadio::setRetransmitter()), every TX request sent with send() is
+*   stored, every TX status is checked and poll() sends the requests that are due. Each retry gets a new
+*   frame ID. The storage for the requests is provided by SimpleZigBeeRetransmitterT (see below).
+*   Example:
+*     SimpleZigBeeRetransmitterT<4> retransmitter;
+*     xbee.setRetransmitter( retransmitter );
+*/
+class SimpleZigBeeRetransmitter {
+public:
+	// INITIALIZATION METHODS //
+	SimpleZigBeeRetransmitter(SimpleZigBeeRetransmitSlot* slotStorage, uint8_t* frameStorage, uint8_t slots, int maxFrameLength);
+	void clear();
+	void setPolicy(SimpleZigBeeRetryPolicy policy);
+	static uint8_t defaultPolicy(uint8_t deliveryStatus);
+	void setMaxRetries(uint8_t maxRetries);
+	uint8_t getMaxRetries();
+	void setBackoff(unsigned long baseDelay, unsigned long maxDelay);
+	void setBudget(uint8_t retriesPerSecond, uint8_t burst);
+	void setStatusTimeout(unsigned long timeout);
+
+	// RETRANSMIT METHODS //
+	bool store(SimpleZigBeePacket & packet);
+	bool store(const uint8_t* header, int headerLength, const SimpleZigBeeSegment* segments, uint8_t segmentCount);
+	bool statusReceived(SimpleZigBeePacket & packet);
+	int service(SimpleZigBeeRadio & radio);
+	bool isResending();
+
+	// STATISTICS METHODS //
+	uint8_t getStoredCount();
+	unsigned long getRetryCount();
+	unsigned long getRecoveredCount();
+	unsigned long getGiveUpCount();
+	unsigned long getDropCount();
+	void resetCounters();
+
+private:
+	int find(uint8_t frameID);
+	uint8_t* frameData(int index);
+	void schedule(int index, uint8_t policy);
+	void remove(int index);
+	bool takeToken();
+
+	SimpleZigBeeRetransmitSlot* _slots;
+	uint8_t* _frames;
+	uint8_t _slotCount;
+	int _maxFrameLength;
+	// Function that chooses the retry policy
+	SimpleZigBeeRetryPolicy _policy;
+	uint8_t _maxRetries;
+	// Backoff in milliseconds before the first retry, and largest backoff
+	unsigned long _baseDelay;
+	unsigned long _maxDelay;
+	// Milliseconds to wait for a TX status before the request is backed off
+	unsigned long _statusTimeout;
+	// Token bucket for retries, in 1/1000 of a retry
+	unsigned long _tokens;
+	unsigned long _maxTokens;
+	uint8_t _retriesPerSecond;
+	unsigned long _tokenTime;
+	// Set while service() sends a stored request, so that store() does not store it again
+	bool _resending;
+	// Number of retries sent, requests delivered after a retry, requests given up and requests that could not be stored
+	unsigned long _retryCount;
+	unsigned long _recoveredCount;
+	unsigned long _giveUpCount;
+	unsigned long _dropCount;
+};
+
+/**
+* Class: SimpleZigBeeRetransmitterT
+* @ Since v0.1.2, October 2026
+* @ Retransmitter that holds its own storage for Slots TX requests of up to MaxFrameLength bytes of
+*   frame data each. While all slots are in use, new TX requests are sent without a copy.
+*/
+template<uint8_t Slots, int MaxFrameLength = SIMPLE_ZIGBEE_MAX_FRAME_LENGTH>
+class SimpleZigBeeRetransmitterT : public SimpleZigBeeRetransmitter {
+public:
+	SimpleZigBeeRetransmitterT() : SimpleZigBeeRetransmitter(_slot_storage, _frame_storage, Slots, MaxFrameLength) {}
+
+private:
+	static_assert( Slots >= 1, "Slots must be between 1 and 255" );
+	static_assert( MaxFrameLength >= 1, "MaxFrameLength must be at least 1" );
+	SimpleZigBeeRetransmitSlot _slot_storage[Slots];
+	uint8_t _frame_storage[Slots * MaxFrameLength];
+};
+
+#endif //SimpleZigBeeRetransmitter_h
@@ -0,0 +1,411 @@
+/**
+* Copyright (c) 2013 Eric Burger. All rights reserved.
+*/
+
+#include "SimpleZigBeeRouteCache.h"
+// Frame index of each field (frame layouts)
+#include "SimpleZigBeeFrames.h"
+
+/*//////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////
+									SimpleZigBeeRouteCache Class
+////////////////////////////////////////////////////////////////////////
+/*//////////////////////////////////////////////////////////////////////
+
+/*//////////////////////////////////////////////////////////////////////
+									INITIALIZATION METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Constructor: SimpleZigBeeRouteCache(SimpleZigBeeRoute* routeStorage, uint16_t* hopStorage, uint8_t routes, uint8_t maxHops)
+*  @ Since v0.1.2, October 2026
+*  @ Creates a cache using the provided storage. Normally called by SimpleZigBeeRouteCacheT.
+*  @ param SimpleZigBeeRoute* routeStorage: Array of routes
+*  @ param uint16_t* hopStorage: Array of routes*maxHops 16-bit addresses
+*  @ param uint8_t routes: Number of routes in array
+*  @ param uint8_t maxHops: Largest number of hops in a route
+*/
+SimpleZigBeeRouteCache::SimpleZigBeeRouteCache(SimpleZigBeeRoute* routeStorage, uint16_t* hopStorage, uint8_t routes, uint8_t maxHops){
+	_routes = routeStorage;
+	_hops = hopStorage;
+	_routeCount = routes;
+	_maxHops = maxHops;
+	clear();
+}
+
+/**
+*  Method: clear()
+*  @ Since v0.1.2, October 2026
+*  @ Forgets every route and resets the counters.
+*/
+void SimpleZigBeeRouteCache::clear(){
+	for( uint8_t i = 0; i < _routeCount; i++ ){
+		_routes[i].used = false;
+		_routes[i].frameID = 0;
+	}
+	_current = false;
+	resetCounters();
+}
+
+/*//////////////////////////////////////////////////////////////////////
+									ROUTE METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: setRoute(uint32_t adr64MSB, uint32_t adr64LSB, uint16_t adr16, const uint16_t* hops, uint8_t hopCount)
+*  @ Since v0.1.2, October 2026
+*  @ Stores the route to a device. Returns false if the route has more hops than the cache can store (the 
+*    old route to the device, if any, is removed).
+*  @ param uint32_t adr64MSB: Most significant bytes (1st half) of 64-bit address
+*  @ param uint32_t adr64LSB: Least significant bytes (2nd half) of 64-bit address 
+*  @ param uint16_t adr16: 16-bit network address
+*  @ param const uint16_t* hops: 16-bit addresses of the hops, starting with the neighbor of the device
+*  @ param uint8_t hopCount: Number of hops (not counting this radio and the device)
+*/
+bool SimpleZigBeeRouteCache::setRoute(uint32_t adr64MSB, uint32_t adr64LSB, uint16_t adr16, const uint16_t* hops, uint8_t hopCount){
+	int index = store( adr64MSB, adr64LSB, adr16, hopCount );
+	if( index < 0 ){
+		return false;
+	}
+	bool changed = _routes[index].hopCount != hopCount;
+	uint16_t* stored = _hops + index * _maxHops;
+	for( uint8_t i = 0; i < hopCount; i++ ){
+		changed |= stored[i] != hops[i];
+		stored[i] = hops[i];
+	}
+	_routes[index].hopCount = hopCount;
+	routeChanged( index, changed );
+	return true;
+}
+
+/**
+*  Method: getRoute(uint32_t adr64MSB, uint32_t adr64LSB, uint16_t* hops, uint8_t maxHops)
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of hops in the route to a device, or -1 if there is no route. Up to maxHops 16-bit 
+*    addresses of the hops are copied, starting with the neighbor of the device.
+*  @ param uint32_t adr64MSB: Most significant bytes (1st half) of 64-bit address
+*  @ param uint32_t adr64LSB: Least significant bytes (2nd half) of 64-bit address 
+*  @ param uint16_t* hops: Array for the 16-bit addresses of the hops (may be NULL if maxHops is 0)
+*  @ param uint8_t maxHops: Number of addresses that fit in array
+*/
+int SimpleZigBeeRouteCache::getRoute(uint32_t adr64MSB, uint32_t adr64LSB, uint16_t* hops, uint8_t maxHops){
+	int index = find( adr64MSB, adr64LSB );
+	if( index < 0 ){
+		return -1;
+	}
+	const uint16_t* stored = _hops + index * _maxHops;
+	for( uint8_t i = 0; i < _routes[index].hopCount && i < maxHops; i++ ){
+		hops[i] = stored[i];
+	}
+	return _routes[index].hopCount;
+}
+
+/**
+*  Method: remove(uint32_t adr64MSB, uint32_t adr64LSB)
+*  @ Since v0.1.2, October 2026
+*  @ Removes the route to a device, so that requests to it use route discovery. Returns true if there was a route.
+*  @ param uint32_t adr64MSB: Most significant bytes (1st half) of 64-bit address
+*  @ param uint32_t adr64LSB: Least significant bytes (2nd half) of 64-bit address 
+*/
+bool SimpleZigBeeRouteCache::remove(uint32_t adr64MSB, uint32_t adr64LSB){
+	int index = find( adr64MSB, adr64LSB );
+	if( index < 0 ){
+		return false;
+	}
+	_routes[index].used = false;
+	_routes[index].frameID = 0;
+	// The XBee radio may still have the route, but it will not be sent again
+	if( _current && adr64LSB == _currentLSB && adr64MSB == _currentMSB ){
+		_current = false;
+	}
+	return true;
+}
+
+/**
+*  Method: packetReceived(SimpleZigBeePacket & packet)
+*  @ Since v0.1.2, October 2026
+*  @ Called for each incoming packet. Stores the route of each route record, removes the route of a request
+*    that could not be delivered (see statusReceived()) and, after a modem status (for example, a reset), 
+*    assumes that the XBee radio no longer has a source route.
+*  @ param SimpleZigBeePacket & packet: Incoming packet
+*/
+void SimpleZigBeeRouteCache::packetReceived(SimpleZigBeePacket & packet){
+	const uint8_t* frameData = packet.getFrameDataPointer();
+	int frameLength = packet.getFrameLength();
+	if( NULL == frameData || frameLength < 1 ){
+		return;
+	}
+	switch( frameData[0] ){
+		case ROUTE_RECORD_INDICATOR:
+			recordReceived( frameData, frameLength );
+			break;
+		case ZIGBEE_TX_STATUS:
+			statusReceived( frameData, frameLength );
+			break;
+		case MODEM_STATUS:
+			_current = false;
+			break;
+	}
+}
+
+/**
+*  Method: prepareSourceRoute(const uint8_t* frameData, int frameLength, uint8_t* routeFrameData)
+*  @ Since v0.1.2, October 2026
+*  @ Called for each outgoing packet. If the packet is a request to a device with a route, and the route is 
+*    not already in the XBee radio, the frame data of a Create Source Route frame is written to routeFrameData
+*    and its length is returned. Otherwise, 0 is returned. The frame ID of the request is remembered, so that
+*    the TX status can be matched with the route. Once the Create Source Route frame is sent, 
+*    sourceRouteSent() must be called.
+*    Note: The RF payload of a request that is sent along a source route is 2 bytes smaller per hop.
+*  @ param const uint8_t* frameData: Frame data of the request (starting with the frame type)
+*  @ param int frameLength: Number of bytes of frame data (at least up to the 16-bit address)
+*  @ param uint8_t* routeFrameData: Array of SIMPLE_ZIGBEE_MAX_SOURCE_ROUTE_FRAME_LENGTH bytes
+*/
+int SimpleZigBeeRouteCache::prepareSourceRoute(const uint8_t* frameData, int frameLength, uint8_t* routeFrameData){
+	// TX requests, explicit TX requests and remote AT commands have the destination at the same index
+	if( NULL == frameData || frameLength < SimpleZigBeeTxRequestLayout::ADDRESS16_INDEX + 2 ){
+		return 0;
+	}
+	if( ZIGBEE_TRANSMIT_REQUEST != frameData[0] && ZIGBEE_EXPLICIT_ADDRESSING_COMMAND_FRAME != frameData[0] && REMOTE_AT_COMMAND != frameData[0] ){
+		return 0;
+	}
+	uint32_t adr64MSB = SimpleZigBeeBigEndian::read32( frameData + SimpleZigBeeTxRequestLayout::ADDRESS64_INDEX );
+	uint32_t adr64LSB = SimpleZigBeeBigEndian::read32( frameData + SimpleZigBeeTxRequestLayout::ADDRESS64_INDEX + 4 );
+	int index = find( adr64MSB, adr64LSB );
+	if( index < 0 ){
+		return 0;
+	}
+	// A frame ID is only waiting for one TX status (an older request that never got one is forgotten)
+	uint8_t frameID = frameData[SimpleZigBeeTxRequestLayout::ID_INDEX];
+	if( 0 != frameID ){
+		for( uint8_t i = 0; i < _routeCount; i++ ){
+			if( frameID == _routes[i].frameID ){
+				_routes[i].frameID = 0;
+			}
+		}
+	}
+	SimpleZigBeeRoute & route = _routes[index];
+	route.frameID = frameID;
+	route.time = millis();
+	if( _current && adr64LSB == _currentLSB && adr64MSB == _currentMSB ){
+		return 0;
+	}
+	routeFrameData[0] = CREATE_SOURCE_ROUTE;
+	// The frame ID of a Create Source Route frame is always 0 (there is no response)
+	routeFrameData[SimpleZigBeeCreateSourceRouteLayout::ID_INDEX] = 0;
+	SimpleZigBeeBigEndian::write32( routeFrameData + SimpleZigBeeCreateSourceRouteLayout::ADDRESS64_INDEX, adr64MSB );
+	SimpleZigBeeBigEndian::write32( routeFrameData + SimpleZigBeeCreateSourceRouteLayout::ADDRESS64_INDEX + 4, adr64LSB );
+	SimpleZigBeeBigEndian::write16( routeFrameData + SimpleZigBeeCreateSourceRouteLayout::ADDRESS16_INDEX, route.address16 );
+	routeFrameData[SimpleZigBeeCreateSourceRouteLayout::OPTIONS_INDEX] = 0;
+	routeFrameData[SimpleZigBeeCreateSourceRouteLayout::COUNT_INDEX] = route.hopCount;
+	const uint16_t* stored = _hops + index * _maxHops;
+	for( uint8_t i = 0; i < route.hopCount; i++ ){
+		SimpleZigBeeBigEndian::write16( routeFrameData + SimpleZigBeeCreateSourceRouteLayout::ADDRESSES_INDEX + 2*i, stored[i] );
+	}
+	return SimpleZigBeeCreateSourceRouteLayout::ADDRESSES_INDEX + 2*route.hopCount;
+}
+
+/**
+*  Method: sourceRouteSent(const uint8_t* routeFrameData)
+*  @ Since v0.1.2, October 2026
+*  @ Called after a Create Source Route frame from prepareSourceRoute() is sent. Remembers that the XBee
+*    radio has the route, so that it is not sent again for the next request to the same device.
+*  @ param const uint8_t* routeFrameData: Frame data of the Create Source Route frame
+*/
+void SimpleZigBeeRouteCache::sourceRouteSent(const uint8_t* routeFrameData){
+	_currentMSB = SimpleZigBeeBigEndian::read32( routeFrameData + SimpleZigBeeCreateSourceRouteLayout::ADDRESS64_INDEX );
+	_currentLSB = SimpleZigBeeBigEndian::read32( routeFrameData + SimpleZigBeeCreateSourceRouteLayout::ADDRESS64_INDEX + 4 );
+	_current = true;
+	_sentCount++;
+}
+
+/*//////////////////////////////////////////////////////////////////////
+									STATISTICS METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: getCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of routes that are stored.
+*/
+uint8_t SimpleZigBeeRouteCache::getCount(){
+	uint8_t count = 0;
+	for( uint8_t i = 0; i < _routeCount; i++ ){
+		if( _routes[i].used ){
+			count++;
+		}
+	}
+	return count;
+}
+
+/**
+*  Method: getRecordCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of route records that were stored.
+*/
+unsigned long SimpleZigBeeRouteCache::getRecordCount(){
+	return _recordCount;
+}
+
+/**
+*  Method: getSentCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of Create Source Route frames that were sent.
+*/
+unsigned long SimpleZigBeeRouteCache::getSentCount(){
+	return _sentCount;
+}
+
+/**
+*  Method: getRemoveCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of routes that were removed because a request sent along them failed.
+*/
+unsigned long SimpleZigBeeRouteCache::getRemoveCount(){
+	return _removeCount;
+}
+
+/**
+*  Method: resetCounters()
+*  @ Since v0.1.2, October 2026
+*  @ Resets the record, sent and remove counts.
+*/
+void SimpleZigBeeRouteCache::resetCounters(){
+	_recordCount = 0;
+	_sentCount = 0;
+	_removeCount = 0;
+}
+
+/*//////////////////////////////////////////////////////////////////////
+									PRIVATE METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: find(uint32_t adr64MSB, uint32_t adr64LSB)
+*  @ Since v0.1.2, October 2026
+*  @ Returns the index of the route to a 64-bit address, or -1 if there is none.
+*/
+int SimpleZigBeeRouteCache::find(uint32_t adr64MSB, uint32_t adr64LSB){
+	for( uint8_t i = 0; i < _routeCount; i++ ){
+		if( _routes[i].used && adr64LSB == _routes[i].address64LSB && adr64MSB == _routes[i].address64MSB ){
+			return i;
+		}
+	}
+	return -1;
+}
+
+/**
+*  Method: store(uint32_t adr64MSB, uint32_t adr64LSB, uint16_t adr16, uint8_t hopCount)
+*  @ Since v0.1.2, October 2026
+*  @ Finds or adds the route to a 64-bit address and returns its index (the hops must then be written and
+*    routeChanged() called). If every route is used, the route that was used least recently is replaced.
+*    Returns -1 (and removes the old route) if the route has too many hops.
+*/
+int SimpleZigBeeRouteCache::store(uint32_t adr64MSB, uint32_t adr64LSB, uint16_t adr16, uint8_t hopCount){
+	if( hopCount > _maxHops ){
+		remove( adr64MSB, adr64LSB );
+		return -1;
+	}
+	int index = find( adr64MSB, adr64LSB );
+	if( index < 0 ){
+		index = 0;
+		unsigned long now = millis();
+		for( uint8_t i = 0; i < _routeCount; i++ ){
+			if( !_routes[i].used ){
+				index = i;
+				break;
+			}
+			if( (now - _routes[i].time) > (now - _routes[index].time) ){
+				index = i;
+			}
+		}
+		if( _routes[index].used ){
+			remove( _routes[index].address64MSB, _routes[index].address64LSB );
+		}
+		SimpleZigBeeRoute & route = _routes[index];
+		route.address64MSB = adr64MSB;
+		route.address64LSB = adr64LSB;
+		route.hopCount = 0xFF;
+		route.frameID = 0;
+		route.used = true;
+	}
+	_routes[index].address16 = adr16;
+	_routes[index].time = millis();
+	return index;
+}
+
+/**
+*  Method: routeChanged(int index, bool changed)
+*  @ Since v0.1.2, October 2026
+*  @ Finishes storing a route. If the route in the XBee radio has changed, it must be sent again.
+*/
+void SimpleZigBeeRouteCache::routeChanged(int index, bool changed){
+	SimpleZigBeeRoute & route = _routes[index];
+	if( changed && _current && route.address64LSB == _currentLSB && route.address64MSB == _currentMSB ){
+		_current = false;
+	}
+	_recordCount++;
+}
+
+/**
+*  Method: recordReceived(const uint8_t* frameData, int frameLength)
+*  @ Since v0.1.2, October 2026
+*  @ Stores the route of a Route Record Indicator frame. The hops are already in the order of a Create 
+*    Source Route frame (starting with the neighbor of the device that sent the route record).
+*/
+void SimpleZigBeeRouteCache::recordReceived(const uint8_t* frameData, int frameLength){
+	if( frameLength < SimpleZigBeeRouteRecordLayout::MIN_FRAME_LENGTH ){
+		return;
+	}
+	uint8_t hopCount = frameData[SimpleZigBeeRouteRecordLayout::COUNT_INDEX];
+	if( frameLength < SimpleZigBeeRouteRecordLayout::ADDRESSES_INDEX + 2*hopCount ){
+		return;
+	}
+	int index = store( SimpleZigBeeBigEndian::read32( frameData + SimpleZigBeeRouteRecordLayout::ADDRESS64_INDEX ),
+		SimpleZigBeeBigEndian::read32( frameData + SimpleZigBeeRouteRecordLayout::ADDRESS64_INDEX + 4 ),
+		SimpleZigBeeBigEndian::read16( frameData + SimpleZigBeeRouteRecordLayout::ADDRESS16_INDEX ), hopCount );
+	if( index < 0 ){
+		return;
+	}
+	bool changed = _routes[index].hopCount != hopCount;
+	uint16_t* stored = _hops + index * _maxHops;
+	for( uint8_t i = 0; i < hopCount; i++ ){
+		uint16_t hop = SimpleZigBeeBigEndian::read16( frameData + SimpleZigBeeRouteRecordLayout::ADDRESSES_INDEX + 2*i );
+		changed |= stored[i] != hop;
+		stored[i] = hop;
+	}
+	_routes[index].hopCount = hopCount;
+	routeChanged( index, changed );
+}
+
+/**
+*  Method: statusReceived(const uint8_t* frameData, int frameLength)
+*  @ Since v0.1.2, October 2026
+*  @ Matches a TX status with the last request sent along each route. If the request could not be 
+*    delivered because the route may be broken, the route is removed.
+*/
+void SimpleZigBeeRouteCache::statusReceived(const uint8_t* frameData, int frameLength){
+	if( frameLength < SimpleZigBeeTxStatusLayout::MIN_FRAME_LENGTH ){
+		return;
+	}
+	uint8_t frameID = frameData[SimpleZigBeeTxStatusLayout::ID_INDEX];
+	if( 0 == frameID ){
+		return;
+	}
+	for( uint8_t i = 0; i < _routeCount; i++ ){
+		SimpleZigBeeRoute & route = _routes[i];
+		if( !route.used || frameID != route.frameID ){
+			continue;
+		}
+		route.frameID = 0;
+		switch( frameData[SimpleZigBeeTxStatusLayout::DELIVERY_STATUS_INDEX] ){
+			case TRANSMIT_STATUS_NETWORK_ACK_FAILURE:
+			case TRANSMIT_STATUS_ADDRESS_NOT_FOUND:
+			case TRANSMIT_STATUS_ROUTE_NOT_FOUND:
+				remove( route.address64MSB, route.address64LSB );
+				_removeCount++;
+				break;
+		}
+		return;
+	}
+}
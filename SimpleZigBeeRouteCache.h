@@ -0,0 +1,150 @@
+/**
+* Library Name: SimpleZigBeeRouteCache
+* Library URI: https://github.com/ericburger/simple-zigbee
+* Description: Keeps the routes reported by route record frames and creates a source
+* route in the XBee radio before each request to a device with a known route.
+* Version: 0.1.2
+* Author(s): Eric Burger
+* Author URI: WallflowerOpen.com
+* License: GNU General Public License v2.0 or later
+* License URI: http://www.gnu.org/licenses/gpl-2.0.html 
+*
+* Copyright (c) 2013 Eric Burger. All rights reserved.
+*
+* This file is part of SimpleZigBee, written for XBee S2 Radios.
+*
+* SimpleZigBee is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* SimpleZigBee is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with SimpleZigBee.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SimpleZigBeeRouteCache_h
+#define SimpleZigBeeRouteCache_h
+
+#include "Arduino.h"
+// Requires SimpleZigBeePacket classes
+#include "SimpleZigBeePacket.h"
+// Required for uint8_t type
+#include <inttypes.h>
+
+// Largest number of hops (not counting the source and destination) in a source route. The XBee radio
+// can store one source route of up to 10 hops.
+#ifndef SIMPLE_ZIGBEE_MAX_SOURCE_ROUTE_HOPS
+#define SIMPLE_ZIGBEE_MAX_SOURCE_ROUTE_HOPS 10
+#endif
+
+// Largest frame data of a Create Source Route frame: Frame Type, Frame ID, 64-bit Address, 16-bit Address,
+// Options, Number of Addresses, then 2 bytes per hop (see SimpleZigBeeRouteCache::prepareSourceRoute())
+#define SIMPLE_ZIGBEE_MAX_SOURCE_ROUTE_FRAME_LENGTH (14 + 2*SIMPLE_ZIGBEE_MAX_SOURCE_ROUTE_HOPS)
+
+/**
+* Struct: SimpleZigBeeRoute
+* @ Since v0.1.2, October 2026
+* @ Route to one device. The 16-bit addresses of the hops are kept by the route cache next to the route.
+*/
+struct SimpleZigBeeRoute {
+	uint32_t address64MSB;
+	uint32_t address64LSB;
+	uint16_t address16;
+	// Number of hops between this radio and the device
+	uint8_t hopCount;
+	// Frame ID of the last request sent along the route that is waiting for its TX status (0 if none)
+	uint8_t frameID;
+	// True if the route is in use
+	bool used;
+	// millis() when the route was last used
+	unsigned long time;
+};
+
+/**
+* Class: SimpleZigBeeRouteCache
+* @ Since v0.1.2, October 2026
+* @ Source routing for large networks. With many-to-one routing (the AR command on the data collector, 
+*   usually the coordinator), the other devices send a route record when they send data to the collector, 
+*   and the collector's XBee radio passes each one on as a Route Record Indicator (0xA1). The cache keeps
+*   the route of up to a fixed number of devices. Before a request to a device with a route is sent, a 
+*   Create Source Route frame (0x21) puts the route in the XBee radio, which then sends the request along
+*   it without a route discovery (a broadcast that floods the network).
+*   The XBee radio stores one source route at a time, so the Create Source Route frame is only sent when
+*   the request goes to a different device than the last one (or its route has changed). 
+*   A route is removed when a request sent along it fails with NETWORK_ACK_FAILURE, ADDRESS_NOT_FOUND or 
+*   ROUTE_NOT_FOUND, so the next request uses route discovery until a new route record arrives. Routes with 
+*   more hops than the cache can store are not kept. When all routes are used, the route that was used 
+*   least recently is replaced.
+*   When set in the radio (see SimpleZigBeeRadio::setRouteCache()), every incoming packet is checked and
+*   send() and sendTXRequest() create the source route when it is needed. The storage for the routes is 
+*   provided by SimpleZigBeeRouteCacheT (see below).
+*   Example:
+*     SimpleZigBeeRouteCacheT<16> routes;
+*     xbee.setRouteCache( routes );
+*/
+class SimpleZigBeeRouteCache {
+public:
+	// INITIALIZATION METHODS //
+	SimpleZigBeeRouteCache(SimpleZigBeeRoute* routeStorage, uint16_t* hopStorage, uint8_t routes, uint8_t maxHops);
+	void clear();
+	
+	// ROUTE METHODS //
+	bool setRoute(uint32_t adr64MSB, uint32_t adr64LSB, uint16_t adr16, const uint16_t* hops, uint8_t hopCount);
+	int getRoute(uint32_t adr64MSB, uint32_t adr64LSB, uint16_t* hops, uint8_t maxHops);
+	bool remove(uint32_t adr64MSB, uint32_t adr64LSB);
+	void packetReceived(SimpleZigBeePacket & packet);
+	int prepareSourceRoute(const uint8_t* frameData, int frameLength, uint8_t* routeFrameData);
+	void sourceRouteSent(const uint8_t* routeFrameData);
+	
+	// STATISTICS METHODS //
+	uint8_t getCount();
+	unsigned long getRecordCount();
+	unsigned long getSentCount();
+	unsigned long getRemoveCount();
+	void resetCounters();
+
+private:
+	int find(uint32_t adr64MSB, uint32_t adr64LSB);
+	int store(uint32_t adr64MSB, uint32_t adr64LSB, uint16_t adr16, uint8_t hopCount);
+	void routeChanged(int index, bool changed);
+	void recordReceived(const uint8_t* frameData, int frameLength);
+	void statusReceived(const uint8_t* frameData, int frameLength);
+
+	SimpleZigBeeRoute* _routes;
+	uint16_t* _hops;
+	uint8_t _routeCount;
+	uint8_t _maxHops;
+	// Destination of the source route stored in the XBee radio (valid if _current is true)
+	uint32_t _currentMSB;
+	uint32_t _currentLSB;
+	bool _current;
+	// Number of route records stored, source routes sent and routes removed after a failed request
+	unsigned long _recordCount;
+	unsigned long _sentCount;
+	unsigned long _removeCount;
+};
+
+/**
+* Class: SimpleZigBeeRouteCacheT
+* @ Since v0.1.2, October 2026
+* @ Route cache that holds its own storage for Routes routes of up to MaxHops hops each.
+*/
+template<uint8_t Routes, uint8_t MaxHops = SIMPLE_ZIGBEE_MAX_SOURCE_ROUTE_HOPS>
+class SimpleZigBeeRouteCacheT : public SimpleZigBeeRouteCache {
+public:
+	SimpleZigBeeRouteCacheT() : SimpleZigBeeRouteCache(_route_storage, _hop_storage, Routes, MaxHops) {}
+
+private:
+	static_assert( Routes >= 1, "Routes must be between 1 and 255" );
+	static_assert( MaxHops >= 1 && MaxHops <= SIMPLE_ZIGBEE_MAX_SOURCE_ROUTE_HOPS, "MaxHops must be between 1 and SIMPLE_ZIGBEE_MAX_SOURCE_ROUTE_HOPS" );
+	SimpleZigBeeRoute _route_storage[Routes];
+	uint16_t _hop_storage[Routes * MaxHops];
+};
+
+#endif //SimpleZigBeeRouteCache_h
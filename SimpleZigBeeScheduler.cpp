@@ -0,0 +1,632 @@
+/**
+* Copyright (c) 2013 Eric Burger. All rights reserved.
+*/
+
+#include "SimpleZigBeeScheduler.h"
+// Frame index of each field (frame layouts)
+#include "SimpleZigBeeFrames.h"
+// Requires SimpleZigBeeRadio class for sending the queued requests
+#include "SimpleZigBeeRadio.h"
+
+/*//////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////
+									SimpleZigBeeScheduler Class
+////////////////////////////////////////////////////////////////////////
+/*//////////////////////////////////////////////////////////////////////
+
+/*//////////////////////////////////////////////////////////////////////
+									INITIALIZATION METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Constructor: SimpleZigBeeScheduler(SimpleZigBeeScheduledFrame* slotStorage, uint8_t* frameStorage, uint8_t slots, SimpleZigBeeFlow* flowStorage, uint8_t flows, int maxFrameLength)
+*  @ Since v0.1.2, October 2026
+*  @ Creates a scheduler using the provided storage. Normally called by SimpleZigBeeSchedulerT.
+*  @ param SimpleZigBeeScheduledFrame* slotStorage: Array of slots
+*  @ param uint8_t* frameStorage: Array of slots*maxFrameLength bytes
+*  @ param uint8_t slots: Number of requests that can be queued
+*  @ param SimpleZigBeeFlow* flowStorage: Array of flows
+*  @ param uint8_t flows: Number of destinations that can have queued requests at once
+*  @ param int maxFrameLength: Largest frame length that can be queued
+*/
+SimpleZigBeeScheduler::SimpleZigBeeScheduler(SimpleZigBeeScheduledFrame* slotStorage, uint8_t* frameStorage, uint8_t slots, SimpleZigBeeFlow* flowStorage, uint8_t flows, int maxFrameLength){
+	_slots = slotStorage;
+	_frames = frameStorage;
+	_slotCount = slots;
+	_flows = flowStorage;
+	_flowCount = flows;
+	_maxFrameLength = maxFrameLength;
+	_priority = PRIORITY_INTERACTIVE;
+	_weight[PRIORITY_CONTROL] = 1;
+	_weight[PRIORITY_INTERACTIVE] = 4;
+	_weight[PRIORITY_BULK] = 1;
+	_quantum = maxFrameLength;
+	_statusTimeout = SIMPLE_ZIGBEE_REQUEST_TIMEOUT;
+	_sending = false;
+	clear();
+}
+
+/**
+*  Method: clear()
+*  @ Since v0.1.2, October 2026
+*  @ Drops every queued request (they are not sent) and resets the counters.
+*/
+void SimpleZigBeeScheduler::clear(){
+	for( uint8_t i = 0; i < _slotCount; i++ ){
+		_slots[i].used = false;
+	}
+	for( uint8_t i = 0; i < _flowCount; i++ ){
+		_flows[i].used = false;
+	}
+	for( uint8_t p = 0; p < SIMPLE_ZIGBEE_PRIORITY_CLASSES; p++ ){
+		_next[p] = 0;
+		_started[p] = false;
+		_depth[p] = 0;
+	}
+	_turn = PRIORITY_INTERACTIVE;
+	_credit = _weight[_turn];
+	resetCounters();
+}
+
+/**
+*  Method: setPriority(uint8_t priority)
+*  @ Since v0.1.2, October 2026
+*  @ Sets the priority class of the requests that the radio queues from now on (PRIORITY_INTERACTIVE by default).
+*  @ param uint8_t priority: PRIORITY_CONTROL, PRIORITY_INTERACTIVE or PRIORITY_BULK
+*/
+void SimpleZigBeeScheduler::setPriority(uint8_t priority){
+	if( priority < SIMPLE_ZIGBEE_PRIORITY_CLASSES ){
+		_priority = priority;
+	}
+}
+
+/**
+*  Method: getPriority()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the priority class of the requests that the radio queues.
+*/
+uint8_t SimpleZigBeeScheduler::getPriority(){
+	return _priority;
+}
+
+/**
+*  Method: setWeight(uint8_t priority, uint8_t weight)
+*  @ Since v0.1.2, October 2026
+*  @ Sets how many requests of PRIORITY_INTERACTIVE or PRIORITY_BULK are sent in a row while requests of
+*    the other class are waiting (4 and 1 by default). PRIORITY_CONTROL has no weight, since it always goes first.
+*  @ param uint8_t priority: PRIORITY_INTERACTIVE or PRIORITY_BULK
+*  @ param uint8_t weight: Requests per turn (at least 1)
+*/
+void SimpleZigBeeScheduler::setWeight(uint8_t priority, uint8_t weight){
+	if( PRIORITY_CONTROL == priority || priority >= SIMPLE_ZIGBEE_PRIORITY_CLASSES ){
+		return;
+	}
+	_weight[priority] = (0 == weight) ? 1 : weight;
+	if( _credit > _weight[_turn] ){
+		_credit = _weight[_turn];
+	}
+}
+
+/**
+*  Method: setQuantum(int quantum)
+*  @ Since v0.1.2, October 2026
+*  @ Sets the number of bytes of frame data a destination may send in each of its turns (the largest frame
+*    length by default, so each destination sends at least one request per turn).
+*  @ param int quantum: Bytes per turn (at least 1)
+*/
+void SimpleZigBeeScheduler::setQuantum(int quantum){
+	_quantum = (quantum < 1) ? 1 : quantum;
+}
+
+/**
+*  Method: setStatusTimeout(unsigned long timeout)
+*  @ Since v0.1.2, October 2026
+*  @ Sets the number of milliseconds a destination waits for the status of its last request before its 
+*    next request is sent anyway (SIMPLE_ZIGBEE_REQUEST_TIMEOUT by default). With 0, destinations never wait
+*    and only the deficit round-robin decides the order.
+*  @ param unsigned long timeout: Time in milliseconds
+*/
+void SimpleZigBeeScheduler::setStatusTimeout(unsigned long timeout){
+	_statusTimeout = timeout;
+	if( 0 == timeout ){
+		for( uint8_t i = 0; i < _flowCount; i++ ){
+			_flows[i].frameID = 0;
+			releaseFlow( i );
+		}
+	}
+}
+
+/*//////////////////////////////////////////////////////////////////////
+									SCHEDULING METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: isSchedulable(const uint8_t* frameData, int frameLength)
+*  @ Since v0.1.2, October 2026
+*  @ Returns true if the frame is a request to another device (TX request, explicit addressing command
+*    or remote AT command), which the scheduler can queue by destination.
+*  @ param const uint8_t* frameData: Frame data (starting with the frame type)
+*  @ param int frameLength: Number of bytes of frame data
+*/
+bool SimpleZigBeeScheduler::isSchedulable(const uint8_t* frameData, int frameLength){
+	if( NULL == frameData || frameLength < SimpleZigBeeTxRequestLayout::ADDRESS16_INDEX + 2 ){
+		return false;
+	}
+	return ZIGBEE_TRANSMIT_REQUEST == frameData[0] || ZIGBEE_EXPLICIT_ADDRESSING_COMMAND_FRAME == frameData[0] || REMOTE_AT_COMMAND == frameData[0];
+}
+
+/**
+*  Method: enqueue(SimpleZigBeePacket & packet)
+*  @ Since v0.1.2, October 2026
+*  @ Queues a copy of a request with the current priority (see setPriority()). Returns false if the request
+*    could not be queued (see enqueue(const uint8_t* header, ...)). The frame ID of the request is replaced
+*    when it is sent (see service()). Called by SimpleZigBeeRadio::send().
+*  @ param SimpleZigBeePacket & packet: Request to queue
+*/
+bool SimpleZigBeeScheduler::enqueue(SimpleZigBeePacket & packet){
+	return enqueue( packet, _priority );
+}
+
+/**
+*  Method: enqueue(SimpleZigBeePacket & packet, uint8_t priority)
+*  @ Since v0.1.2, October 2026
+*  @ Queues a copy of a request with the given priority. Returns false if the request could not be 
+*    queued (see enqueue(const uint8_t* header, ...)).
+*  @ param SimpleZigBeePacket & packet: Request to queue
+*  @ param uint8_t priority: PRIORITY_CONTROL, PRIORITY_INTERACTIVE or PRIORITY_BULK
+*/
+bool SimpleZigBeeScheduler::enqueue(SimpleZigBeePacket & packet, uint8_t priority){
+	return enqueue( packet.getFrameDataPointer(), packet.getFrameLength(), NULL, 0, priority );
+}
+
+/**
+*  Method: enqueue(const uint8_t* header, int headerLength, const SimpleZigBeeSegment* segments, uint8_t segmentCount, uint8_t priority)
+*  @ Since v0.1.2, October 2026
+*  @ Queues a copy of a request that is given as a header and payload segments, which are copied one
+*    after the other. Returns false, and counts the request as dropped (see getDropCount()), if it is 
+*    not a request to another device (see isSchedulable()), is too long, all slots are in use or all 
+*    flows are used by other destinations. Called by SimpleZigBeeRadio::sendFrame().
+*  @ param const uint8_t* header: Frame data up to the payload (starting with the frame type)
+*  @ param int headerLength: Number of bytes in header
+*  @ param const SimpleZigBeeSegment* segments: Array of payload segments (may be NULL if segmentCount is 0)
+*  @ param uint8_t segmentCount: Number of segments
+*  @ param uint8_t priority: PRIORITY_CONTROL, PRIORITY_INTERACTIVE or PRIORITY_BULK
+*/
+bool SimpleZigBeeScheduler::enqueue(const uint8_t* header, int headerLength, const SimpleZigBeeSegment* segments, uint8_t segmentCount, uint8_t priority){
+	int frameLength = headerLength;
+	for( uint8_t i = 0; i < segmentCount; i++ ){
+		frameLength += segments[i].length;
+	}
+	if( !isSchedulable( header, headerLength ) || frameLength > _maxFrameLength || priority >= SIMPLE_ZIGBEE_PRIORITY_CLASSES ){
+		_dropCount++;
+		return false;
+	}
+	int index;
+	for( index = 0; index < _slotCount; index++ ){
+		if( !_slots[index].used ){
+			break;
+		}
+	}
+	uint32_t adr64MSB = SimpleZigBeeBigEndian::read32( header + SimpleZigBeeTxRequestLayout::ADDRESS64_INDEX );
+	uint32_t adr64LSB = SimpleZigBeeBigEndian::read32( header + SimpleZigBeeTxRequestLayout::ADDRESS64_INDEX + 4 );
+	if( 0xffffffff == adr64MSB && 0xffffffff == adr64LSB ){
+		// The 64-bit address is unknown, so the destination is told apart by its 16-bit address
+		adr64LSB = 0xffff0000 | SimpleZigBeeBigEndian::read16( header + SimpleZigBeeTxRequestLayout::ADDRESS16_INDEX );
+	}
+	int flow = findFlow( adr64MSB, adr64LSB );
+	if( flow < 0 ){
+		for( flow = 0; flow < _flowCount; flow++ ){
+			if( !_flows[flow].used ){
+				break;
+			}
+		}
+		if( flow == _flowCount ){
+			flow = -1;
+		}
+	}
+	if( index == _slotCount || flow < 0 ){
+		_dropCount++;
+		return false;
+	}
+	SimpleZigBeeFlow & f = _flows[flow];
+	if( !f.used ){
+		f.address64MSB = adr64MSB;
+		f.address64LSB = adr64LSB;
+		for( uint8_t p = 0; p < SIMPLE_ZIGBEE_PRIORITY_CLASSES; p++ ){
+			f.head[p] = SCHEDULER_NONE;
+			f.tail[p] = SCHEDULER_NONE;
+			f.deficit[p] = 0;
+		}
+		f.depth = 0;
+		f.frameID = 0;
+		f.used = true;
+	}
+	uint8_t* data = frameData(index);
+	memcpy( data, header, headerLength );
+	data += headerLength;
+	for( uint8_t i = 0; i < segmentCount; i++ ){
+		memcpy( data, segments[i].data, segments[i].length );
+		data += segments[i].length;
+	}
+	SimpleZigBeeScheduledFrame & s = _slots[index];
+	s.next = SCHEDULER_NONE;
+	s.flow = flow;
+	s.priority = priority;
+	s.used = true;
+	s.frameLength = frameLength;
+	s.time = millis();
+	if( SCHEDULER_NONE == f.tail[priority] ){
+		f.head[priority] = index;
+	}else{
+		_slots[f.tail[priority]].next = index;
+	}
+	f.tail[priority] = index;
+	f.depth++;
+	_depth[priority]++;
+	uint8_t depth = getDepth();
+	if( depth > _highWaterMark ){
+		_highWaterMark = depth;
+	}
+	return true;
+}
+
+/**
+*  Method: packetReceived(SimpleZigBeePacket & packet)
+*  @ Since v0.1.2, October 2026
+*  @ Checks a received TX status or remote AT command response. If it is the status of the last request
+*    sent to a destination, the destination stops waiting and its next request can be sent. Called by 
+*    the radio for each received packet.
+*  @ param SimpleZigBeePacket & packet: Received packet
+*/
+void SimpleZigBeeScheduler::packetReceived(SimpleZigBeePacket & packet){
+	const uint8_t* data = packet.getFrameDataPointer();
+	if( NULL == data || packet.getFrameLength() < 2 || (ZIGBEE_TX_STATUS != data[0] && REMOTE_AT_COMMAND_RESPONSE != data[0]) ){
+		return;
+	}
+	uint8_t frameID = data[SimpleZigBeeTxStatusLayout::ID_INDEX];
+	if( 0 == frameID ){
+		return;
+	}
+	for( uint8_t i = 0; i < _flowCount; i++ ){
+		if( _flows[i].used && frameID == _flows[i].frameID ){
+			_flows[i].frameID = 0;
+			releaseFlow( i );
+		}
+	}
+}
+
+/**
+*  Method: service(SimpleZigBeeRadio & radio)
+*  @ Since v0.1.2, October 2026
+*  @ Sends queued requests, as long as the radio can send (see SimpleZigBeeRadio::canSend() and canWrite()).
+*    Requests of PRIORITY_CONTROL go first, then PRIORITY_INTERACTIVE and PRIORITY_BULK take turns by 
+*    weight (see setWeight()). Within a class, the destinations take turns by deficit round-robin, and
+*    destinations that wait for the status of their last request are skipped. A request that asks for a
+*    status (frame ID other than 0) is given the next free frame ID when it is sent (see 
+*    SimpleZigBeeRadio::getNextFrameID()), so the frame ID given when it was prepared is not the one sent,
+*    and the scheduler stops if no frame ID is free. Returns the number of requests sent. Called by 
+*    SimpleZigBeeRadio::poll().
+*  @ param SimpleZigBeeRadio & radio: Radio that sends the requests
+*/
+int SimpleZigBeeScheduler::service(SimpleZigBeeRadio & radio){
+	unsigned long now = millis();
+	for( uint8_t i = 0; i < _flowCount; i++ ){
+		if( _flows[i].used && 0 != _flows[i].frameID && now - _flows[i].sentTime >= _statusTimeout ){
+			_flows[i].frameID = 0;
+			releaseFlow( i );
+		}
+	}
+	int sent = 0;
+	while( radio.canSend() ){
+		int priority = choosePriority();
+		if( priority < 0 ){
+			break;
+		}
+		int index = select( priority );
+		SimpleZigBeeScheduledFrame & s = _slots[index];
+		if( !radio.canWrite( s.frameLength ) ){
+			break;
+		}
+		uint8_t* data = frameData(index);
+		// The frame ID given when the request was prepared was not reserved, and may have been used by 
+		// another request since, so a request that asks for a status takes the next free frame ID now
+		if( 0 != data[SimpleZigBeeTxRequestLayout::ID_INDEX] ){
+			uint8_t frameID = radio.getNextFrameID();
+			if( 0 == frameID ){
+				break;
+			}
+			data[SimpleZigBeeTxRequestLayout::ID_INDEX] = frameID;
+			radio.saveLastFrameID( frameID );
+		}
+		SimpleZigBeePacketRef<> packet( data, s.frameLength );
+		_sending = true;
+		bool written = radio.send( packet );
+		_sending = false;
+		if( !written ){
+			// A Create Source Route frame did not fit with the request, so it stays first in its queue
+			break;
+		}
+		SimpleZigBeeFlow & f = _flows[s.flow];
+		f.head[priority] = s.next;
+		if( SCHEDULER_NONE == s.next ){
+			f.tail[priority] = SCHEDULER_NONE;
+		}
+		f.deficit[priority] -= s.frameLength;
+		f.depth--;
+		_depth[priority]--;
+		if( 0 != _statusTimeout ){
+			f.frameID = data[SimpleZigBeeTxRequestLayout::ID_INDEX];
+			f.sentTime = now;
+		}
+		unsigned long latency = now - s.time;
+		_sentCount[priority]++;
+		_latencySum[priority] += latency;
+		if( latency > _maxLatency[priority] ){
+			_maxLatency[priority] = latency;
+		}
+		s.used = false;
+		releaseFlow( s.flow );
+		sent++;
+	}
+	return sent;
+}
+
+/**
+*  Method: isSending()
+*  @ Since v0.1.2, October 2026
+*  @ Returns true while service() is sending a queued request, so the radio sends it instead of queuing it again.
+*/
+bool SimpleZigBeeScheduler::isSending(){
+	return _sending;
+}
+
+/*//////////////////////////////////////////////////////////////////////
+									STATISTICS METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: getDepth()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of queued requests.
+*/
+uint8_t SimpleZigBeeScheduler::getDepth(){
+	uint8_t depth = 0;
+	for( uint8_t p = 0; p < SIMPLE_ZIGBEE_PRIORITY_CLASSES; p++ ){
+		depth += _depth[p];
+	}
+	return depth;
+}
+
+/**
+*  Method: getFreeCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of requests that can still be queued.
+*/
+uint8_t SimpleZigBeeScheduler::getFreeCount(){
+	return _slotCount - getDepth();
+}
+
+/**
+*  Method: getDepth(uint8_t priority)
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of queued requests of a priority class.
+*  @ param uint8_t priority: PRIORITY_CONTROL, PRIORITY_INTERACTIVE or PRIORITY_BULK
+*/
+uint8_t SimpleZigBeeScheduler::getDepth(uint8_t priority){
+	if( priority >= SIMPLE_ZIGBEE_PRIORITY_CLASSES ){
+		return 0;
+	}
+	return _depth[priority];
+}
+
+/**
+*  Method: getDepth(uint32_t adr64MSB, uint32_t adr64LSB)
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of requests queued for a destination.
+*  @ param uint32_t adr64MSB: Upper 32 bits of the 64-bit address
+*  @ param uint32_t adr64LSB: Lower 32 bits of the 64-bit address
+*/
+uint8_t SimpleZigBeeScheduler::getDepth(uint32_t adr64MSB, uint32_t adr64LSB){
+	int flow = findFlow( adr64MSB, adr64LSB );
+	if( flow < 0 ){
+		return 0;
+	}
+	return _flows[flow].depth;
+}
+
+/**
+*  Method: getHighWaterMark()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the largest number of requests that have been queued at once.
+*/
+uint8_t SimpleZigBeeScheduler::getHighWaterMark(){
+	return _highWaterMark;
+}
+
+/**
+*  Method: getSentCount(uint8_t priority)
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of queued requests of a priority class that were sent.
+*  @ param uint8_t priority: PRIORITY_CONTROL, PRIORITY_INTERACTIVE or PRIORITY_BULK
+*/
+unsigned long SimpleZigBeeScheduler::getSentCount(uint8_t priority){
+	if( priority >= SIMPLE_ZIGBEE_PRIORITY_CLASSES ){
+		return 0;
+	}
+	return _sentCount[priority];
+}
+
+/**
+*  Method: getAverageLatency(uint8_t priority)
+*  @ Since v0.1.2, October 2026
+*  @ Returns the average time (milliseconds) that the sent requests of a priority class waited in the queue.
+*  @ param uint8_t priority: PRIORITY_CONTROL, PRIORITY_INTERACTIVE or PRIORITY_BULK
+*/
+unsigned long SimpleZigBeeScheduler::getAverageLatency(uint8_t priority){
+	if( priority >= SIMPLE_ZIGBEE_PRIORITY_CLASSES || 0 == _sentCount[priority] ){
+		return 0;
+	}
+	return _latencySum[priority] / _sentCount[priority];
+}
+
+/**
+*  Method: getMaxLatency(uint8_t priority)
+*  @ Since v0.1.2, October 2026
+*  @ Returns the longest time (milliseconds) that a sent request of a priority class waited in the queue.
+*  @ param uint8_t priority: PRIORITY_CONTROL, PRIORITY_INTERACTIVE or PRIORITY_BULK
+*/
+unsigned long SimpleZigBeeScheduler::getMaxLatency(uint8_t priority){
+	if( priority >= SIMPLE_ZIGBEE_PRIORITY_CLASSES ){
+		return 0;
+	}
+	return _maxLatency[priority];
+}
+
+/**
+*  Method: getDropCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of requests that could not be queued (all slots or flows in use, or frame too long).
+*/
+unsigned long SimpleZigBeeScheduler::getDropCount(){
+	return _dropCount;
+}
+
+/**
+*  Method: resetCounters()
+*  @ Since v0.1.2, October 2026
+*  @ Resets the high water mark, the sent counts, the latencies and the drop count.
+*/
+void SimpleZigBeeScheduler::resetCounters(){
+	_highWaterMark = getDepth();
+	for( uint8_t p = 0; p < SIMPLE_ZIGBEE_PRIORITY_CLASSES; p++ ){
+		_sentCount[p] = 0;
+		_latencySum[p] = 0;
+		_maxLatency[p] = 0;
+	}
+	_dropCount = 0;
+}
+
+/*//////////////////////////////////////////////////////////////////////
+									PRIVATE METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: findFlow(uint32_t adr64MSB, uint32_t adr64LSB)
+*  @ Since v0.1.2, October 2026
+*  @ Returns the index of the flow of a destination, or -1.
+*  @ param uint32_t adr64MSB: Upper 32 bits of the 64-bit address
+*  @ param uint32_t adr64LSB: Lower 32 bits of the 64-bit address
+*/
+int SimpleZigBeeScheduler::findFlow(uint32_t adr64MSB, uint32_t adr64LSB){
+	for( int i = 0; i < _flowCount; i++ ){
+		if( _flows[i].used && adr64MSB == _flows[i].address64MSB && adr64LSB == _flows[i].address64LSB ){
+			return i;
+		}
+	}
+	return -1;
+}
+
+/**
+*  Method: frameData(int index)
+*  @ Since v0.1.2, October 2026
+*  @ Returns a pointer to the frame data stored for a slot.
+*  @ param int index: Index of the slot
+*/
+uint8_t* SimpleZigBeeScheduler::frameData(int index){
+	return _frames + (index * _maxFrameLength);
+}
+
+/**
+*  Method: isReady(uint8_t flow, uint8_t priority)
+*  @ Since v0.1.2, October 2026
+*  @ Returns true if a destination has a request of a priority class queued and is not waiting for a status.
+*  @ param uint8_t flow: Index of the flow
+*  @ param uint8_t priority: Priority class
+*/
+bool SimpleZigBeeScheduler::isReady(uint8_t flow, uint8_t priority){
+	return _flows[flow].used && 0 == _flows[flow].frameID && SCHEDULER_NONE != _flows[flow].head[priority];
+}
+
+/**
+*  Method: hasReady(uint8_t priority)
+*  @ Since v0.1.2, October 2026
+*  @ Returns true if any destination is ready to send a request of a priority class (see isReady()).
+*  @ param uint8_t priority: Priority class
+*/
+bool SimpleZigBeeScheduler::hasReady(uint8_t priority){
+	if( 0 == _depth[priority] ){
+		return false;
+	}
+	for( uint8_t i = 0; i < _flowCount; i++ ){
+		if( isReady( i, priority ) ){
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+*  Method: choosePriority()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the priority class of the next request to send, or -1 if no destination is ready. When both
+*    PRIORITY_INTERACTIVE and PRIORITY_BULK are ready, the class whose turn it is goes (and uses up one request
+*    of its weight), until its weight is used up.
+*/
+int SimpleZigBeeScheduler::choosePriority(){
+	if( hasReady( PRIORITY_CONTROL ) ){
+		return PRIORITY_CONTROL;
+	}
+	bool interactive = hasReady( PRIORITY_INTERACTIVE );
+	bool bulk = hasReady( PRIORITY_BULK );
+	if( !interactive || !bulk ){
+		return interactive ? PRIORITY_INTERACTIVE : (bulk ? PRIORITY_BULK : -1);
+	}
+	if( 0 == _credit ){
+		_turn = (PRIORITY_INTERACTIVE == _turn) ? PRIORITY_BULK : PRIORITY_INTERACTIVE;
+		_credit = _weight[_turn];
+	}
+	_credit--;
+	return _turn;
+}
+
+/**
+*  Method: select(uint8_t priority)
+*  @ Since v0.1.2, October 2026
+*  @ Deficit round-robin over the destinations with requests of a priority class. The destination whose 
+*    turn it is gets the quantum added to its deficit when its turn starts, and sends while its next
+*    request is not longer than its deficit. Then the turn passes to the next destination. A destination
+*    without requests of the class loses its deficit. Returns the slot of the next request to send. 
+*    The class must have a ready destination (see hasReady()).
+*  @ param uint8_t priority: Priority class
+*/
+int SimpleZigBeeScheduler::select(uint8_t priority){
+	while( true ){
+		uint8_t i = _next[priority];
+		SimpleZigBeeFlow & f = _flows[i];
+		if( isReady( i, priority ) ){
+			if( !_started[priority] ){
+				f.deficit[priority] += _quantum;
+				_started[priority] = true;
+			}
+			if( _slots[f.head[priority]].frameLength <= f.deficit[priority] ){
+				return f.head[priority];
+			}
+		}else if( f.used && SCHEDULER_NONE == f.head[priority] ){
+			f.deficit[priority] = 0;
+		}
+		_next[priority] = (i + 1) % _flowCount;
+		_started[priority] = false;
+	}
+}
+
+/**
+*  Method: releaseFlow(uint8_t flow)
+*  @ Since v0.1.2, October 2026
+*  @ Frees the flow of a destination that has no queued requests and is not waiting for a status.
+*  @ param uint8_t flow: Index of the flow
+*/
+void SimpleZigBeeScheduler::releaseFlow(uint8_t flow){
+	if( _flows[flow].used && 0 == _flows[flow].depth && 0 == _flows[flow].frameID ){
+		_flows[flow].used = false;
+	}
+}
@@ -0,0 +1,212 @@
+/**
+* Library Name: SimpleZigBeeScheduler
+* Library URI: https://github.com/ericburger/simple-zigbee
+* Description: Queues outgoing requests by destination and priority class and sends
+* them in an order that keeps one busy or unreachable device from holding up the others.
+* Version: 0.1.2
+* Author(s): Eric Burger
+* Author URI: WallflowerOpen.com
+* License: GNU General Public License v2.0 or later
+* License URI: http://www.gnu.org/licenses/gpl-2.0.html 
+*
+* Copyright (c) 2013 Eric Burger. All rights reserved.
+*
+* This file is part of SimpleZigBee, written for XBee S2 Radios.
+*
+* SimpleZigBee is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* SimpleZigBee is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with SimpleZigBee.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SimpleZigBeeScheduler_h
+#define SimpleZigBeeScheduler_h
+
+#include "Arduino.h"
+// Requires SimpleZigBeePacket classes
+#include "SimpleZigBeePacket.h"
+// Requires SimpleZigBeeSegment struct
+#include "SimpleZigBeeCodec.h"
+// Requires SIMPLE_ZIGBEE_REQUEST_TIMEOUT
+#include "SimpleZigBeeRequestTable.h"
+// Required for uint8_t type
+#include <inttypes.h>
+
+// Priority Classes (see SimpleZigBeeScheduler::setPriority())
+#define PRIORITY_CONTROL 0
+#define PRIORITY_INTERACTIVE 1
+#define PRIORITY_BULK 2
+#define SIMPLE_ZIGBEE_PRIORITY_CLASSES 3
+
+// Marks the end of a queue
+#define SCHEDULER_NONE 0xff
+
+/**
+* Struct: SimpleZigBeeScheduledFrame
+* @ Since v0.1.2, October 2026
+* @ One queued request. The frame data is kept by the scheduler next to the slot.
+*/
+struct SimpleZigBeeScheduledFrame {
+	// Index of the next slot in the same queue (SCHEDULER_NONE if last)
+	uint8_t next;
+	// Index of the destination of the request
+	uint8_t flow;
+	uint8_t priority;
+	bool used;
+	int frameLength;
+	// millis() when the request was queued
+	unsigned long time;
+};
+
+/**
+* Struct: SimpleZigBeeFlow
+* @ Since v0.1.2, October 2026
+* @ Queues of one destination, one per priority class.
+*/
+struct SimpleZigBeeFlow {
+	uint32_t address64MSB;
+	uint32_t address64LSB;
+	// First and last slot of the queue of each class (SCHEDULER_NONE if empty)
+	uint8_t head[SIMPLE_ZIGBEE_PRIORITY_CLASSES];
+	uint8_t tail[SIMPLE_ZIGBEE_PRIORITY_CLASSES];
+	// Deficit round-robin: bytes that may still be sent in the current turn of each class
+	int deficit[SIMPLE_ZIGBEE_PRIORITY_CLASSES];
+	// Number of queued requests
+	uint8_t depth;
+	// Frame ID of the last request sent, while waiting for its status (0 if not waiting)
+	uint8_t frameID;
+	// millis() when the last request was sent
+	unsigned long sentTime;
+	bool used;
+};
+
+// Radio used to send the queued requests (see SimpleZigBeeRadio.h)
+class SimpleZigBeeRadio;
+
+/**
+* Class: SimpleZigBeeScheduler
+* @ Since v0.1.2, October 2026
+* @ Queues TX requests and remote AT commands by destination and priority class, and sends them in this order:
+*     - PRIORITY_CONTROL (alarms, commands) always goes first
+*     - PRIORITY_INTERACTIVE and PRIORITY_BULK share what is left by weight (by default, 4 interactive
+*       requests for each bulk request while both are waiting, see setWeight())
+*     - Within a class, the destinations take turns (deficit round-robin): each turn, a destination may send 
+*       up to the quantum in bytes of frame data (see setQuantum()), so a destination with long requests
+*       does not get more than its share.
+*   A destination that is waiting for the status of its last request (TX status or remote AT command 
+*   response) is skipped until the status arrives or the status timeout passes (see setStatusTimeout()), 
+*   so a slow or unreachable device holds up only its own requests. 
+*   When set in the radio (see SimpleZigBeeRadio::setScheduler()), requests sent with send(), sendFrame() or 
+*   sendTXRequest() are queued with the current priority (see setPriority()) and poll() sends them while
+*   SimpleZigBeeRadio::canSend() and SimpleZigBeeRadio::canWrite() allow. Other frames (for example, local
+*   AT commands) and retries from the retransmitter are sent at once. Queued requests that ask for a status
+*   are given their frame ID when poll() sends them, not when they are prepared, so the frame ID read from
+*   the radio after send() (see SimpleZigBeeRadio::getLastFrameID()) may not be the one sent. The storage 
+*   for the requests is provided by SimpleZigBeeSchedulerT (see below).
+*   Example:
+*     SimpleZigBeeSchedulerT<8> scheduler;
+*     xbee.setScheduler( scheduler );
+*     scheduler.setPriority( PRIORITY_CONTROL );
+*     xbee.send();
+*/
+class SimpleZigBeeScheduler {
+public:
+	// INITIALIZATION METHODS //
+	SimpleZigBeeScheduler(SimpleZigBeeScheduledFrame* slotStorage, uint8_t* frameStorage, uint8_t slots, SimpleZigBeeFlow* flowStorage, uint8_t flows, int maxFrameLength);
+	void clear();
+	void setPriority(uint8_t priority);
+	uint8_t getPriority();
+	void setWeight(uint8_t priority, uint8_t weight);
+	void setQuantum(int quantum);
+	void setStatusTimeout(unsigned long timeout);
+	
+	// SCHEDULING METHODS //
+	static bool isSchedulable(const uint8_t* frameData, int frameLength);
+	bool enqueue(SimpleZigBeePacket & packet);
+	bool enqueue(SimpleZigBeePacket & packet, uint8_t priority);
+	bool enqueue(const uint8_t* header, int headerLength, const SimpleZigBeeSegment* segments, uint8_t segmentCount, uint8_t priority);
+	void packetReceived(SimpleZigBeePacket & packet);
+	int service(SimpleZigBeeRadio & radio);
+	bool isSending();
+	
+	// STATISTICS METHODS //
+	uint8_t getDepth();
+	uint8_t getDepth(uint8_t priority);
+	uint8_t getDepth(uint32_t adr64MSB, uint32_t adr64LSB);
+	uint8_t getFreeCount();
+	uint8_t getHighWaterMark();
+	unsigned long getSentCount(uint8_t priority);
+	unsigned long getAverageLatency(uint8_t priority);
+	unsigned long getMaxLatency(uint8_t priority);
+	unsigned long getDropCount();
+	void resetCounters();
+
+private:
+	int findFlow(uint32_t adr64MSB, uint32_t adr64LSB);
+	uint8_t* frameData(int index);
+	bool isReady(uint8_t flow, uint8_t priority);
+	bool hasReady(uint8_t priority);
+	int choosePriority();
+	int select(uint8_t priority);
+	void releaseFlow(uint8_t flow);
+
+	SimpleZigBeeScheduledFrame* _slots;
+	uint8_t* _frames;
+	uint8_t _slotCount;
+	SimpleZigBeeFlow* _flows;
+	uint8_t _flowCount;
+	int _maxFrameLength;
+	// Priority of the requests queued by the radio
+	uint8_t _priority;
+	// Requests each weighted class may send in its turn, the class whose turn it is and the requests it has left
+	uint8_t _weight[SIMPLE_ZIGBEE_PRIORITY_CLASSES];
+	uint8_t _turn;
+	uint8_t _credit;
+	// Deficit round-robin: bytes added to a destination's deficit each turn, the destination whose turn it 
+	// is in each class, and whether it has been given its quantum yet
+	int _quantum;
+	uint8_t _next[SIMPLE_ZIGBEE_PRIORITY_CLASSES];
+	bool _started[SIMPLE_ZIGBEE_PRIORITY_CLASSES];
+	// Milliseconds to wait for the status of a destination's last request (0 to never wait)
+	unsigned long _statusTimeout;
+	// Set while service() sends a queued request, so that the radio does not queue it again
+	bool _sending;
+	uint8_t _depth[SIMPLE_ZIGBEE_PRIORITY_CLASSES];
+	uint8_t _highWaterMark;
+	// Number of requests sent and their time in the queue, for each class, and requests that could not be queued
+	unsigned long _sentCount[SIMPLE_ZIGBEE_PRIORITY_CLASSES];
+	unsigned long _latencySum[SIMPLE_ZIGBEE_PRIORITY_CLASSES];
+	unsigned long _maxLatency[SIMPLE_ZIGBEE_PRIORITY_CLASSES];
+	unsigned long _dropCount;
+};
+
+/**
+* Class: SimpleZigBeeSchedulerT
+* @ Since v0.1.2, October 2026
+* @ Scheduler that holds its own storage for Slots requests of up to MaxFrameLength bytes of frame data
+*   each, to up to Flows destinations at once.
+*/
+template<uint8_t Slots, uint8_t Flows = 4, int MaxFrameLength = SIMPLE_ZIGBEE_MAX_FRAME_LENGTH>
+class SimpleZigBeeSchedulerT : public SimpleZigBeeScheduler {
+public:
+	SimpleZigBeeSchedulerT() : SimpleZigBeeScheduler(_slot_storage, _frame_storage, Slots, _flow_storage, Flows, MaxFrameLength) {}
+
+private:
+	static_assert( Slots >= 1 && Slots < SCHEDULER_NONE, "Slots must be between 1 and 254" );
+	static_assert( Flows >= 1 && Flows < SCHEDULER_NONE, "Flows must be between 1 and 254" );
+	static_assert( MaxFrameLength >= 1, "MaxFrameLength must be at least 1" );
+	SimpleZigBeeScheduledFrame _slot_storage[Slots];
+	uint8_t _frame_storage[Slots * MaxFrameLength];
+	SimpleZigBeeFlow _flow_storage[Flows];
+};
+
+#endif //SimpleZigBeeScheduler_h
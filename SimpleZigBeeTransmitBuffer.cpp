@@ -0,0 +1,186 @@
+/**
+* Copyright (c) 2013 Eric Burger. All rights reserved.
+*/
+
+#include "SimpleZigBeeTransmitBuffer.h"
+
+/*//////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////
+										SimpleZigBeeTransmitBuffer Class
+////////////////////////////////////////////////////////////////////////
+/*//////////////////////////////////////////////////////////////////////
+
+/*//////////////////////////////////////////////////////////////////////
+									INITIALIZATION METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Constructor: SimpleZigBeeTransmitBuffer(uint8_t* storage, uint16_t size)
+*  @ Since v0.1.2, October 2026
+*  @ Creates a buffer using the provided storage. Normally called by SimpleZigBeeTransmitBufferT.
+*  @ param uint8_t* storage: Array of size bytes
+*  @ param uint16_t size: Number of bytes that can be stored (power of 2)
+*/
+SimpleZigBeeTransmitBuffer::SimpleZigBeeTransmitBuffer(uint8_t* storage, uint16_t size){
+	_data = storage;
+	_size = size;
+	clear();
+}
+
+/**
+*  Method: clear()
+*  @ Since v0.1.2, October 2026
+*  @ Removes all bytes (they are not sent) and resets the counters.
+*/
+void SimpleZigBeeTransmitBuffer::clear(){
+	_head = 0;
+	_tail = 0;
+	resetCounters();
+}
+
+/*//////////////////////////////////////////////////////////////////////
+									PRODUCER METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: space()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of bytes that can be added.
+*/
+uint16_t SimpleZigBeeTransmitBuffer::space(){
+	return _size - available();
+}
+
+/**
+*  Method: hasSpace(uint16_t length)
+*  @ Since v0.1.2, October 2026
+*  @ Checks if length bytes can be added. If not, the buffer is counted as full (see getFullCount()).
+*  @ param uint16_t length: Number of bytes
+*/
+bool SimpleZigBeeTransmitBuffer::hasSpace(uint16_t length){
+	if( length > space() ){
+		_fullCount++;
+		return false;
+	}
+	return true;
+}
+
+/**
+*  Method: write(const uint8_t* data, uint16_t length)
+*  @ Since v0.1.2, October 2026
+*  @ Adds bytes to the buffer. Returns false (and adds nothing) if there is not enough room.
+*  @ param const uint8_t* data: Pointer to array of bytes
+*  @ param uint16_t length: Number of bytes in array
+*/
+bool SimpleZigBeeTransmitBuffer::write(const uint8_t* data, uint16_t length){
+	if( !hasSpace(length) ){
+		return false;
+	}
+	// Copy up to the end of the storage, then the rest from the start
+	uint16_t index = _head & (_size - 1);
+	uint16_t run = _size - index;
+	if( run > length ){
+		run = length;
+	}
+	memcpy( _data + index, data, run );
+	memcpy( _data, data + run, length - run );
+	_head += length;
+	if( available() > _highWaterMark ){
+		_highWaterMark = available();
+	}
+	return true;
+}
+
+/*//////////////////////////////////////////////////////////////////////
+									CONSUMER METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: isEmpty()
+*  @ Since v0.1.2, October 2026
+*  @ Returns true if there are no bytes waiting.
+*/
+bool SimpleZigBeeTransmitBuffer::isEmpty(){
+	return _head == _tail;
+}
+
+/**
+*  Method: available()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of bytes waiting to be written to the serial port.
+*/
+uint16_t SimpleZigBeeTransmitBuffer::available(){
+	return (uint16_t)(_head - _tail);
+}
+
+/**
+*  Method: drain(Stream & serial)
+*  @ Since v0.1.2, October 2026
+*  @ Writes waiting bytes to the serial port, but only as many as Stream::availableForWrite() allows, so
+*    the call never waits for the port. Returns the number of bytes written.
+*  @ param Stream & serial: Serial port connected to the XBee radio
+*/
+uint16_t SimpleZigBeeTransmitBuffer::drain(Stream & serial){
+	uint16_t written = 0;
+	int room = serial.availableForWrite();
+	while( !isEmpty() && room > 0 ){
+		// Write the bytes that are stored one after the other (up to the end of the storage)
+		uint16_t index = _tail & (_size - 1);
+		uint16_t run = _size - index;
+		if( run > available() ){
+			run = available();
+		}
+		if( room < run ){
+			run = room;
+		}
+		size_t done = serial.write( _data + index, run );
+		if( 0 == done ){
+			break;
+		}
+		_tail += done;
+		written += done;
+		room -= done;
+	}
+	return written;
+}
+
+/*//////////////////////////////////////////////////////////////////////
+									STATISTICS METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: getSize()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of bytes that can be stored.
+*/
+uint16_t SimpleZigBeeTransmitBuffer::getSize(){
+	return _size;
+}
+
+/**
+*  Method: getHighWaterMark()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the largest number of bytes that have been waiting in the buffer at once.
+*/
+uint16_t SimpleZigBeeTransmitBuffer::getHighWaterMark(){
+	return _highWaterMark;
+}
+
+/**
+*  Method: getFullCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of times a packet could not be added because the buffer was full.
+*/
+unsigned long SimpleZigBeeTransmitBuffer::getFullCount(){
+	return _fullCount;
+}
+
+/**
+*  Method: resetCounters()
+*  @ Since v0.1.2, October 2026
+*  @ Resets the high water mark and the full count.
+*/
+void SimpleZigBeeTransmitBuffer::resetCounters(){
+	_highWaterMark = 0;
+	_fullCount = 0;
+}
@@ -0,0 +1,106 @@
+/**
+* Library Name: SimpleZigBeeTransmitBuffer
+* Library URI: https://github.com/ericburger/simple-zigbee
+* Description: Ring of escaped outgoing bytes that are written to the serial port
+* as fast as the port can take them, so sending a packet does not wait for the port.
+* Version: 0.1.2
+* Author(s): Eric Burger
+* Author URI: WallflowerOpen.com
+* License: GNU General Public License v2.0 or later
+* License URI: http://www.gnu.org/licenses/gpl-2.0.html 
+*
+* Copyright (c) 2013 Eric Burger. All rights reserved.
+*
+* This file is part of SimpleZigBee, written for XBee S2 Radios.
+*
+* SimpleZigBee is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* SimpleZigBee is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with SimpleZigBee.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SimpleZigBeeTransmitBuffer_h
+#define SimpleZigBeeTransmitBuffer_h
+
+#include "Arduino.h"
+// Required for uint8_t type
+#include <inttypes.h>
+
+/**
+* Class: SimpleZigBeeTransmitBuffer
+* @ Since v0.1.2, October 2026
+* @ Fixed size ring of bytes waiting to be written to the serial port. When the buffer is set in the radio 
+*   (see SimpleZigBeeRadio::setTransmitBuffer()), send() adds the escaped packet to the buffer and returns
+*   at once. drain() then writes only as many bytes as Stream::availableForWrite() says the serial port 
+*   can take without waiting, so neither send() nor poll() stops the program while the bytes go out.
+*   If the buffer does not have room for a packet, send() returns false and nothing is sent, so the 
+*   program can decide to try again later (see SimpleZigBeeRadio::canWrite()).
+*   The serial port must report availableForWrite(), which HardwareSerial does. SoftwareSerial always 
+*   reports 0 (its writes always wait), so the buffer cannot be used with it.
+*   The storage for the bytes is provided by SimpleZigBeeTransmitBufferT (see below). The size must be 
+*   a power of 2 (2, 4, 8, ... 32768).
+*/
+class SimpleZigBeeTransmitBuffer {
+public:
+	// INITIALIZATION METHODS //
+	SimpleZigBeeTransmitBuffer(uint8_t* storage, uint16_t size);
+	void clear();
+	
+	// PRODUCER METHODS //
+	uint16_t space();
+	bool hasSpace(uint16_t length);
+	bool write(const uint8_t* data, uint16_t length);
+	
+	// CONSUMER METHODS //
+	bool isEmpty();
+	uint16_t available();
+	uint16_t drain(Stream & serial);
+	
+	// STATISTICS METHODS //
+	uint16_t getSize();
+	uint16_t getHighWaterMark();
+	unsigned long getFullCount();
+	void resetCounters();
+
+private:
+	// Storage for size bytes
+	uint8_t* _data;
+	// Number of bytes that can be stored (power of 2)
+	uint16_t _size;
+	// Number of bytes written (only changed by the producer). The index is _head & (_size-1).
+	uint16_t _head;
+	// Number of bytes drained (only changed by the consumer)
+	uint16_t _tail;
+	// Largest number of bytes waiting in the buffer
+	uint16_t _highWaterMark;
+	// Number of times there was not enough room (see hasSpace())
+	unsigned long _fullCount;
+};
+
+/**
+* Class: SimpleZigBeeTransmitBufferT
+* @ Since v0.1.2, October 2026
+* @ Transmit buffer that holds its own storage for Size bytes. To always fit one packet, use at least
+*   twice the largest frame length plus 8 (each byte may be escaped). For example, 
+*   "SimpleZigBeeTransmitBufferT<128> buffer;" fits at least one packet of up to 60 bytes of frame data.
+*/
+template<uint16_t Size = 128>
+class SimpleZigBeeTransmitBufferT : public SimpleZigBeeTransmitBuffer {
+public:
+	SimpleZigBeeTransmitBufferT() : SimpleZigBeeTransmitBuffer(_storage, Size) {}
+	
+private:
+	static_assert( Size >= 2 && Size <= 32768 && (Size & (Size-1)) == 0, "Size must be a power of 2 between 2 and 32768" );
+	uint8_t _storage[Size];
+};
+
+#endif //SimpleZigBeeTransmitBuffer_h
@@ -0,0 +1,208 @@
+/**
+* Copyright (c) 2013 Eric Burger. All rights reserved.
+*/
+
+#include "SimpleZigBeeTransmitWindow.h"
+
+/*//////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////
+										SimpleZigBeeTransmitWindow Class
+////////////////////////////////////////////////////////////////////////
+/*//////////////////////////////////////////////////////////////////////
+
+/*//////////////////////////////////////////////////////////////////////
+									INITIALIZATION METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Constructor: SimpleZigBeeTransmitWindow()
+*  @ Since v0.1.2, October 2026
+*  @ Creates a window of 1 to SIMPLE_ZIGBEE_MAX_TRANSMIT_WINDOW packets.
+*/
+SimpleZigBeeTransmitWindow::SimpleZigBeeTransmitWindow(){
+	setLimits( 1, SIMPLE_ZIGBEE_MAX_TRANSMIT_WINDOW );
+	resetCounters();
+}
+
+/**
+*  Constructor: SimpleZigBeeTransmitWindow(uint8_t maxWindow)
+*  @ Since v0.1.2, October 2026
+*  @ Creates a window of 1 to maxWindow packets.
+*  @ param uint8_t maxWindow: Largest number of TX requests waiting at the same time
+*/
+SimpleZigBeeTransmitWindow::SimpleZigBeeTransmitWindow(uint8_t maxWindow){
+	setLimits( 1, maxWindow );
+	resetCounters();
+}
+
+/**
+*  Method: reset()
+*  @ Since v0.1.2, October 2026
+*  @ Starts again with the minimum window and no TX requests waiting (for example, after the radio is reset).
+*/
+void SimpleZigBeeTransmitWindow::reset(){
+	_window = (uint16_t)_minWindow << 8;
+	_threshold = (uint16_t)_maxWindow << 8;
+	_inFlight = 0;
+	_decreaseTime = millis();
+}
+
+/**
+*  Method: setLimits(uint8_t minWindow, uint8_t maxWindow)
+*  @ Since v0.1.2, October 2026
+*  @ Sets the smallest and largest window and calls reset().
+*  @ param uint8_t minWindow: Smallest window (at least 1)
+*  @ param uint8_t maxWindow: Largest window (for example, the number of slots of the request table)
+*/
+void SimpleZigBeeTransmitWindow::setLimits(uint8_t minWindow, uint8_t maxWindow){
+	if( minWindow < 1 ){
+		minWindow = 1;
+	}
+	if( maxWindow < minWindow ){
+		maxWindow = minWindow;
+	}
+	_minWindow = minWindow;
+	_maxWindow = maxWindow;
+	reset();
+}
+
+/*//////////////////////////////////////////////////////////////////////
+										WINDOW METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: isOpen()
+*  @ Since v0.1.2, October 2026
+*  @ Checks if another TX request can be sent (fewer requests are waiting than the window allows).
+*/
+bool SimpleZigBeeTransmitWindow::isOpen(){
+	return _inFlight < getWindow();
+}
+
+/**
+*  Method: getWindow()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of TX requests that may currently wait at the same time.
+*/
+uint8_t SimpleZigBeeTransmitWindow::getWindow(){
+	return _window >> 8;
+}
+
+/**
+*  Method: getThreshold()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the window at which growth changes from one packet per delivery to one packet per full window.
+*/
+uint8_t SimpleZigBeeTransmitWindow::getThreshold(){
+	return _threshold >> 8;
+}
+
+/**
+*  Method: getInFlight()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of TX requests waiting for their TX status.
+*/
+uint8_t SimpleZigBeeTransmitWindow::getInFlight(){
+	return _inFlight;
+}
+
+/**
+*  Method: requestSent()
+*  @ Since v0.1.2, October 2026
+*  @ Counts a TX request that has been sent. Called by SimpleZigBeeRequestTable::begin().
+*/
+void SimpleZigBeeTransmitWindow::requestSent(){
+	if( _inFlight < 255 ){
+		_inFlight++;
+	}
+}
+
+/**
+*  Method: requestFinished(SimpleZigBeeRequest & request)
+*  @ Since v0.1.2, October 2026
+*  @ Grows or shrinks the window from the TX status (or timeout) of a request. Called by SimpleZigBeeRequestTable
+*    when a TX request is completed or times out.
+*  @ param SimpleZigBeeRequest & request: Completed or timed out TX request
+*/
+void SimpleZigBeeTransmitWindow::requestFinished(SimpleZigBeeRequest & request){
+	if( _inFlight > 0 ){
+		_inFlight--;
+	}
+	if( REQUEST_TIMED_OUT == request.state ){
+		decrease( request, true );
+		return;
+	}
+	switch( request.status ){
+		case TRANSMIT_STATUS_SUCCESS:
+			if( request.retryCount > 0 ){
+				// Delivered, but the channel is busy. Do not grow.
+				break;
+			}
+			{
+				uint32_t window = _window;
+				if( window < _threshold ){
+					window += 256;
+				}else{
+					window += 65536UL / window;
+				}
+				if( window > ((uint32_t)_maxWindow << 8) ){
+					window = (uint32_t)_maxWindow << 8;
+				}
+				_window = window;
+			}
+			break;
+		case TRANSMIT_STATUS_MAC_ACK_FAILURE:
+		case TRANSMIT_STATUS_CCA_FAILURE:
+		case TRANSMIT_STATUS_NETWORK_ACK_FAILURE:
+			decrease( request, false );
+			break;
+		default:
+			// Not caused by congestion (for example, TRANSMIT_STATUS_ADDRESS_NOT_FOUND)
+			break;
+	}
+}
+
+/**
+*  Method: decrease(SimpleZigBeeRequest & request, bool timeout)
+*  @ Since v0.1.2, October 2026
+*  @ Halves the threshold and sets the window to the threshold (or to the minimum after a timeout).
+*    Requests sent before the last decrease were sent into the larger window, so their failures do not
+*    decrease the window again (otherwise one burst of failures would shrink it to the minimum).
+*  @ param SimpleZigBeeRequest & request: Failed or timed out TX request
+*  @ param bool timeout: True if the TX status never arrived
+*/
+void SimpleZigBeeTransmitWindow::decrease(SimpleZigBeeRequest & request, bool timeout){
+	if( (long)(request.sentTime - _decreaseTime) < 0 ){
+		return;
+	}
+	_decreaseTime = millis();
+	uint16_t minimum = (uint16_t)_minWindow << 8;
+	_threshold = (_window >> 1) & 0xff00;
+	if( _threshold < minimum ){
+		_threshold = minimum;
+	}
+	_window = timeout ? minimum : _threshold;
+	_decreaseCount++;
+}
+
+/*//////////////////////////////////////////////////////////////////////
+									STATISTICS METHODS
+/*//////////////////////////////////////////////////////////////////////
+
+/**
+*  Method: getDecreaseCount()
+*  @ Since v0.1.2, October 2026
+*  @ Returns the number of times the window was decreased (congestion or timeout).
+*/
+unsigned long SimpleZigBeeTransmitWindow::getDecreaseCount(){
+	return _decreaseCount;
+}
+
+/**
+*  Method: resetCounters()
+*  @ Since v0.1.2, October 2026
+*  @ Resets the decrease count.
+*/
+void SimpleZigBeeTransmitWindow::resetCounters(){
+	_decreaseCount = 0;
+}
@@ -0,0 +1,101 @@
+/**
+* Library Name: SimpleZigBeeTransmitWindow
+* Library URI: https://github.com/ericburger/simple-zigbee
+* Description: Congestion window that limits the number of TX requests waiting
+* for their TX status.
+* Version: 0.1.2
+* Author(s): Eric Burger
+* Author URI: WallflowerOpen.com
+* License: GNU General Public License v2.0 or later
+* License URI: http://www.gnu.org/licenses/gpl-2.0.html 
+*
+* Copyright (c) 2013 Eric Burger. All rights reserved.
+*
+* This file is part of SimpleZigBee, written for XBee S2 Radios.
+*
+* SimpleZigBee is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 2 of the License, or
+* (at your option) any later version.
+*
+* SimpleZigBee is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with SimpleZigBee.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SimpleZigBeeTransmitWindow_h
+#define SimpleZigBeeTransmitWindow_h
+
+#include "Arduino.h"
+// Requires SimpleZigBeeRequest struct
+#include "SimpleZigBeeRequestTable.h"
+// Required for uint8_t type
+#include <inttypes.h>
+
+// Largest number of TX requests that may wait for their TX status at the same time
+#ifndef SIMPLE_ZIGBEE_MAX_TRANSMIT_WINDOW
+#define SIMPLE_ZIGBEE_MAX_TRANSMIT_WINDOW 8
+#endif
+
+/**
+* Class: SimpleZigBeeTransmitWindow
+* @ Since v0.1.2, October 2026
+* @ Limits the number of TX requests that are sent but still waiting for their TX status (the "window"),
+*   so several packets can be on their way at once without overrunning the buffers of the radio. 
+*   The window grows while packets are delivered and shrinks when the TX status reports congestion:
+*     - Delivered without retries: +1 per packet below the threshold (slow start), then +1 per full window
+*     - Delivered after MAC retries: unchanged
+*     - MAC ACK, CCA or network ACK failure: threshold and window are halved
+*     - No TX status before the timeout: threshold is halved and the window goes back to the minimum
+*     - (Failures of packets sent before the last decrease are only counted once)
+*     - Other failures (for example, address or route not found) do not change the window
+*   The window is used through a SimpleZigBeeRequestTable (see setTransmitWindow()), which gives each
+*   request its own frame ID and reports each TX status and timeout.
+*   Example:
+*     SimpleZigBeeRequestTableT<16> table;
+*     SimpleZigBeeTransmitWindow window;
+*     table.setTransmitWindow( window );
+*     xbee.setRequestTable( table );
+*     ... then, in loop(): xbee.poll(); while( xbee.canSend() ){ prepare and send the next packet }
+*/
+class SimpleZigBeeTransmitWindow {
+public:
+	// INITIALIZATION METHODS //
+	SimpleZigBeeTransmitWindow();
+	SimpleZigBeeTransmitWindow(uint8_t maxWindow);
+	void reset();
+	void setLimits(uint8_t minWindow, uint8_t maxWindow);
+	
+	// WINDOW METHODS //
+	bool isOpen();
+	uint8_t getWindow();
+	uint8_t getThreshold();
+	uint8_t getInFlight();
+	void requestSent();
+	void requestFinished(SimpleZigBeeRequest & request);
+	
+	// STATISTICS METHODS //
+	unsigned long getDecreaseCount();
+	void resetCounters();
+
+private:
+	void decrease(SimpleZigBeeRequest & request, bool timeout);
+
+	// Window and threshold in 1/256 of a packet, so the window can grow by a fraction of a packet
+	uint16_t _window;
+	uint16_t _threshold;
+	uint8_t _minWindow;
+	uint8_t _maxWindow;
+	// Number of TX requests waiting for their TX status
+	uint8_t _inFlight;
+	// Number of times the window was decreased, and millis() of the last decrease
+	unsigned long _decreaseCount;
+	unsigned long _decreaseTime;
+};
+
+#endif //SimpleZigBeeTransmitWindow_h
@@ -185,7 +185,7 @@
           
         }else{
           // Other or unimplemented frame type
-          SimpleZigBeePacket p = xbee.getIncomingPacketObject();
+          SimpleZigBeePacket & p = xbee.getIncomingPacketObject();
           uint8_t frameType = p.getFrameData(0);
           Serial.print( "Other Frame Type: " );
           Serial.println(frameType,HEX);
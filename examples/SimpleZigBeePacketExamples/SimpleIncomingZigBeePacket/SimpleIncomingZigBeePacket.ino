@@ -83,6 +83,16 @@
       Serial.print("Last Byte of Payload: ");
       Serial.println( last, HEX);
       
+      // The payload can also be read in place using a view,
+      // which checks the packet once rather than for every byte
+      SimpleZigBeeView payload = zbp.rxPayloadView();
+      Serial.print("Payload: ");
+      for( int i=0; i<payload.getLength(); i++ ){
+        Serial.print( payload[i], HEX );
+        Serial.print(' ');
+      }
+      Serial.println();
+      
     }else if( frameType == AT_COMMAND_RESPONSE ){
       
       Serial.println( "AT_COMMAND_RESPONSE" );
@@ -97,6 +97,8 @@
     // MAX_FRAME_LENGTH_EXCEEDED = 4
     // FRAME_LENGTH_EXCEEDED = 5
     // CHECKSUM_FAILURE = 6
+    // INVALID_FRAME_TYPE = 7
+    // INVALID_FRAME_LENGTH = 8
     
     // For example, if we try to access data that 
     // is outside the frame,
@@ -0,0 +1,103 @@
+/* 
+  Async Receive
+  
+  This example will show how to receive packets in an 
+  interrupt, so that the serial port buffer (64 bytes) cannot
+  overflow while loop() is busy. A timer interrupt reads the
+  XBee serial port every millisecond and stores each complete
+  packet in a frame queue. poll() then passes the queued 
+  packets to the frame callback in loop(). You will need one 
+  XBee S2 radio (with Coordinator API firmware) and one 
+  Arduino board with a second hardware serial port (Serial1), 
+  such as the Leonardo or Mega. 
+  
+  ###########################################################
+  created 16 October 2026
+  
+  This example code is in the public domain.
+  The SimpleZigBee library is released under the GNU GPL v2 License
+  ###########################################################
+   
+  Setup:
+  1. Use the XCTU Software to load the Coordinator API firmware 
+  onto an XBee S2 radio.
+   
+  2. Connect DOUT to RX1 and DIN to TX1. Also, connect the 
+  XBee to 3.3V and ground (GND).
+   
+  3. Upload this sketch and open the Arduino IDE's Serial Monitor.
+  
+  4. Power the XBee off and on (disconnect and reconnect to 3.3v)
+  to see the Hardware Reset notice.
+  
+  Note: SoftwareSerial should not be used with this example, 
+  since it receives bytes in its own interrupt, which cannot 
+  run while the timer interrupt is parsing.
+  
+*/
+
+  #include <SimpleZigBeeRadio.h>
+
+  // Create the XBee object ...
+  SimpleZigBeeRadio xbee = SimpleZigBeeRadio();
+  // ... and the queue for up to 8 received packets.
+  SimpleZigBeeFrameQueueT<8> queue;
+  
+  // Function for handling each packet (see below)
+  void handlePacket(SimpleIncomingZigBeePacket & p);
+
+  void setup() {
+    // Start the serial ports ...
+    Serial.begin( 9600 );
+    while( !Serial ){;// Wait for serial port (for Leonardo only). 
+    }
+    Serial1.begin( 9600 );
+    // ... and set the serial port for the XBee radio.
+    xbee.setSerial( Serial1 );
+    // Set a non-zero frame id to receive Status and Response packets.
+    xbee.setAcknowledgement(true);
+    
+    // Receive packets in the interrupt and handle them in poll().
+    xbee.setFrameCallback( handlePacket );
+    xbee.setAsyncReceive( queue );
+    
+    // Timer0 already counts millis(). Use its compare interrupt
+    // (at the middle of each count) to read the XBee serial port.
+    OCR0A = 0x80;
+    TIMSK0 |= _BV(OCIE0A);
+    
+    // Ask for the PAN ID
+    xbee.prepareATCommand('ID');
+    xbee.send();
+  }
+  
+  // Called about once per millisecond
+  SIGNAL(TIMER0_COMPA_vect){
+    xbee.readAvailable();
+  }
+  
+  void loop() {
+    // Handle every packet waiting in the queue.
+    xbee.poll();
+    if( queue.getDropCount() > 0 ){
+      Serial.println("Queue was full, packets lost");
+      queue.resetCounters();
+    }
+    
+    delay(100); // Even a long delay does not lose packets
+  }
+  
+  
+  /////////////////////////////////////////////////////////////
+  // Function for handling each packet                       //
+  /////////////////////////////////////////////////////////////
+  void handlePacket(SimpleIncomingZigBeePacket & p){
+    Serial.print("Frame Type: ");
+    Serial.print( p.getFrameType(), HEX );
+    Serial.print(", Frame Data: ");
+    for(int i=0; i<p.getFrameLength(); i++){
+      Serial.print( p.getFrameData(i), HEX );
+      Serial.print(' ');
+    }
+    Serial.println();
+  }
@@ -0,0 +1,113 @@
+/* 
+  Frame Dispatcher
+  
+  This example will show how to handle incoming packets
+  with a SimpleZigBeeDispatcher. Rather than checking each
+  packet with isRX(), isTXStatus(), isModemStatus(), etc.,
+  a function is set for each frame type and poll() calls
+  the right function for every packet that has been 
+  received. You will need one XBee S2 radio (with 
+  Coordinator API firmware) and one Arduino board.
+  
+  ###########################################################
+  created 16 October 2026
+  
+  This example code is in the public domain.
+  The SimpleZigBee library is released under the GNU GPL v2 License
+  ###########################################################
+   
+  Setup (same as Getting Started, Part 1: Coordinator):
+  1. Use the XCTU Software to load the Coordinator API firmware 
+  onto an XBee S2 radio.
+   
+  2. Connect DOUT to Pin 10 (RX) and DIN to Pin 11 (TX). Also,
+  connect the XBee to 3.3V and ground (GND).
+   
+  3. Upload this sketch (to the Arduino attached to the 
+  Coordinator) and open the Arduino IDE's Serial Monitor.
+  
+  4. Power the XBee off and on (disconnect and reconnect to 3.3v)
+  to see the Hardware Reset notice.
+  
+*/
+
+  #include <SimpleZigBeeRadio.h>
+  #include <SoftwareSerial.h>
+
+  // Create the XBee object ...
+  SimpleZigBeeRadio xbee = SimpleZigBeeRadio();
+  // ... the dispatcher ...
+  SimpleZigBeeDispatcher dispatcher;
+  // ... and the software serial port. Note: Only one
+  // SoftwareSerial object can receive data at a time.
+  SoftwareSerial xbeeSerial(10, 11); // (RX=>DOUT, TX=>DIN)
+
+  // Functions for handling each frame type (see below)
+  void handleModemStatus(SimpleIncomingZigBeePacket & p);
+  void handleATResponse(SimpleIncomingZigBeePacket & p);
+  void handleRX(SimpleIncomingZigBeePacket & p);
+  void handleOther(SimpleIncomingZigBeePacket & p);
+
+  void setup() {
+    // Start the serial ports ...
+    Serial.begin( 9600 );
+    while( !Serial ){;// Wait for serial port (for Leonardo only). 
+    }
+    xbeeSerial.begin( 9600 );
+    // ... and set the serial port for the XBee radio.
+    xbee.setSerial( xbeeSerial );
+    // Set a non-zero frame id to receive Status and Response packets.
+    xbee.setAcknowledgement(true);
+    
+    // Set a function for each frame type ...
+    dispatcher.setHandler( MODEM_STATUS, handleModemStatus );
+    dispatcher.setHandler( AT_COMMAND_RESPONSE, handleATResponse );
+    dispatcher.setHandler( ZIGBEE_RECIEVED_PACKET, handleRX );
+    // ... and a function for all other frame types.
+    dispatcher.setDefaultHandler( handleOther );
+    xbee.setDispatcher( dispatcher );
+    
+    // Ask for the PAN ID
+    xbee.prepareATCommand('ID');
+    xbee.send();
+  }
+  
+  void loop() {
+    // Handle every packet waiting in the XBee serial port.
+    xbee.poll();
+    
+    delay(10); // Small delay for stability
+  }
+  
+  
+  /////////////////////////////////////////////////////////////
+  // Functions for handling each frame type                  //
+  /////////////////////////////////////////////////////////////
+  void handleModemStatus(SimpleIncomingZigBeePacket & p){
+    Serial.print("Modem Status: ");
+    Serial.println( p.getModemStatus(), HEX );
+  }
+  
+  void handleATResponse(SimpleIncomingZigBeePacket & p){
+    Serial.print("AT Command Response, Status: ");
+    Serial.println( p.getATResponseStatus(), HEX );
+    for(int i=0; i<p.getATResponsePayloadLength(); i++){
+      Serial.print( p.getATResponsePayload(i), HEX );
+      Serial.print(' ');
+    }
+    Serial.println();
+  }
+  
+  void handleRX(SimpleIncomingZigBeePacket & p){
+    Serial.print("RX Packet: ");
+    for(int i=0; i<p.getRXPayloadLength(); i++){
+      Serial.print( p.getRXPayload(i), HEX );
+      Serial.print(' ');
+    }
+    Serial.println();
+  }
+  
+  void handleOther(SimpleIncomingZigBeePacket & p){
+    Serial.print("Other Frame Type: ");
+    Serial.println( p.getFrameType(), HEX );
+  }
@@ -0,0 +1,156 @@
+/* 
+   Parser Benchmark
+  
+   This sketch compares three ways of parsing the bytes 
+   received from an XBee radio in Escaped API Mode (ATAP=2):
+   the original read() loop, which calls available() and 
+   read() on the Stream for every byte, handing the bytes 
+   to the SimpleZigBeeRadio one at a time with feed(), and
+   handing over a whole block with feed(). The read() loop
+   is given the bytes by a Stream that reads from memory.
+   When feed() is given a block, runs of bytes 
+   that do not need to be un-escaped are stored in one step.
+   On a computer with SSE2/AVX2, the search for escaped bytes
+   checks 16 or 32 bytes at a time.
+   
+   The SimpleZigBeeRadio does not read from the XBee radio 
+   in this example and thus it is not necessary to connect
+   a radio to run this example code.
+  
+   created 16 October 2026
+   
+   This example code is in the public domain.
+   The SimpleZigBee library is released under the GNU GPL v2 License
+  
+ */
+
+  #include <SimpleZigBeeRadio.h>
+
+  // Stream that returns the bytes of an array, in place of
+  // the serial port connected to the XBee radio
+  class ArrayStream : public Stream {
+    public:
+      void begin( const uint8_t* data, int length ){ _data = data; _length = length; _index = 0; }
+      int available(){ return _length - _index; }
+      int read(){ return ( _index < _length ) ? _data[_index++] : -1; }
+      int peek(){ return ( _index < _length ) ? _data[_index] : -1; }
+      void flush(){}
+      size_t write( uint8_t ){ return 0; }
+    private:
+      const uint8_t* _data;
+      int _length;
+      int _index;
+  };
+
+  // Create the XBee object
+  SimpleZigBeeRadio xbee = SimpleZigBeeRadio();
+  ArrayStream arrayStream;
+  
+  // Buffer holding several escaped RX packets, as they
+  // would be received from the serial port
+  uint8_t stream[250];
+  int streamLength = 0;
+  
+  // Number of times to parse the buffer
+  const int repeat = 100;
+  
+  void setup() {
+    Serial.begin( 9600 );
+    while( !Serial ){;}// Wait to connect. Needed for Leonardo only
+    
+    // Fill the buffer with RX packets carrying a 32 byte 
+    // sensor payload. Only 1 in 50 payload bytes needs 
+    // to be escaped.
+    randomSeed( 42 );
+    while( streamLength + 2*48 < (int)sizeof(stream) ){
+      addRXPacket();
+    }
+    
+    // Parse the buffer with the original read() loop, ...
+    xbee.setSerial( arrayStream );
+    unsigned long readFrames = 0;
+    unsigned long start = micros();
+    for( int r=0; r<repeat; r++ ){
+      arrayStream.begin( stream, streamLength );
+      while( arrayStream.available() ){
+        xbee.read();
+        if( xbee.isComplete() ){
+          readFrames++;
+        }
+      }
+    }
+    unsigned long readTime = micros() - start;
+    
+    // ... one byte at a time with feed() ...
+    unsigned long frames = 0;
+    start = micros();
+    for( int r=0; r<repeat; r++ ){
+      for( int i=0; i<streamLength; i++ ){
+        frames += xbee.feed( &stream[i], 1 );
+      }
+    }
+    unsigned long byteTime = micros() - start;
+    
+    // ... and then as a block with feed().
+    start = micros();
+    for( int r=0; r<repeat; r++ ){
+      frames += xbee.feed( stream, streamLength );
+    }
+    unsigned long blockTime = micros() - start;
+    
+    Serial.print( "Bytes parsed per test: " );
+    Serial.println( (unsigned long)streamLength * repeat );
+    Serial.print( "Packets received: " );
+    Serial.println( frames );
+    Serial.print( "Packets received by read(): " );
+    Serial.println( readFrames );
+    Serial.print( "read() loop (us): " );
+    Serial.println( readTime );
+    Serial.print( "One byte at a time (us): " );
+    Serial.println( byteTime );
+    Serial.print( "Whole block (us): " );
+    Serial.println( blockTime );
+  }
+  
+  void loop() {
+    // Nothing to do
+  }
+  
+  
+  /////////////////////////////////////////////////////////////
+  // Function for adding an escaped RX packet to the buffer  //
+  /////////////////////////////////////////////////////////////
+  void addRXPacket(){
+    uint8_t frame[44];
+    uint8_t header[] = { 0x90,0x00,0x13,0xa2,0x00,0x40,0xa0,0xb0,0xc0,0x12,0x34,0x01 };
+    memcpy( frame, header, sizeof(header) );
+    for( int i=sizeof(header); i<(int)sizeof(frame); i++ ){
+      if( random(50) == 0 ){
+        frame[i] = START;
+      }else{
+        // Any byte value other than the ones that must be escaped
+        do{
+          frame[i] = random(256);
+        }while( frame[i] == START || frame[i] == ESCAPE || frame[i] == XON || frame[i] == XOFF );
+      }
+    }
+    
+    uint8_t checksum = 0;
+    stream[streamLength++] = START;
+    addEscapedByte( 0 );
+    addEscapedByte( sizeof(frame) );
+    for( int i=0; i<(int)sizeof(frame); i++ ){
+      addEscapedByte( frame[i] );
+      checksum += frame[i];
+    }
+    addEscapedByte( 0xff - checksum );
+  }
+  
+  void addEscapedByte( uint8_t b ){
+    if( b == START || b == ESCAPE || b == XON || b == XOFF ){
+      stream[streamLength++] = ESCAPE;
+      stream[streamLength++] = b ^ 0x20;
+    }else{
+      stream[streamLength++] = b;
+    }
+  }
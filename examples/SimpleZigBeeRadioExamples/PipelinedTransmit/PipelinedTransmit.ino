@@ -0,0 +1,103 @@
+/* 
+  Pipelined Transmit
+  
+  This example will show how to send packets to the 
+  coordinator without waiting for the TX Status of each
+  packet before sending the next one. A request table gives
+  each packet its own frame ID and matches it with its TX 
+  Status. A transmit window limits how many packets can wait
+  for their TX Status at the same time. The window grows while
+  packets are delivered and shrinks when the TX Status reports
+  that the channel is busy. A retransmitter keeps a copy of
+  the last few packets and sends them again if the TX Status
+  reports a failure. You will need two XBee S2 radios
+  and two Arduino boards (see Getting Started, Part 1).
+  
+  ###########################################################
+  created 16 October 2026
+  
+  This example code is in the public domain.
+  The SimpleZigBee library is released under the GNU GPL v2 License
+  ###########################################################
+   
+  Setup (same as Getting Started, Part 1: Router):
+  1. Complete "Getting Started, Part 1: Coordinator".
+   
+  2. Connect DOUT to Pin 10 (RX) and DIN to Pin 11 (TX). Also,
+  connect the XBee to 3.3V and ground (GND).
+   
+  3. Upload this sketch (to the Arduino attached to the 
+  Router) and open the Arduino IDE's Serial Monitor.
+  
+*/
+
+  #include <SimpleZigBeeRadio.h>
+  #include <SoftwareSerial.h>
+
+  // Create the XBee object ...
+  SimpleZigBeeRadio xbee = SimpleZigBeeRadio();
+  // ... the request table (8 frame IDs) and the window ...
+  SimpleZigBeeRequestTableT<8> requests;
+  SimpleZigBeeTransmitWindow window(8);
+  // ... the retransmitter (copies of 4 packets) ...
+  SimpleZigBeeRetransmitterT<4> retransmitter;
+  // ... and the software serial port. Note: Only one
+  // SoftwareSerial object can receive data at a time.
+  SoftwareSerial xbeeSerial(10, 11); // (RX=>DOUT, TX=>DIN)
+
+  // Value to be sent
+  uint8_t val = 0;
+  // Variable to store time
+  unsigned long last_report = 0;
+
+  void setup() {
+    // Start the serial ports ...
+    Serial.begin( 9600 );
+    while( !Serial ){;// Wait for serial port (for Leonardo only). 
+    }
+    xbeeSerial.begin( 9600 );
+    // ... and set the serial port for the XBee radio.
+    xbee.setSerial( xbeeSerial );
+    // Receive TX Status packets
+    xbee.setAcknowledgement(true);
+    
+    // Limit the packets waiting for a TX Status ...
+    requests.setTransmitWindow( window );
+    // ... and record each packet that is sent.
+    xbee.setRequestTable( requests );
+    // Send failed packets again (at most 2 per second)
+    retransmitter.setBudget( 2, 2 );
+    xbee.setRetransmitter( retransmitter );
+  }
+  
+  void loop() {
+    // Read the TX Status packets (which open the window)
+    // and send the failed packets again
+    xbee.poll();
+    
+    // Send as many packets as the window allows. In a batch,
+    // the serial port is only flushed once, at the end.
+    xbee.beginBatch();
+    while( xbee.canSend() ){
+      uint8_t payload[] = {'D', val};
+      xbee.prepareTXRequestToCoordinator( payload, sizeof(payload) );
+      xbee.send();
+      val++;
+    }
+    xbee.endBatch();
+    
+    // Once per second, show how the packets are doing
+    if( millis() - last_report > 1000 ){
+      last_report = millis();
+      Serial.print( "Window: " );
+      Serial.print( window.getWindow() );
+      Serial.print( " Delivered: " );
+      Serial.print( requests.getCompleteCount() );
+      Serial.print( " Timed Out: " );
+      Serial.print( requests.getTimeoutCount() );
+      Serial.print( " Retries: " );
+      Serial.print( retransmitter.getRetryCount() );
+      Serial.print( " Average Latency (ms): " );
+      Serial.println( requests.getAverageLatency() );
+    }
+  }